@@ -8,10 +8,22 @@
  */
 
 #include "VologramActor.h"
+#include "volograms.h"
+#include "VologramFileIO.h"
+#include "VologramAsset.h"
+#include "VologramSubsystem.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "TextureResource.h"
 #include "Engine/Texture2D.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/BoxComponent.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
 #ifdef _MSC_VER
 #define _CRT_SECURE_NO_WARNINGS
 #endif
@@ -19,15 +31,185 @@
 #include <stdio.h>
 #include <string.h>
 
+DECLARE_CYCLE_STAT( TEXT( "Geometry Read" ), STAT_VologramGeometryRead, STATGROUP_Volograms );
+DECLARE_CYCLE_STAT( TEXT( "Frame Interpolation" ), STAT_VologramInterpolation, STATGROUP_Volograms );
+
+/** UnityEngine.TextureFormat values, as stored in .vols headers, and the pixel format with the same memory layout, so texture data uploads as-is.
+ * srgb is true for colour formats, and false for single and two-channel formats, which hold data rather than colours, and for HDR formats.
+ * Formats that would need converting on the CPU, such as RGB24, ARGB32, and the crunched formats, are left out.
+ */
+static const struct {
+  uint16_t unity_format;
+  EPixelFormat pixel_format;
+  bool srgb;
+} _unity_pixel_formats[] = {
+  { 1, PF_G8, false },             // Alpha8
+  { 4, PF_R8G8B8A8, true },        // RGBA32
+  { 10, PF_DXT1, true },           // DXT1
+  { 12, PF_DXT5, true },           // DXT5
+  { 14, PF_B8G8R8A8, true },       // BGRA32
+  { 17, PF_FloatRGBA, false },     // RGBAHalf
+  { 20, PF_A32B32G32R32F, false }, // RGBAFloat
+  { 24, PF_BC6H, false },          // BC6H
+  { 25, PF_BC7, true },            // BC7
+  { 26, PF_BC4, false },           // BC4
+  { 27, PF_BC5, false },           // BC5
+  { 34, PF_ETC2_RGB, true },       // ETC_RGB4. ETC1 data is valid ETC2 RGB data.
+  { 45, PF_ETC2_RGB, true },       // ETC2_RGB
+  { 47, PF_ETC2_RGBA, true },      // ETC2_RGBA8
+  { 48, PF_ASTC_4x4, true },       // ASTC_4x4
+  { 50, PF_ASTC_6x6, true },       // ASTC_6x6
+  { 51, PF_ASTC_8x8, true },       // ASTC_8x8
+  { 52, PF_ASTC_10x10, true },     // ASTC_10x10
+  { 53, PF_ASTC_12x12, true },     // ASTC_12x12
+  { 54, PF_ASTC_4x4, true },       // ASTC_RGBA_4x4, from older versions of Unity
+  { 56, PF_ASTC_6x6, true },       // ASTC_RGBA_6x6
+  { 57, PF_ASTC_8x8, true },       // ASTC_RGBA_8x8
+  { 58, PF_ASTC_10x10, true },     // ASTC_RGBA_10x10
+  { 59, PF_ASTC_12x12, true },     // ASTC_RGBA_12x12
+  { 62, PF_R8G8, false },          // RG16
+  { 63, PF_G8, false },            // R8
+};
+
+/** @return The pixel format matching a UnityEngine.TextureFormat value, or PF_Unknown if there isn't one. */
+static EPixelFormat _pixel_format_from_unity( uint16_t unity_format ) {
+  for ( const auto& entry : _unity_pixel_formats ) {
+    if ( entry.unity_format == unity_format ) { return entry.pixel_format; }
+  }
+  return PF_Unknown;
+}
+
+/** @return True if texture data in a pixel format from _pixel_format_from_unity() is sRGB-encoded colour, so should be sampled as sRGB. */
+static bool _is_srgb_pixel_format( EPixelFormat pixel_format ) {
+  for ( const auto& entry : _unity_pixel_formats ) {
+    if ( entry.pixel_format == pixel_format ) { return entry.srgb; }
+  }
+  return false;
+}
+
+static FTexturePlatformData* _platform_data( UTexture2D* texture_ptr ) {
+#if ENGINE_MAJOR_VERSION == 4
+  return texture_ptr->PlatformData;
+#else
+  return texture_ptr->GetPlatformData();
+#endif
+}
+
+/** @returns                - The number of mips in a full chain for a w by h texture, down to 1x1. */
+static int _mip_count( int w, int h ) { return (int)FMath::FloorLog2( (uint32)FMath::Max( w, h ) ) + 1; }
+
+/** Makes texture_ptr a transient texture of the given size, format, and number of mips, unless it already is one.
+ * @param srgb             - False for data that isn't colour, such as YUV planes.
+ * @returns                - False if the texture couldn't be created.
+ */
+static bool _ensure_texture( UTexture2D*& texture_ptr, int w, int h, EPixelFormat pixel_format, bool srgb, int n_mips = 1 ) {
+  if ( texture_ptr && texture_ptr->GetPixelFormat() == pixel_format && texture_ptr->GetSizeX() == w && texture_ptr->GetSizeY() == h &&
+       texture_ptr->GetNumMips() == n_mips ) {
+    return true;
+  }
+  texture_ptr = UTexture2D::CreateTransient( w, h, pixel_format );
+  if ( !texture_ptr ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR texture_ptr" ) );
+    return false;
+  }
+  texture_ptr->SRGB = srgb;
+
+  // CreateTransient() makes only the first mip. Add the rest of the chain, with room for their pixels.
+  FTexturePlatformData* platform_data_ptr = _platform_data( texture_ptr );
+  const FPixelFormatInfo& format_info     = GPixelFormats[pixel_format];
+  for ( int mip = 1; mip < n_mips; mip++ ) {
+    FTexture2DMipMap* mip_ptr = new FTexture2DMipMap();
+    mip_ptr->SizeX            = FMath::Max( w >> mip, 1 );
+    mip_ptr->SizeY            = FMath::Max( h >> mip, 1 );
+    int64 sz = (int64)FMath::DivideAndRoundUp( mip_ptr->SizeX, format_info.BlockSizeX ) * FMath::DivideAndRoundUp( mip_ptr->SizeY, format_info.BlockSizeY ) *
+               format_info.BlockBytes;
+    mip_ptr->BulkData.Lock( LOCK_READ_WRITE );
+    mip_ptr->BulkData.Realloc( sz );
+    mip_ptr->BulkData.Unlock();
+    platform_data_ptr->Mips.Add( mip_ptr );
+  }
+  return true;
+}
+
+/** Copies pixels into the first mip of a transient texture and updates its resource. */
+static void _copy_to_texture( UTexture2D* texture_ptr, const void* pixels_ptr, size_t sz ) {
+  FTexturePlatformData* platform_data_ptr = _platform_data( texture_ptr );
+  void* textures_data_ptr                 = platform_data_ptr->Mips[0].BulkData.Lock( LOCK_READ_WRITE );
+  FMemory::Memcpy( textures_data_ptr, pixels_ptr, sz );
+  platform_data_ptr->Mips[0].BulkData.Unlock();
+  texture_ptr->UpdateResource();
+}
+
+/** Interleaves the U and V planes of I420 video into one 2-channel image, as NV12 stores them. */
+static void _interleave_chroma( const uint8_t* u_ptr, int u_stride, const uint8_t* v_ptr, int v_stride, int w, int h, TArray<uint8>& dst ) {
+  dst.SetNumUninitialized( w * h * 2 );
+  for ( int y = 0; y < h; y++ ) {
+    uint8_t* dst_row_ptr     = &dst[y * w * 2];
+    const uint8_t* u_row_ptr = &u_ptr[(size_t)y * u_stride];
+    const uint8_t* v_row_ptr = &v_ptr[(size_t)y * v_stride];
+    for ( int x = 0; x < w; x++ ) {
+      dst_row_ptr[x * 2 + 0] = u_row_ptr[x];
+      dst_row_ptr[x * 2 + 1] = v_row_ptr[x];
+    }
+  }
+}
+
+/** Fills every mip of a transient texture made by _ensure_texture(), and updates its resource. Each mip is halved from the one before by
+ * vol_av_downsample_2x2(). The texture's first mip is first_mip levels below the w by h image at src_ptr, and the levels in between are halved
+ * into scratch.
+ * @param n_channels       - Bytes per pixel: 1, 2, or 4.
+ */
+static void _fill_texture_mips(
+  UTexture2D* texture_ptr, const uint8_t* src_ptr, int src_stride, int w, int h, int n_channels, int first_mip, TArray<uint8>& scratch ) {
+  if ( first_mip > 0 ) {
+    // Each level is halved into the half of scratch that its source isn't in. Every level after the first is smaller, so fits in the second half.
+    int first_sz = FMath::Max( w / 2, 1 ) * FMath::Max( h / 2, 1 ) * n_channels;
+    scratch.SetNumUninitialized( first_sz * 2 );
+    for ( int level = 1; level <= first_mip; level++ ) {
+      uint8_t* dst_ptr = &scratch[( level % 2 ) ? 0 : first_sz];
+      int dst_w = FMath::Max( w / 2, 1 ), dst_h = FMath::Max( h / 2, 1 );
+      vol_av_downsample_2x2( src_ptr, src_stride, w, h, n_channels, dst_ptr, dst_w * n_channels );
+      src_ptr    = dst_ptr;
+      src_stride = dst_w * n_channels;
+      w          = dst_w;
+      h          = dst_h;
+    }
+  }
+
+  // Mips stay locked until all are filled, as each is the source of the next.
+  FTexturePlatformData* platform_data_ptr = _platform_data( texture_ptr );
+  for ( int mip = 0; mip < platform_data_ptr->Mips.Num(); mip++ ) {
+    FTexture2DMipMap& mip_map = platform_data_ptr->Mips[mip];
+    uint8_t* dst_ptr          = (uint8_t*)mip_map.BulkData.Lock( LOCK_READ_WRITE );
+    int row_sz                = mip_map.SizeX * n_channels;
+    if ( 0 == mip ) { // Drop the padding at the end of each row.
+      for ( int y = 0; y < mip_map.SizeY; y++ ) { FMemory::Memcpy( &dst_ptr[(size_t)y * row_sz], &src_ptr[(size_t)y * src_stride], row_sz ); }
+    } else {
+      vol_av_downsample_2x2( src_ptr, src_stride, w, h, n_channels, dst_ptr, row_sz );
+    }
+    src_ptr    = dst_ptr;
+    src_stride = row_sz;
+    w          = mip_map.SizeX;
+    h          = mip_map.SizeY;
+  }
+  for ( int mip = 0; mip < platform_data_ptr->Mips.Num(); mip++ ) { platform_data_ptr->Mips[mip].BulkData.Unlock(); }
+  texture_ptr->UpdateResource();
+}
+
 // Sets default values
 AVologramActor::AVologramActor() {
   // Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
   PrimaryActorTick.bCanEverTick = true;
 
   // NOTE(Anton) manually added to set up proc mesh
-  proc_mesh_ptr = CreateDefaultSubobject<UProceduralMeshComponent>( "CustomMesh" );
+  proc_mesh_ptr = CreateDefaultSubobject<UVologramMeshComponent>( "CustomMesh" );
   SetRootComponent( proc_mesh_ptr );
   proc_mesh_ptr->bUseAsyncCooking = true;
+
+  placeholder_ptr = CreateDefaultSubobject<UBoxComponent>( "LoadingPlaceholder" );
+  placeholder_ptr->SetupAttachment( proc_mesh_ptr );
+  placeholder_ptr->SetCollisionEnabled( ECollisionEnabled::NoCollision );
+  placeholder_ptr->SetHiddenInGame( true );
 }
 
 void AVologramActor::ClearMeshData() {
@@ -44,94 +226,407 @@ void AVologramActor::ClearIntermediateMeshData() {
   tangents.Empty();
 }
 
+void AVologramActor::set_vertices_and_normals( const float* points_ptr, const float* normals_ptr, int n_vertices ) {
+  vertices.Reserve( n_vertices );
+  for ( int i = 0; i < n_vertices; i++ ) {
+    float x = points_ptr[i * 3 + 0];
+    float y = points_ptr[i * 3 + 1];
+    float z = points_ptr[i * 3 + 2];
+    // Note ordering change for U4. .vols uses Unity  {+x right,       +y up,    +z into screen} axes.
+    //                                         Unreal {+x into screen, +y right, +z up}.
+    //                                 Typical OpenGL {+x right,       +y up,    +z out of screen}.
+    vertices.Add( FVector( z, x, y ) );
+  }
+  normals.Reserve( n_vertices );
+  vertex_colours.Reserve( n_vertices );
+  if ( normals_ptr ) {
+    for ( int i = 0; i < n_vertices; i++ ) {
+      float x = normals_ptr[i * 3 + 0];
+      float y = normals_ptr[i * 3 + 1];
+      float z = normals_ptr[i * 3 + 2];
+      // NOTE(Anton) 14 Jan 2022 updated component order here to match vertex order as per latest vologram reconstructions.
+      normals.Add( FVector( z, x, y ) );
+      vertex_colours.Add( FLinearColor( z, x, y ) );
+    }
+  }
+}
+
+bool AVologramActor::ensure_normals_topology( int n_vertices ) {
+  if ( this->previous_keyframe_loaded < 0 ) { return false; }
+  if ( this->normals_topology_ptr && this->normals_topology_keyframe == this->previous_keyframe_loaded ) { return true; }
+  free_normals_topology();
+  // triangles has the second and third corners swapped from the .vols order.
+  this->normals_topology_ptr = vol_geom_create_normals_topology( (const uint32_t*)triangles.GetData(), triangles.Num(), n_vertices, true );
+  if ( !this->normals_topology_ptr ) { return false; }
+  this->normals_topology_keyframe = this->previous_keyframe_loaded;
+
+  // Tangents follow the UVs in the mesh section, which have V flipped for the video.
+  if ( uvs.Num() == n_vertices ) {
+    TArray<float> uv_floats;
+    uv_floats.SetNumUninitialized( n_vertices * 2 );
+    for ( int i = 0; i < n_vertices; i++ ) {
+      uv_floats[i * 2 + 0] = uvs[i].X;
+      uv_floats[i * 2 + 1] = uvs[i].Y;
+    }
+    this->tangent_handedness.SetNumUninitialized( n_vertices );
+    if ( !vol_geom_set_normals_topology_uvs( this->normals_topology_ptr, uv_floats.GetData(), n_vertices, this->tangent_handedness.GetData() ) ) {
+      this->tangent_handedness.Reset();
+    }
+  }
+  return true;
+}
+
+const float* AVologramActor::generate_vertex_normals( const float* points_ptr, int n_vertices, TArray<float>& normals_out ) {
+  if ( !this->generate_normals || !ensure_normals_topology( n_vertices ) ) { return NULL; }
+  normals_out.SetNumUninitialized( n_vertices * 3 );
+  if ( !vol_geom_compute_normals( this->normals_topology_ptr, points_ptr, n_vertices, normals_out.GetData() ) ) { return NULL; }
+  return normals_out.GetData();
+}
+
+void AVologramActor::set_tangents( const float* points_ptr, const float* normals_ptr, int n_vertices ) {
+  tangents.Reset();
+  if ( this->generate_tangents && normals_ptr && ensure_normals_topology( n_vertices ) && this->tangent_handedness.Num() == n_vertices ) {
+    generated_tangents.SetNumUninitialized( n_vertices * 3 );
+    if ( vol_geom_compute_tangents( this->normals_topology_ptr, points_ptr, normals_ptr, n_vertices, generated_tangents.GetData() ) ) {
+      tangents.Reserve( n_vertices );
+      for ( int i = 0; i < n_vertices; i++ ) {
+        // Same axis swap as set_vertices_and_normals(). It only reorders axes, so the handedness is unchanged.
+        const float* t_ptr = &generated_tangents[i * 3];
+        tangents.Add( FProcMeshTangent( FVector( t_ptr[2], t_ptr[0], t_ptr[1] ), this->tangent_handedness[i] < 0 ) );
+      }
+      return;
+    }
+  }
+  tangents.Init( FProcMeshTangent( 1.0f, 0.0f, 0.0f ), 3 );
+}
+
+void AVologramActor::free_normals_topology() {
+  vol_geom_free_normals_topology( this->normals_topology_ptr );
+  this->normals_topology_ptr      = NULL;
+  this->normals_topology_keyframe = -1;
+  this->tangent_handedness.Reset();
+}
+
+/** Converts bounds in .vols axes, as minimum x, y, z then maximum x, y, z, to a box in the mesh's axes. */
+static FBox _vols_aabb_to_box( const float* aabb_ptr ) {
+  // Same axis swap as set_vertices_and_normals(). It only reorders axes, so minimums stay minimums.
+  return FBox( FVector( aabb_ptr[2], aabb_ptr[0], aabb_ptr[1] ), FVector( aabb_ptr[5], aabb_ptr[3], aabb_ptr[4] ) );
+}
+
+void AVologramActor::set_mesh_bounds( int frame_idx, int other_frame_idx ) {
+  const float* aabbs_ptr = this->vol_geom_info.frame_aabbs_ptr;
+  int frame_count        = this->vol_geom_info.hdr.frame_count;
+  if ( !aabbs_ptr || frame_idx < 0 || frame_idx >= frame_count ) { return; }
+  FBox box = _vols_aabb_to_box( &aabbs_ptr[frame_idx * 6] );
+  // Blended vertices lie between their positions in the two frames, so within the union of the frames' bounds.
+  if ( other_frame_idx >= 0 && other_frame_idx < frame_count ) { box += _vols_aabb_to_box( &aabbs_ptr[other_frame_idx * 6] ); }
+  proc_mesh_ptr->set_local_bounds( box );
+}
+
 bool AVologramActor::load_vologram_meta() {
+  close_vologram();
+  if ( !open_vologram_bundle() || !open_vologram_geometry() ) { return false; }
+  if ( PF_Unknown == this->embedded_pixel_format && !open_vologram_video() ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *this->vol_mp4_path.FilePath );
+    return false;
+  }
+  finish_vologram_meta();
+  return true;
+}
+
+void AVologramActor::close_vologram() {
+  stop_video_preroll();
+  // The previous video and geometry may be reading from the previous bundle, so close them before it.
+  vol_av_close( &this->vol_video_info );
+  vol_geom_free_file_info( &this->vol_geom_info );
+  vol_geom_bundle_close( this->vol_bundle_ptr );
+  this->vol_bundle_ptr = NULL;
+
+  this->loaded_first_frame       = false;
+  this->vol_meta_info_loaded     = false;
+  this->current_frame            = 0;
+  this->frame_timer_s            = 0.0;
+  this->previous_keyframe_loaded = this->previous_frame_loaded = -1;
+  this->interp_frame_idx[0]      = this->interp_frame_idx[1]   = -1;
+  this->video_frame_loaded       = this->video_frame_decoded   = -1;
+  this->frame_work_frame         = -1;
+  this->frame_work_wait_ticks    = 0;
+  this->video_planes             = false;
+  this->video_renditions.Empty();
+  this->video_rendition = 0;
+  this->mesh_topology.Reset();
+  free_normals_topology();
+  this->frame_cache.empty();
+  this->geometry_cache_budget_bytes = (int64)this->geometry_cache_mb * 1024 * 1024;
+  this->video_cache_budget_bytes    = (int64)this->video_cache_mb * 1024 * 1024;
+  this->frame_cache.set_budget( this->geometry_cache_budget_bytes );
+  this->memory_usage           = FVologramMemory::FUsage();
+  this->video_cache_used_bytes = 0;
+  FVologramMemory::remove( this );
+}
+
+bool AVologramActor::open_vologram_bundle() {
+  if ( this->vologram_asset ) {
+    // The asset holds a bundle, streamed a chunk at a time from its bulk data.
+    vol_geom_io_t asset_io = FVologramFileIO::asset_io( this->vologram_asset );
+    this->vol_bundle_ptr   = vol_geom_bundle_open( TCHAR_TO_ANSI( *this->vologram_asset->GetPathName() ), &asset_io );
+    if ( !this->vol_bundle_ptr ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: opening vologram asset: `%s`." ), *this->vologram_asset->GetPathName() );
+      return false;
+    }
+    return true;
+  }
+
   // NOTE(Anton) be careful with these Unreal strings - if you dereference the wrong type of string in a UE_LOG it _will_ crash.
+  FString hdr_fstr = this->vol_header_path.FilePath;
+  if ( !hdr_fstr.EndsWith( TEXT( ".volb" ) ) ) { return true; }
+
+  char hdr_char_array[2048];
+  hdr_char_array[0] = '\0';
+  strncat( hdr_char_array, TCHAR_TO_ANSI( *hdr_fstr ), 2047 );
+  // One file handle serves the header, the sequence, and the video, if the bundle has one.
+  vol_geom_io_t geom_io = FVologramFileIO::geom_io();
+  this->vol_bundle_ptr  = vol_geom_bundle_open( hdr_char_array, hdr_fstr.Contains( TEXT( "://" ) ) ? NULL : &geom_io );
+  if ( !this->vol_bundle_ptr ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: opening VOL bundle: `%s`." ), *hdr_fstr );
+    return false;
+  }
+  return true;
+}
+
+bool AVologramActor::open_vologram_geometry() {
   FString hdr_fstr = this->vol_header_path.FilePath;
   FString seq_fstr = this->vol_sequence_path.FilePath;
-  FString mp4_fstr = this->vol_mp4_path.FilePath;
 
   // doing a weird round-about string copy because of temporary memory problems with pointers into FStrings.
-  char mp4_char_array[2048], hdr_char_array[2048], seq_char_array[2048];
-  mp4_char_array[0] = hdr_char_array[0] = seq_char_array[0] = '\0';
+  char hdr_char_array[2048], seq_char_array[2048];
+  hdr_char_array[0] = seq_char_array[0] = '\0';
   strncat( hdr_char_array, TCHAR_TO_ANSI( *hdr_fstr ), 2047 );
   strncat( seq_char_array, TCHAR_TO_ANSI( *seq_fstr ), 2047 );
-  strncat( mp4_char_array, TCHAR_TO_ANSI( *mp4_fstr ), 2047 );
 
-  if ( loaded_first_frame || this->current_frame != 0 ) { vol_av_close( &this->vol_video_info ); }
-  this->loaded_first_frame   = false;
-  this->vol_meta_info_loaded = false;
-  this->current_frame        = 0;
-  this->frame_timer_s        = 0.0;
-
-  { // VIDEO
-    bool res = vol_av_open( mp4_char_array, &this->vol_video_info );
-    if ( !res ) {
-      this->vol_meta_info_loaded = false;
-      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *mp4_fstr );
-      return false;
-    } else {
-      this->vol_meta_info_loaded = true;
-      UE_LOG( LogTemp, Log, TEXT( "[VOL] Loaded VOL MP4 file: `%s`" ), *mp4_fstr );
-      // vol_av_seek_frame(&this->vol_video_info, -1, 0);
-    }
-    read_next_av_frame_to_texture();
-
-    this->fps = vol_av_frame_rate( &this->vol_video_info ); // fetch in case it's not 30 or has changed (sometimes 29.97 or so)
-    if ( fps <= 0.0 ) { fps = 30.0; }                       // if video reports invalid FPS then guess that it should be 30.
-  }
   { // GEOMETRY
-		bool streaming_mode = true;
-    bool res = vol_geom_create_file_info( hdr_char_array, seq_char_array, &this->vol_geom_info, streaming_mode );
+    // Read through the engine's file layer, so volograms can be packaged in pak files. URLs are left to vol_geom's own HTTP reader.
+    vol_geom_io_t geom_io = FVologramFileIO::geom_io();
+    bool streaming_mode   = true;
+    bool is_url           = seq_fstr.Contains( TEXT( "://" ) );
+    bool res              = this->vol_bundle_ptr ?
+                              vol_geom_create_file_info_bundle( this->vol_bundle_ptr, &this->vol_geom_info, streaming_mode ) :
+                              vol_geom_create_file_info_io( hdr_char_array, seq_char_array, &this->vol_geom_info, streaming_mode, is_url ? NULL : &geom_io );
     if ( !res ) {
-      this->vol_meta_info_loaded = false;
       // Note that using ASCII string here (despite it using printf formatting) produces gibberish so using original strings
       // if we need to check the ascii contents we could do a windows-style debug message and capture in debugview or write to a file
       UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL from files. %s %s" ), *hdr_fstr, *seq_fstr );
       return false;
+    }
+    UE_LOG( LogTemp, Log, TEXT( "[VOL] Vologram info loaded from header:`%s` sequence:`%s`\n" ), *hdr_fstr, *seq_fstr );
+  }
+
+  // Captures exported with GPU-ready textures in the sequence are shown without the video, and without decoding anything on the CPU.
+  this->embedded_pixel_format = PF_Unknown;
+  if ( this->use_embedded_textures && this->vol_geom_info.hdr.version >= 11 && this->vol_geom_info.hdr.textured ) {
+    EPixelFormat pixel_format = _pixel_format_from_unity( this->vol_geom_info.hdr.texture_format );
+    if ( PF_Unknown == pixel_format || !GPixelFormats[pixel_format].Supported ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] Embedded texture format %i is not supported on this platform. Using the video instead." ),
+        (int)this->vol_geom_info.hdr.texture_format );
     } else {
-      this->vol_meta_info_loaded = true;
-      UE_LOG( LogTemp, Log, TEXT( "[VOL] Vologram info loaded from header:`%s` sequence:`%s`\n" ), *hdr_fstr, *seq_fstr );
+      this->embedded_pixel_format = pixel_format;
     }
   }
+  return true;
+}
 
+bool AVologramActor::open_vologram_video() {
+  FString mp4_fstr = this->vologram_asset ? FString() : this->vol_mp4_path.FilePath;
+  char mp4_char_array[2048];
+  mp4_char_array[0] = '\0';
+  strncat( mp4_char_array, TCHAR_TO_ANSI( *mp4_fstr ), 2047 );
+
+  if ( !open_video( mp4_char_array, true ) ) { return false; }
+  UE_LOG( LogTemp, Log, TEXT( "[VOL] Loaded VOL MP4 file: `%s`" ), *mp4_fstr );
+  vol_av_set_cache_budget( &this->vol_video_info, this->video_cache_budget_bytes );
+  find_video_renditions();
+  // Only the upload of the first frame is left for the game thread.
+  if ( !vol_av_read_next_frame( &this->vol_video_info ) ) { UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR loading VOL texture from Mp4" ) ); }
   return true;
 }
 
-bool AVologramActor::update_mesh_with_frame( int frame_idx, bool only_if_keyframe ) {
-  // I guess this is a bit of a hack here.
-  if ( !this->vol_meta_info_loaded ) {
-    if ( !load_vologram_meta() ) {
-      UE_LOG( LogTemp, Log, TEXT( "[VOL] ERROR: Failed to load Vologram metadata from files.\n" ) );
+void AVologramActor::finish_vologram_meta() {
+  // Bundles made by vol_geom_pack have bounds for the whole sequence, so the engine can cull the vologram before its first frame is read.
+  proc_mesh_ptr->set_local_bounds( this->vol_geom_info.frame_aabbs_ptr ? _vols_aabb_to_box( this->vol_geom_info.sequence_aabb ) : FBox( ForceInit ) );
+
+  if ( PF_Unknown != this->embedded_pixel_format ) {
+    this->fps = 30.0; // The sequence doesn't store a frame rate, and volograms are captured at 30 FPS.
+  } else { // VIDEO
+    if ( this->gpu_colour_conversion && !this->yuv_material ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] GPU colour conversion needs a YUV material. Converting on the CPU instead." ) );
+    }
+    // The material samples either the RGB "colour" texture or the YUV planes, so it has to match the video's output.
+    UMaterialInterface* base_material_ptr = this->video_planes ? this->yuv_material : this->Material;
+    if ( base_material_ptr ) { proc_mesh_ptr->SetMaterial( 0, UMaterialInstanceDynamic::Create( base_material_ptr, this ) ); }
+    upload_av_frame_to_texture();
+    this->video_frame_loaded = 0;
+
+    this->fps = vol_av_frame_rate( &this->vol_video_info ); // fetch in case it's not 30 or has changed (sometimes 29.97 or so)
+    if ( fps <= 0.0 ) { fps = 30.0; }                       // if video reports invalid FPS then guess that it should be 30.
+  }
+  this->vol_meta_info_loaded = true;
+  update_memory_usage();
+}
+
+FTransform AVologramActor::vologram_transform() const {
+  float tx = vol_geom_info.hdr.translation[0];
+  float ty = vol_geom_info.hdr.translation[1];
+  float tz = vol_geom_info.hdr.translation[2];
+
+  float rx = vol_geom_info.hdr.rotation[1];
+  float ry = vol_geom_info.hdr.rotation[2];
+  float rz = vol_geom_info.hdr.rotation[3];
+  float rw = vol_geom_info.hdr.rotation[0];
+
+  const float u4_scale = 100.0f; // m in .vols to cm in U4
+
+  FTransform T = FTransform( FVector( tz, -tx, ty ) );
+  FTransform R;
+  R.SetRotation( FQuat( rz, -rx, -rw, ry ) ); // NB(Anton) note that z and w are flipped here...
+  FTransform S;
+  S.SetScale3D( FVector( vol_geom_info.hdr.scale, vol_geom_info.hdr.scale, vol_geom_info.hdr.scale ) );
+
+  FTransform RST = S * R * T; // left first then right
+  FTransform Su;
+  Su.SetScale3D( FVector( u4_scale, u4_scale, u4_scale ) );
+
+  return RST * Su;
+}
+
+void AVologramActor::apply_vologram_transform() {
+  FTransform pM = GetActorTransform();
+  SetActorTransform( vologram_transform() * pM );
+}
+
+/** Bounds, in .vols axes, of the placeholder for volograms without precomputed bounds: about the size of a standing person. */
+static const float _default_placeholder_aabb[6] = { -0.5f, 0.0f, -0.5f, 0.5f, 2.0f, 0.5f };
+
+void AVologramActor::start_async_load() {
+  close_vologram();
+  ClearMeshData();
+  this->bundle_load_future = Async( EAsyncExecution::ThreadPool, [this]() { return open_vologram_bundle(); } );
+}
+
+void AVologramActor::start_async_geometry_and_video() {
+  this->geometry_load_future = Async( EAsyncExecution::ThreadPool, [this]() {
+    if ( !open_vologram_geometry() ) { return false; }
+    if ( !vol_geom_is_keyframe( &this->vol_geom_info, 0 ) ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: the first frame of `%s` is not a keyframe." ), *this->vol_sequence_path.FilePath );
       return false;
     }
+    return read_frame_mesh_data( 0, true, this->loaded_frame_data );
+  } );
+  // The video only needs the bundle, so it opens while the frame directory is scanned. Embedded textures, which replace the video, are only known
+  // once the header is read, so the video is opened anyway if there is one, and closed again if they are used.
+  bool has_video = ( !this->vologram_asset && !this->vol_mp4_path.FilePath.IsEmpty() ) ||
+                   ( this->vol_bundle_ptr && vol_geom_bundle_find_chunk( this->vol_bundle_ptr, VOL_GEOM_BUNDLE_CHUNK_VIDEO ) );
+  if ( has_video ) { this->video_load_future = Async( EAsyncExecution::ThreadPool, [this]() { return open_vologram_video(); } ); }
+}
 
-    // Only set this once to avoid a loop of insanity
-    { // ROTATE AND SCALE VOL
+void AVologramActor::update_async_load() {
+  if ( this->bundle_load_future.IsValid() ) {
+    if ( !this->bundle_load_future.IsReady() ) { return; }
+    bool res                 = this->bundle_load_future.Get();
+    this->bundle_load_future = TFuture<bool>();
+    if ( !res ) {
+      UE_LOG( LogTemp, Log, TEXT( "[VOL] ERROR: Failed to load Vologram metadata from files.\n" ) );
+      close_vologram();
+      placeholder_ptr->SetHiddenInGame( true );
+      return;
+    }
+    // Both halves are started here, on the game thread, so that is_async_loading() never sees a future being set from another thread.
+    start_async_geometry_and_video();
+    return;
+  }
 
-      float tx = vol_geom_info.hdr.translation[0];
-      float ty = vol_geom_info.hdr.translation[1];
-      float tz = vol_geom_info.hdr.translation[2];
+  if ( this->geometry_load_future.IsValid() ) {
+    if ( !this->geometry_load_future.IsReady() ) { return; }
+    bool res                   = this->geometry_load_future.Get();
+    this->geometry_load_future = TFuture<bool>();
+    if ( !res ) {
+      UE_LOG( LogTemp, Log, TEXT( "[VOL] ERROR: Failed to load Vologram metadata from files.\n" ) );
+      wait_for_async_load();
+      close_vologram();
+      placeholder_ptr->SetHiddenInGame( true );
+      return;
+    }
+    // The header and bounds are known, so the placeholder can stand where the vologram will be, at its size, while the video finishes.
+    apply_vologram_transform();
+    proc_mesh_ptr->set_local_bounds( this->vol_geom_info.frame_aabbs_ptr ? _vols_aabb_to_box( this->vol_geom_info.sequence_aabb ) : FBox( ForceInit ) );
+    show_placeholder( _vols_aabb_to_box( this->vol_geom_info.frame_aabbs_ptr ? this->vol_geom_info.sequence_aabb : _default_placeholder_aabb ) );
+  }
 
-      float rx = vol_geom_info.hdr.rotation[1];
-      float ry = vol_geom_info.hdr.rotation[2];
-      float rz = vol_geom_info.hdr.rotation[3];
-      float rw = vol_geom_info.hdr.rotation[0];
+  bool video_res = false;
+  if ( this->video_load_future.IsValid() ) {
+    if ( !this->video_load_future.IsReady() ) { return; }
+    video_res               = this->video_load_future.Get();
+    this->video_load_future = TFuture<bool>();
+  }
+  if ( PF_Unknown == this->embedded_pixel_format && !video_res ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *this->vol_mp4_path.FilePath );
+    close_vologram();
+    placeholder_ptr->SetHiddenInGame( true );
+    return;
+  }
+  if ( PF_Unknown != this->embedded_pixel_format ) {
+    vol_av_close( &this->vol_video_info );
+    this->video_renditions.Empty();
+    this->video_planes = false;
+  }
 
-      const float u4_scale = 100.0f; // m in .vols to cm in U4
+  finish_vologram_meta();
+  show_frame_mesh_data( 0, true, this->loaded_frame_data );
+  placeholder_ptr->SetHiddenInGame( true );
+  this->frame_timer_s = 0.0;
+  OnVologramReady.Broadcast( this );
+}
 
-      FTransform T = FTransform( FVector( tz, -tx, ty ) );
-      FTransform R;
-      R.SetRotation( FQuat( rz, -rx, -rw, ry ) ); // NB(Anton) note that z and w are flipped here...
-      FTransform S;
-      S.SetScale3D( FVector( vol_geom_info.hdr.scale, vol_geom_info.hdr.scale, vol_geom_info.hdr.scale ) );
+void AVologramActor::wait_for_async_load() {
+  // The geometry and video loads are only started once the bundle is open, from update_async_load(), so nothing else is running yet.
+  if ( this->bundle_load_future.IsValid() ) {
+    this->bundle_load_future.Wait();
+    this->bundle_load_future = TFuture<bool>();
+  }
+  if ( this->geometry_load_future.IsValid() ) {
+    this->geometry_load_future.Wait();
+    this->geometry_load_future = TFuture<bool>();
+  }
+  if ( this->video_load_future.IsValid() ) {
+    this->video_load_future.Wait();
+    this->video_load_future = TFuture<bool>();
+  }
+}
 
-      FTransform RST = S * R * T; // left first then right
-      FTransform Su;
-      Su.SetScale3D( FVector( u4_scale, u4_scale, u4_scale ) );
+void AVologramActor::show_placeholder( const FBox& local_box ) {
+  placeholder_ptr->SetRelativeLocation( local_box.GetCenter() );
+  placeholder_ptr->SetBoxExtent( local_box.GetExtent() );
+  placeholder_ptr->SetHiddenInGame( !this->show_loading_placeholder );
+}
 
-      FTransform pM = GetActorTransform();
-      SetActorTransform( RST * Su * pM );
+bool AVologramActor::update_mesh_with_frame( int frame_idx, bool only_if_keyframe ) {
+  FFrameRead read;
+  if ( !start_frame_update( frame_idx, only_if_keyframe, read ) ) { return false; }
+  if ( read.frame_idx < 0 ) { return true; }
+  if ( !read_frame_mesh_data( read.frame_idx, read.is_keyframe, read.frame_data ) ) { return false; }
+  show_frame_mesh_data( read.frame_idx, read.topology_changed, read.frame_data );
+  return true;
+}
+
+bool AVologramActor::start_frame_update( int frame_idx, bool only_if_keyframe, FFrameRead& read ) {
+  // I guess this is a bit of a hack here.
+  if ( !this->vol_meta_info_loaded ) {
+    if ( !load_vologram_meta() ) {
+      UE_LOG( LogTemp, Log, TEXT( "[VOL] ERROR: Failed to load Vologram metadata from files.\n" ) );
+      return false;
     }
+
+    // Only set this once to avoid a loop of insanity
+    apply_vologram_transform();
   }
 
   if ( frame_idx < 0 || frame_idx >= this->vol_geom_info.hdr.frame_count ) {
@@ -142,12 +637,60 @@ bool AVologramActor::update_mesh_with_frame( int frame_idx, bool only_if_keyfram
 
   bool is_keyframe = ( vol_geom_info.frame_headers_ptr[frame_idx].keyframe != 0 );
   if ( only_if_keyframe && !is_keyframe ) { return true; } // frameskip/drop (can't skip keyframes)
+
+  const FVologramFrameCache::FFrame* cached_frame_ptr = this->frame_cache.find( frame_idx );
+  if ( cached_frame_ptr ) {
+    update_mesh_with_cached_frame( frame_idx, *cached_frame_ptr );
+    return true;
+  }
+
+  // A tracked frame reuses the indices and UVs of the last keyframe loaded. When jumping or playing backwards that may be from another group of frames,
+  // so use a cached copy of this frame's topology, or load its keyframe first. Playing backwards in v12 files, the last frame of each group
+  // (keyframe type 2) stores its topology, so this only happens after a jump, or with older files.
+  bool topology_changed = is_keyframe;
+  if ( !is_keyframe &&
+       ( this->previous_keyframe_loaded < 0 || !vol_geom_frames_share_topology( &this->vol_geom_info, this->previous_keyframe_loaded, frame_idx ) ) ) {
+    TSharedPtr<const FVologramFrameCache::FTopology> topology = this->frame_cache.find_topology( &this->vol_geom_info, frame_idx );
+    if ( topology.IsValid() ) {
+      this->mesh_topology            = topology;
+      this->triangles                = topology->triangles;
+      this->uvs                      = topology->uvs;
+      this->previous_keyframe_loaded = topology->keyframe_idx;
+      topology_changed               = true;
+    } else {
+      int keyframe_idx = vol_geom_find_previous_keyframe( &this->vol_geom_info, frame_idx );
+      if ( keyframe_idx < 0 || !update_mesh_with_frame( keyframe_idx, false ) ) { return false; }
+    }
+  }
   if ( is_keyframe ) {
     ClearMeshData();
   } else {
     ClearIntermediateMeshData();
   }
 
+  // A tracked frame may already have been read ahead, as the target for interpolation. Swap buffers instead of reading it again.
+  int next_buffer = 1 - this->interp_current;
+  if ( this->interpolate_frames && !topology_changed && this->interp_frame_idx[next_buffer] == frame_idx ) {
+    this->interp_current = next_buffer;
+    const float* next_normals_ptr = interp_normals[next_buffer].Num() > 0 ? interp_normals[next_buffer].GetData() : NULL;
+    set_mesh_bounds( frame_idx, -1 );
+    set_vertices_and_normals( interp_positions[next_buffer].GetData(), next_normals_ptr, interp_positions[next_buffer].Num() / 3 );
+    set_tangents( interp_positions[next_buffer].GetData(), next_normals_ptr, interp_positions[next_buffer].Num() / 3 );
+    proc_mesh_ptr->UpdateMeshSection_LinearColor( 0, vertices, normals, uvs, vertex_colours, tangents );
+    add_frame_to_cache( frame_idx );
+    prefetch_next_interpolation_frame( frame_idx );
+    loaded_first_frame          = true;
+    this->previous_frame_loaded = frame_idx;
+    return true;
+  }
+
+  read.frame_idx        = frame_idx;
+  read.is_keyframe      = is_keyframe;
+  read.topology_changed = topology_changed;
+  return true;
+}
+
+bool AVologramActor::read_frame_mesh_data( int frame_idx, bool is_keyframe, vol_geom_frame_data_t& frame_data ) {
   // NOTE(Anton) be careful with these Unreal strings - if you dereference the wrong type of string in a UE_LOG it _will_ crash.
   FString hdr_fstr = this->vol_header_path.FilePath;
   FString seq_fstr = this->vol_sequence_path.FilePath;
@@ -158,137 +701,479 @@ bool AVologramActor::update_mesh_with_frame( int frame_idx, bool only_if_keyfram
   strncat( hdr_char_array, TCHAR_TO_ANSI( *hdr_fstr ), 2047 );
   strncat( seq_char_array, TCHAR_TO_ANSI( *seq_fstr ), 2047 );
 
-  vol_geom_frame_data_t frame_data = { 0 };
-  bool res                         = vol_geom_read_frame( seq_char_array, &this->vol_geom_info, frame_idx, &frame_data );
+  bool res = false;
+  {
+    // Includes decoding time for compressed sequences. Compare against an uncompressed copy to see the I/O trade-off.
+    SCOPE_CYCLE_COUNTER( STAT_VologramGeometryRead );
+    res = vol_geom_read_frame( seq_char_array, &this->vol_geom_info, frame_idx, &frame_data );
+  }
   if ( !res ) {
     UE_LOG( LogClass, Log, TEXT( "[VOL] ERROR: loading VOL from files. %s %s" ), *hdr_fstr, *seq_fstr );
     return false;
   }
   int n_vertices = frame_data.vertices_sz / ( sizeof( float ) * 3 );
 
-  float* points_ptr = (float*)&frame_data.block_data_ptr[frame_data.vertices_offset];
-  vertices.Reserve( n_vertices );
-  for ( int i = 0; i < n_vertices; i++ ) {
-    float x = points_ptr[i * 3 + 0];
-    float y = points_ptr[i * 3 + 1];
-    float z = points_ptr[i * 3 + 2];
-    // Note ordering change for U4. .vols uses Unity  {+x right,       +y up,    +z into screen} axes.
-    //                                         Unreal {+x into screen, +y right, +z up}.
-    //                                 Typical OpenGL {+x right,       +y up,    +z out of screen}.
-    vertices.Add( FVector( z, x, y ) );
-  }
-  normals.Reserve( n_vertices );
-  vertex_colours.Reserve( n_vertices );
-  if ( this->vol_geom_info.hdr.normals && this->vol_geom_info.hdr.version >= 11 ) {
-    float* normals_ptr = (float*)&frame_data.block_data_ptr[frame_data.normals_offset];
-    for ( int i = 0; i < n_vertices; i++ ) {
-      float x = normals_ptr[i * 3 + 0];
-      float y = normals_ptr[i * 3 + 1];
-      float z = normals_ptr[i * 3 + 2];
-      // NOTE(Anton) 14 Jan 2022 updated component order here to match vertex order as per latest vologram reconstructions.
-      normals.Add( FVector( z, x, y ) );
-      vertex_colours.Add( FLinearColor( z, x, y ) );
-    }
-  }
-
-  uint8_t indices_type = 0;
   if ( is_keyframe ) {
     uint8_t* uv_byte_ptr = &frame_data.block_data_ptr[frame_data.uvs_offset];
     float* texcoords_ptr = (float*)uv_byte_ptr; // NOTE(Anton) potential alignment issue here with 4-byte floats
 
+    // Embedded textures keep Unity's memory layout, where the first row is at v = 0 as in U4, so only the video needs V flipping.
+    bool flip_v = PF_Unknown == this->embedded_pixel_format;
     uvs.Reserve( n_vertices );
     for ( int i = 0; i < n_vertices; i++ ) {
-      uvs.Add( FVector2D( texcoords_ptr[i * 2 + 0], 1.0f - texcoords_ptr[i * 2 + 1] ) ); // NOTE(Anton) 1.0 - here to flip UV convention for U4.
+      float v = texcoords_ptr[i * 2 + 1];
+      uvs.Add( FVector2D( texcoords_ptr[i * 2 + 0], flip_v ? 1.0f - v : v ) ); // NOTE(Anton) 1.0 - here to flip UV convention for U4.
     }
 
-    indices_type  = n_vertices >= 65535 ? 2 : 1; // uint (2), or ushort (1) is used for small meshes (or old versions of Unity).
-    int n_indices = 0;
-    if ( indices_type == 1 ) {
-      n_indices = frame_data.indices_sz / sizeof( uint16_t );
-    } else {
-      n_indices = frame_data.indices_sz;
+    // uint, or ushort for small meshes (or old versions of Unity).
+    int index_sz  = n_vertices >= 65535 ? sizeof( uint32_t ) : sizeof( uint16_t );
+    int n_indices = frame_data.indices_sz / index_sz;
+    // NOTE(Anton) reordering from 0,1,2 to 0,2,1 to avoid needing CW winding order (x is mirrored)
+    triangles.SetNumUninitialized( n_indices );
+    if ( frame_data.indices_sz % ( index_sz * 3 ) != 0 ||
+         !vol_geom_convert_indices( &frame_data.block_data_ptr[frame_data.indices_offset], index_sz, n_indices, n_vertices, true, (uint32_t*)triangles.GetData() ) ) {
+      UE_LOG( LogClass, Log, TEXT( "[VOL] ERROR: invalid indices in keyframe %i of %s" ), frame_idx, *seq_fstr );
+      triangles.Empty();
+      uvs.Empty();
+      return false;
     }
 
-    if ( indices_type == 1 ) {
-      uint16_t* indices_short_ptr = (uint16_t*)&frame_data.block_data_ptr[frame_data.indices_offset];
-      for ( int i = 0; i < n_indices / 3; i++ ) {
-        // NOTE(Anton) reordering from 0,1,2 to 0,2,1 to avoid needing CW winding order (x is mirrored)
-        triangles.Add( indices_short_ptr[i * 3 + 0] );
-        triangles.Add( indices_short_ptr[i * 3 + 2] );
-        triangles.Add( indices_short_ptr[i * 3 + 1] );
-      }
-    } else {
-      uint8_t* indices_byte_ptr = (uint8_t*)&frame_data.block_data_ptr[frame_data.indices_offset];
-      for ( int i = 0; i < n_indices / 3; i++ ) {
-        // NOTE(Anton) reordering from 0,1,2 to 0,2,1 to avoid needing CW winding order (x is mirrored)
-        triangles.Add( indices_byte_ptr[i * 3 + 0] );
-        triangles.Add( indices_byte_ptr[i * 3 + 2] );
-        triangles.Add( indices_byte_ptr[i * 3 + 1] );
-      }
+    if ( this->geometry_cache_mb > 0 ) {
+      TSharedRef<FVologramFrameCache::FTopology> topology = MakeShared<FVologramFrameCache::FTopology>();
+      topology->keyframe_idx                               = frame_idx;
+      topology->triangles                                  = triangles;
+      topology->uvs                                        = uvs;
+      this->mesh_topology                                  = topology;
     }
+    this->previous_keyframe_loaded = frame_idx;
+  }
+
+  const float* points_ptr  = (float*)&frame_data.block_data_ptr[frame_data.vertices_offset];
+  const float* normals_ptr = NULL;
+  if ( this->vol_geom_info.hdr.normals && this->vol_geom_info.hdr.version >= 11 ) {
+    normals_ptr = (float*)&frame_data.block_data_ptr[frame_data.normals_offset];
+  } else {
+    normals_ptr = generate_vertex_normals( points_ptr, n_vertices, this->generated_normals );
+  }
+  set_vertices_and_normals( points_ptr, normals_ptr, n_vertices );
+  if ( this->interpolate_frames ) {
+    // Keep this frame to blend from.
+    interp_positions[interp_current].SetNumUninitialized( n_vertices * 3 );
+    FMemory::Memcpy( interp_positions[interp_current].GetData(), points_ptr, n_vertices * 3 * sizeof( float ) );
+    interp_normals[interp_current].SetNumUninitialized( normals_ptr ? n_vertices * 3 : 0 );
+    if ( normals_ptr ) { FMemory::Memcpy( interp_normals[interp_current].GetData(), normals_ptr, n_vertices * 3 * sizeof( float ) ); }
+    interp_frame_idx[interp_current] = frame_idx;
   }
 
+  set_tangents( points_ptr, normals_ptr, n_vertices );
+  return true;
+}
+
+void AVologramActor::show_frame_mesh_data( int frame_idx, bool topology_changed, const vol_geom_frame_data_t& frame_data ) {
+  if ( PF_Unknown != this->embedded_pixel_format ) { upload_embedded_texture( frame_idx, frame_data ); }
+
   // Function that creates mesh section
-  tangents.Init( FProcMeshTangent( 1.0f, 0.0f, 0.0f ), 3 );
+  set_mesh_bounds( frame_idx, -1 );
   bool create_collision = false; // probably don't need collisions
-  if ( is_keyframe ) {
+  if ( topology_changed ) {
     proc_mesh_ptr->CreateMeshSection_LinearColor( 0, vertices, triangles, normals, uvs, vertex_colours, tangents, create_collision );
   } else {
     proc_mesh_ptr->UpdateMeshSection_LinearColor( 0, vertices, normals, uvs, vertex_colours, tangents );
   }
+  add_frame_to_cache( frame_idx );
+
+  // Read ahead last, as it reuses the frame blob that frame_data points into.
+  if ( this->interpolate_frames ) { prefetch_next_interpolation_frame( frame_idx ); }
+  read_ahead_geometry( frame_idx );
+
+  loaded_first_frame          = true;
+  this->previous_frame_loaded = frame_idx;
+}
+
+void AVologramActor::update_mesh_with_cached_frame( int frame_idx, const FVologramFrameCache::FFrame& frame ) {
+  bool topology_changed = this->mesh_topology != frame.topology;
+  ClearIntermediateMeshData();
+  vertices       = frame.vertices;
+  normals        = frame.normals;
+  vertex_colours = frame.vertex_colours;
+  if ( topology_changed ) {
+    this->mesh_topology            = frame.topology;
+    this->triangles                = frame.topology->triangles;
+    this->uvs                      = frame.topology->uvs;
+    this->previous_keyframe_loaded = frame.topology->keyframe_idx;
+  }
+
+  tangents = frame.tangents;
+  set_mesh_bounds( frame_idx, -1 );
+  if ( topology_changed ) {
+    proc_mesh_ptr->CreateMeshSection_LinearColor( 0, vertices, triangles, normals, uvs, vertex_colours, tangents, false );
+  } else {
+    proc_mesh_ptr->UpdateMeshSection_LinearColor( 0, vertices, normals, uvs, vertex_colours, tangents );
+  }
+
+  if ( this->interpolate_frames ) {
+    set_interpolation_buffer( this->interp_current, frame_idx, frame );
+    prefetch_next_interpolation_frame( frame_idx );
+  }
+  read_ahead_geometry( frame_idx );
+  loaded_first_frame          = true;
+  this->previous_frame_loaded = frame_idx;
+}
+
+void AVologramActor::read_ahead_geometry( int frame_idx ) {
+  int ahead_idx = frame_idx + this->playback_step;
+  if ( this->interp_frame_idx[1 - this->interp_current] == ahead_idx ) { ahead_idx += this->playback_step; } // Already read for interpolation.
+  if ( ahead_idx < 0 || ahead_idx >= this->vol_geom_info.hdr.frame_count || this->frame_cache.contains( ahead_idx ) ) { return; }
+  vol_geom_prefetch_frame( &this->vol_geom_info, ahead_idx );
+}
+
+void AVologramActor::add_frame_to_cache( int frame_idx ) {
+  if ( this->geometry_cache_mb <= 0 || !this->mesh_topology.IsValid() ) { return; }
+
+  FVologramFrameCache::FFrame frame;
+  frame.vertices       = vertices;
+  frame.normals        = normals;
+  frame.vertex_colours = vertex_colours;
+  frame.tangents       = tangents;
+  frame.topology       = this->mesh_topology;
+  this->frame_cache.add( frame_idx, MoveTemp( frame ) );
+}
+
+void AVologramActor::set_interpolation_buffer( int buffer, int frame_idx, const FVologramFrameCache::FFrame& frame ) {
+  // Inverse of the axis swap in set_vertices_and_normals().
+  int n_vertices = frame.vertices.Num();
+  interp_positions[buffer].SetNumUninitialized( n_vertices * 3 );
+  for ( int i = 0; i < n_vertices; i++ ) {
+    interp_positions[buffer][i * 3 + 0] = frame.vertices[i].Y;
+    interp_positions[buffer][i * 3 + 1] = frame.vertices[i].Z;
+    interp_positions[buffer][i * 3 + 2] = frame.vertices[i].X;
+  }
+  int n_normals = frame.normals.Num() == n_vertices ? n_vertices : 0;
+  interp_normals[buffer].SetNumUninitialized( n_normals * 3 );
+  for ( int i = 0; i < n_normals; i++ ) {
+    interp_normals[buffer][i * 3 + 0] = frame.normals[i].Y;
+    interp_normals[buffer][i * 3 + 1] = frame.normals[i].Z;
+    interp_normals[buffer][i * 3 + 2] = frame.normals[i].X;
+  }
+  interp_frame_idx[buffer] = frame_idx;
+}
 
-  loaded_first_frame = true;
+void AVologramActor::prefetch_next_interpolation_frame( int frame_idx ) {
+  int next_buffer = 1 - this->interp_current;
+  int next_idx    = frame_idx + this->playback_step;
+  this->interp_frame_idx[next_buffer] = -1;
+  if ( next_idx < 0 || next_idx >= this->vol_geom_info.hdr.frame_count || !vol_geom_frames_share_topology( &this->vol_geom_info, frame_idx, next_idx ) ) { return; }
 
+  const FVologramFrameCache::FFrame* cached_frame_ptr = this->frame_cache.find( next_idx );
+  if ( cached_frame_ptr ) {
+    if ( cached_frame_ptr->vertices.Num() * 3 == interp_positions[interp_current].Num() ) { set_interpolation_buffer( next_buffer, next_idx, *cached_frame_ptr ); }
+    return;
+  }
+
+  FString seq_fstr = this->vol_sequence_path.FilePath;
+  char seq_char_array[2048];
+  seq_char_array[0] = '\0';
+  strncat( seq_char_array, TCHAR_TO_ANSI( *seq_fstr ), 2047 );
+
+  vol_geom_frame_data_t frame_data = { 0 };
+  {
+    SCOPE_CYCLE_COUNTER( STAT_VologramGeometryRead );
+    if ( !vol_geom_read_frame( seq_char_array, &this->vol_geom_info, next_idx, &frame_data ) ) { return; }
+  }
+  int n_floats = frame_data.vertices_sz / sizeof( float );
+  if ( n_floats != interp_positions[interp_current].Num() ) { return; } // Vertices don't correspond one-to-one, so can't be blended.
+  bool has_normals = this->vol_geom_info.hdr.normals && this->vol_geom_info.hdr.version >= 11;
+  if ( has_normals && frame_data.normals_sz != frame_data.vertices_sz ) { return; }
+
+  interp_positions[next_buffer].SetNumUninitialized( n_floats );
+  FMemory::Memcpy( interp_positions[next_buffer].GetData(), &frame_data.block_data_ptr[frame_data.vertices_offset], n_floats * sizeof( float ) );
+  if ( has_normals ) {
+    interp_normals[next_buffer].SetNumUninitialized( n_floats );
+    FMemory::Memcpy( interp_normals[next_buffer].GetData(), &frame_data.block_data_ptr[frame_data.normals_offset], n_floats * sizeof( float ) );
+  } else if ( !generate_vertex_normals( interp_positions[next_buffer].GetData(), n_floats / 3, interp_normals[next_buffer] ) ) {
+    interp_normals[next_buffer].Reset();
+  }
+  this->interp_frame_idx[next_buffer] = next_idx;
+}
+
+void AVologramActor::update_mesh_with_interpolation( float t ) {
+  int next_buffer = 1 - this->interp_current;
+  if ( !loaded_first_frame || this->interp_frame_idx[interp_current] != this->current_frame || this->interp_frame_idx[next_buffer] != this->current_frame + this->playback_step ) {
+    return;
+  }
+  SCOPE_CYCLE_COUNTER( STAT_VologramInterpolation );
+
+  t                = FMath::Clamp( t, 0.0f, 1.0f );
+  int n_floats     = interp_positions[next_buffer].Num();
+  bool has_normals = interp_normals[next_buffer].Num() == n_floats && interp_normals[interp_current].Num() == n_floats;
+  blend_positions.SetNumUninitialized( n_floats );
+  vol_geom_lerp_floats( interp_positions[interp_current].GetData(), interp_positions[next_buffer].GetData(), t, blend_positions.GetData(), n_floats );
+  if ( has_normals ) {
+    blend_normals.SetNumUninitialized( n_floats );
+    vol_geom_lerp_floats( interp_normals[interp_current].GetData(), interp_normals[next_buffer].GetData(), t, blend_normals.GetData(), n_floats );
+  }
+
+  ClearIntermediateMeshData();
+  set_vertices_and_normals( blend_positions.GetData(), has_normals ? blend_normals.GetData() : NULL, n_floats / 3 );
+  set_tangents( blend_positions.GetData(), has_normals ? blend_normals.GetData() : NULL, n_floats / 3 );
+  set_mesh_bounds( this->current_frame, this->current_frame + this->playback_step );
+  proc_mesh_ptr->UpdateMeshSection_LinearColor( 0, vertices, normals, uvs, vertex_colours, tangents );
+}
+
+bool AVologramActor::open_video( const char* mp4_path, bool use_bundle ) {
+  if ( !open_video_file( mp4_path, use_bundle ) ) { return false; }
+  // The decoder's planes are uploaded as they are, and converted to RGB by yuv_material.
+  this->video_planes =
+    this->gpu_colour_conversion && this->yuv_material && vol_av_set_output_format( &this->vol_video_info, VOL_AV_OUTPUT_YUV420_PLANES );
+  // Otherwise vol_av converts frames to RGBA, which the texture takes without another copy.
+  if ( !this->video_planes && !vol_av_set_output_format( &this->vol_video_info, VOL_AV_OUTPUT_RGBA32 ) ) {
+    vol_av_close( &this->vol_video_info );
+    return false;
+  }
   return true;
 }
 
+bool AVologramActor::open_video_file( const char* mp4_path, bool use_bundle ) {
+  // Local files go through the engine's file layer, so the video can be packaged in a pak file. URLs are left to FFmpeg's network protocols.
+  vol_av_io_t video_io;
+  const vol_geom_bundle_chunk_t* chunk_ptr =
+    use_bundle && this->vol_bundle_ptr ? vol_geom_bundle_find_chunk( this->vol_bundle_ptr, VOL_GEOM_BUNDLE_CHUNK_VIDEO ) : NULL;
+  if ( chunk_ptr ) {
+    // A local bundle's, or an asset's, video is read through the bundle's own reads. A remote bundle's video is given to FFmpeg as a byte range of the URL, which
+    // FFmpeg reads over its own connection, as the one vol_geom uses isn't shared between threads.
+    FString bundle_fstr = this->vol_header_path.FilePath;
+    if ( this->vologram_asset || !bundle_fstr.Contains( TEXT( "://" ) ) ) {
+      return FVologramFileIO::bundle_video_io( this->vol_bundle_ptr, &video_io ) && vol_av_open_io( &video_io, &this->vol_video_info );
+    }
+    char subfile_url[2200];
+    snprintf( subfile_url, sizeof( subfile_url ), "subfile,,start,%llu,end,%llu,,:%s", (unsigned long long)chunk_ptr->offset,
+      (unsigned long long)( chunk_ptr->offset + chunk_ptr->raw_sz ), TCHAR_TO_ANSI( *bundle_fstr ) );
+    return vol_av_open( subfile_url, &this->vol_video_info );
+  }
+  if ( !strstr( mp4_path, "://" ) && FVologramFileIO::video_io( mp4_path, &video_io ) ) { return vol_av_open_io( &video_io, &this->vol_video_info ); }
+  return vol_av_open( mp4_path, &this->vol_video_info );
+}
+
+bool AVologramActor::open_video_rendition( int rendition ) {
+  stop_video_preroll();
+  vol_av_close( &this->vol_video_info );
+  const FVideoRendition& video = this->video_renditions[rendition];
+  char mp4_char_array[2048];
+  mp4_char_array[0] = '\0';
+  strncat( mp4_char_array, TCHAR_TO_ANSI( *video.path ), 2047 );
+  if ( !open_video( mp4_char_array, video.is_main ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *video.path );
+    return false;
+  }
+  vol_av_set_cache_budget( &this->vol_video_info, this->video_cache_budget_bytes );
+  this->video_rendition = rendition;
+  return true;
+}
+
+void AVologramActor::find_video_renditions() {
+  int w = 0, h = 0;
+  vol_av_dimensions( &this->vol_video_info, &w, &h );
+  FVideoRendition main_video;
+  main_video.path    = this->vologram_asset ? FString() : this->vol_mp4_path.FilePath;
+  main_video.size    = FMath::Max( w, h );
+  main_video.is_main = true;
+  this->video_renditions.Add( main_video );
+
+  // Each rendition is opened once, only to find its size.
+  for ( const FFilePath& rendition_path : this->vol_mp4_rendition_paths ) {
+    if ( rendition_path.FilePath.IsEmpty() ) { continue; }
+    char mp4_char_array[2048];
+    mp4_char_array[0] = '\0';
+    strncat( mp4_char_array, TCHAR_TO_ANSI( *rendition_path.FilePath ), 2047 );
+    vol_av_video_t probe_info = {};
+    vol_av_io_t video_io;
+    bool is_file = !strstr( mp4_char_array, "://" ) && FVologramFileIO::video_io( mp4_char_array, &video_io );
+    bool res     = is_file ? vol_av_open_io( &video_io, &probe_info ) : vol_av_open( mp4_char_array, &probe_info );
+    if ( !res ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 rendition: `%s`. Skipping it." ), *rendition_path.FilePath );
+      continue;
+    }
+    vol_av_dimensions( &probe_info, &w, &h );
+    vol_av_close( &probe_info );
+    FVideoRendition rendition;
+    rendition.path = rendition_path.FilePath;
+    rendition.size = FMath::Max( w, h );
+    this->video_renditions.Add( rendition );
+  }
+
+  this->video_renditions.StableSort( []( const FVideoRendition& a, const FVideoRendition& b ) { return a.size > b.size; } );
+  this->video_rendition = this->video_renditions.IndexOfByPredicate( []( const FVideoRendition& video ) { return video.is_main; } );
+}
+
+int AVologramActor::choose_video_rendition() const {
+  if ( this->video_renditions.Num() < 2 ) { return this->video_rendition; }
+  float size_px = screen_size_px();
+  if ( size_px < 0.0f ) { return 0; } // No player view, e.g. in the Editor, so show the video at its best.
+
+  float wanted_size = size_px * this->rendition_texels_per_pixel;
+  for ( int i = this->video_renditions.Num() - 1; i > 0; i-- ) {
+    // Only step down with room to spare, so a vologram near the threshold doesn't switch back and forth at every keyframe.
+    float margin = i > this->video_rendition ? 1.25f : 1.0f;
+    if ( this->video_renditions[i].size >= wanted_size * margin ) { return i; }
+  }
+  return 0;
+}
+
+int AVologramActor::choose_video_first_mip( int w, int h ) {
+  if ( !this->video_mips ) { return 0; }
+  float size_px = screen_size_px();
+  if ( size_px < 0.0f ) { // No player view, e.g. in the Editor.
+    this->video_first_mip = 0;
+    return 0;
+  }
+
+  // Mips smaller than this are always kept, so a vologram far away, or shown before its bounds are known, isn't a single colour.
+  const float min_size = 64.0f;
+  float wanted_size    = FMath::Max( size_px * this->rendition_texels_per_pixel, min_size );
+  int size             = FMath::Max( w, h ), first_mip = 0;
+  // As with renditions, only drop a mip with room to spare.
+  while ( ( size >> ( first_mip + 1 ) ) >= wanted_size * ( first_mip + 1 > this->video_first_mip ? 1.25f : 1.0f ) ) { first_mip++; }
+  this->video_first_mip = first_mip;
+  return first_mip;
+}
+
+float AVologramActor::screen_size_px() const {
+  UWorld* world_ptr = GetWorld();
+  if ( !world_ptr || !GEngine || !GEngine->GameViewport ) { return -1.0f; }
+  FVector2D viewport_sz;
+  GEngine->GameViewport->GetViewportSize( viewport_sz );
+
+  const FBoxSphereBounds& bounds = proc_mesh_ptr->Bounds;
+  float size_px                  = -1.0f;
+  for ( FConstPlayerControllerIterator it = world_ptr->GetPlayerControllerIterator(); it; ++it ) {
+    const APlayerController* controller_ptr = it->Get();
+    if ( !controller_ptr || !controller_ptr->PlayerCameraManager ) { continue; }
+    const APlayerCameraManager* camera_ptr = controller_ptr->PlayerCameraManager;
+    float dist                             = (float)FVector::Dist( camera_ptr->GetCameraLocation(), bounds.Origin );
+    float tan_half_fov                     = FMath::Tan( FMath::DegreesToRadians( camera_ptr->GetFOVAngle() * 0.5f ) );
+    if ( dist <= bounds.SphereRadius || tan_half_fov <= 0.0f ) { return MAX_flt; } // The camera is inside the vologram's bounds.
+    size_px = FMath::Max( size_px, (float)( bounds.SphereRadius * viewport_sz.X / ( dist * tan_half_fov ) ) );
+  }
+  return size_px;
+}
+
 void AVologramActor::read_next_av_frame_to_texture() {
   if ( !vol_av_read_next_frame( &this->vol_video_info ) ) {
     UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR loading VOL texture from Mp4" ) );
     return;
   }
+  upload_av_frame_to_texture();
+}
+
+void AVologramActor::read_av_frame_to_texture( int frame_idx ) {
+  if ( !vol_av_read_frame( &this->vol_video_info, frame_idx ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR loading VOL texture frame %i from Mp4" ), frame_idx );
+    return;
+  }
+  upload_av_frame_to_texture();
+}
 
-  // TODO(Anton) if possible pre-allocate this when loading meta-data and just realloc here if required.
-  // HACK TEMP(anton)
-  int w            = this->vol_video_info.w;
-  int h            = this->vol_video_info.h;
-  size_t sz        = (size_t)( this->vol_video_info.w * this->vol_video_info.h * 4 );
-  uint8_t* img_ptr = (uint8_t*)malloc( sz );
+void AVologramActor::update_video_texture() {
+  if ( !this->vol_meta_info_loaded || this->video_frame_loaded == this->current_frame ) { return; }
+  if ( PF_Unknown != this->embedded_pixel_format ) {
+    read_embedded_texture( this->current_frame );
+    return;
+  }
+  if ( !this->video_lock.TryLock() ) { return; } // The preroll worker is decoding. Don't stall the game thread; try again next tick.
 
-  // TODO(Anton) have vol_av give you a 4-channel image on demand.
-  for ( int y = 0; y < h; y++ ) {
-    for ( int x = 0; x < w; x++ ) {
-      int idx              = ( y * w + x );
-      img_ptr[idx * 4 + 0] = this->vol_video_info.pixels_ptr[idx * 3 + 0];
-      img_ptr[idx * 4 + 1] = this->vol_video_info.pixels_ptr[idx * 3 + 1];
-      img_ptr[idx * 4 + 2] = this->vol_video_info.pixels_ptr[idx * 3 + 2];
-      img_ptr[idx * 4 + 3] = 0xFF;
+  // The frame work may have decoded the frame already, on a worker thread.
+  if ( this->video_frame_decoded == this->current_frame || decode_video_frame() ) { upload_av_frame_to_texture(); }
+  this->video_frame_decoded = -1;
+  this->video_frame_loaded  = this->current_frame;
+  // Renditions share keyframes, so another rendition can start decoding at this frame without the frames before it.
+  int rendition = this->vol_video_info.key_frame ? choose_video_rendition() : this->video_rendition;
+  this->video_lock.Unlock();
+
+  if ( rendition != this->video_rendition ) {
+    int previous_rendition = this->video_rendition;
+    if ( !open_video_rendition( rendition ) && !open_video_rendition( previous_rendition ) ) { return; }
+    read_av_frame_to_texture( this->current_frame );
+  }
+  request_video_preroll( this->current_frame );
+}
+
+bool AVologramActor::decode_video_frame() {
+  // Decoding the next video frame is cheapest. Otherwise, e.g. playing backwards or after preroll moved the decoder, find the frame by its timestamp.
+  bool res = false;
+  if ( this->video_preroll_frames <= 0 && this->video_frame_loaded >= 0 && this->video_frame_loaded + 1 == this->current_frame ) {
+    res = vol_av_read_next_frame( &this->vol_video_info );
+  } else {
+    res = vol_av_read_frame( &this->vol_video_info, this->current_frame );
+  }
+  if ( !res ) { UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR loading VOL texture frame %i from Mp4" ), this->current_frame ); }
+  this->video_frame_decoded = res ? this->current_frame : -1;
+  return res;
+}
+
+void AVologramActor::request_video_preroll( int frame_idx ) {
+  if ( this->video_preroll_frames <= 0 ) { return; }
+  this->preroll_target_frame.Set( frame_idx );
+  if ( this->preroll_future.IsValid() && !this->preroll_future.IsReady() ) { return; } // The running worker picks up the new target.
+  this->preroll_future = Async( EAsyncExecution::ThreadPool, [this]() { run_video_preroll(); } );
+}
+
+void AVologramActor::run_video_preroll() {
+  int done_frame = -1;
+  for ( int centre_frame = this->preroll_target_frame.GetValue(); centre_frame >= 0 && centre_frame != done_frame;
+        centre_frame = this->preroll_target_frame.GetValue() ) {
+    done_frame      = centre_frame;
+    int first_frame = FMath::Max( 0, centre_frame - this->video_preroll_frames );
+    int last_frame  = FMath::Min( this->vol_geom_info.hdr.frame_count - 1, centre_frame + this->video_preroll_frames );
+    // In increasing order, so that at most one seek is needed. Lock per frame so the game thread is never kept waiting long.
+    for ( int i = first_frame; i <= last_frame && this->preroll_target_frame.GetValue() == centre_frame; i++ ) {
+      FScopeLock lock( &this->video_lock );
+      vol_av_cache_frame( &this->vol_video_info, i );
     }
   }
+}
 
-  if ( !texture_ptr ) {
-    texture_ptr = UTexture2D::CreateTransient( w, h, PF_R8G8B8A8 );
-    if ( !texture_ptr ) {
-      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR texture_ptr" ) );
+void AVologramActor::stop_video_preroll() {
+  this->preroll_target_frame.Set( -1 );
+  if ( this->preroll_future.IsValid() ) { this->preroll_future.Wait(); }
+}
+
+void AVologramActor::read_embedded_texture( int frame_idx ) {
+  // The mesh was shown from the frame cache or the interpolation buffers, which don't keep textures, so read the frame again for its texture.
+  FString seq_fstr = this->vol_sequence_path.FilePath;
+  char seq_char_array[2048];
+  seq_char_array[0] = '\0';
+  strncat( seq_char_array, TCHAR_TO_ANSI( *seq_fstr ), 2047 );
+
+  vol_geom_frame_data_t frame_data = { 0 };
+  {
+    SCOPE_CYCLE_COUNTER( STAT_VologramGeometryRead );
+    if ( !vol_geom_read_frame( seq_char_array, &this->vol_geom_info, frame_idx, &frame_data ) ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR loading VOL texture frame %i from sequence" ), frame_idx );
       return;
     }
   }
-#if ENGINE_MAJOR_VERSION == 4
-  void* textures_data_ptr = texture_ptr->PlatformData->Mips[0].BulkData.Lock( LOCK_READ_WRITE );
-  // NOTE(Anton) 4 here, not n!! or U4 will get a corrupted image (that you'll see in the preview)
-  FMemory::Memcpy( textures_data_ptr, img_ptr, sz );
-  texture_ptr->PlatformData->Mips[0].BulkData.Unlock();
-#else 
-    void* textures_data_ptr = texture_ptr->GetPlatformData()->Mips[0].BulkData.Lock( LOCK_READ_WRITE );
-  // NOTE(Anton) 4 here, not n!! or U4 will get a corrupted image (that you'll see in the preview)
-  FMemory::Memcpy( textures_data_ptr, img_ptr, sz );
-  texture_ptr->GetPlatformData()->Mips[0].BulkData.Unlock();
-#endif
+  upload_embedded_texture( frame_idx, frame_data );
+}
 
-  texture_ptr->UpdateResource();
+void AVologramActor::upload_embedded_texture( int frame_idx, const vol_geom_frame_data_t& frame_data ) {
+  const FPixelFormatInfo& format_info = GPixelFormats[this->embedded_pixel_format];
+  int w                               = this->vol_geom_info.hdr.texture_width;
+  int h                               = this->vol_geom_info.hdr.texture_height;
+  // Only the first mip is used. Any smaller mips stored after it are ignored.
+  int64 sz = (int64)FMath::DivideAndRoundUp( w, format_info.BlockSizeX ) * FMath::DivideAndRoundUp( h, format_info.BlockSizeY ) * format_info.BlockBytes;
+  if ( w <= 0 || h <= 0 || frame_data.texture_sz < sz ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: frame %i has %i bytes of texture data, but a %ix%i texture needs %lld" ), frame_idx, frame_data.texture_sz, w, h,
+      sz );
+    return;
+  }
 
-  free( img_ptr );
+  if ( !_ensure_texture( texture_ptr, w, h, this->embedded_pixel_format, _is_srgb_pixel_format( this->embedded_pixel_format ) ) ) { return; }
+  _copy_to_texture( texture_ptr, &frame_data.block_data_ptr[frame_data.texture_offset], (size_t)sz );
+  bind_texture_to_material();
+  this->video_frame_loaded = frame_idx;
+}
 
+void AVologramActor::bind_texture_to_material() {
   UMaterialInstanceDynamic* MyDMI = proc_mesh_ptr->CreateAndSetMaterialInstanceDynamic( 0 );
   if ( MyDMI ) {
     // NOTE(Anton) to link to texture - right click on texture object in material blueprint and 'convert to parameter' and add this name
@@ -299,14 +1184,93 @@ void AVologramActor::read_next_av_frame_to_texture() {
   }
 }
 
-// TODO(ANTON) WARNING -- this will crash if changing path strings one at a time as it gets called on every change to the UI
+void AVologramActor::upload_av_planes_to_textures() {
+  const vol_av_video_t& video = this->vol_video_info;
+  if ( VOL_AV_PLANES_NONE == video.plane_layout || !video.planes_ptrs[0] || !video.planes_ptrs[1] ) { return; }
+  int chroma_w = ( video.w + 1 ) / 2;
+  int chroma_h = ( video.h + 1 ) / 2;
+  // Both planes drop the same number of mips, so chroma stays half the size of luma.
+  int first_mip     = choose_video_first_mip( video.w, video.h );
+  int luma_mip_w    = FMath::Max( video.w >> first_mip, 1 ), luma_mip_h = FMath::Max( video.h >> first_mip, 1 );
+  int chroma_mip_w  = FMath::Max( chroma_w >> first_mip, 1 ), chroma_mip_h = FMath::Max( chroma_h >> first_mip, 1 );
+  int luma_n_mips   = this->video_mips ? _mip_count( luma_mip_w, luma_mip_h ) : 1;
+  int chroma_n_mips = this->video_mips ? _mip_count( chroma_mip_w, chroma_mip_h ) : 1;
+  if ( !_ensure_texture( texture_ptr, luma_mip_w, luma_mip_h, PF_G8, false, luma_n_mips ) ||
+       !_ensure_texture( chroma_texture_ptr, chroma_mip_w, chroma_mip_h, PF_R8G8, false, chroma_n_mips ) ) {
+    return;
+  }
+  _fill_texture_mips( texture_ptr, video.planes_ptrs[0], video.plane_strides[0], video.w, video.h, 1, first_mip, this->mip_scratch );
+  if ( VOL_AV_PLANES_NV12 == video.plane_layout ) {
+    _fill_texture_mips( chroma_texture_ptr, video.planes_ptrs[1], video.plane_strides[1], chroma_w, chroma_h, 2, first_mip, this->mip_scratch );
+  } else {
+    _interleave_chroma( video.planes_ptrs[1], video.plane_strides[1], video.planes_ptrs[2], video.plane_strides[2], chroma_w, chroma_h, this->chroma_scratch );
+    _fill_texture_mips( chroma_texture_ptr, this->chroma_scratch.GetData(), chroma_w * 2, chroma_w, chroma_h, 2, first_mip, this->mip_scratch );
+  }
+
+  UMaterialInstanceDynamic* MyDMI = proc_mesh_ptr->CreateAndSetMaterialInstanceDynamic( 0 );
+  if ( MyDMI ) {
+    MyDMI->SetTextureParameterValue( FName( "luma" ), texture_ptr );
+    MyDMI->SetTextureParameterValue( FName( "chroma" ), chroma_texture_ptr );
+    MyDMI->SetScalarParameterValue( FName( "full_range" ), video.full_range ? 1.0f : 0.0f );
+    MyDMI->SetScalarParameterValue( FName( "bt709" ), video.bt709 ? 1.0f : 0.0f );
+  }
+}
+
+void AVologramActor::upload_av_frame_to_texture() {
+  if ( VOL_AV_PLANES_NONE != this->vol_video_info.plane_layout ) {
+    upload_av_planes_to_textures();
+    return;
+  }
+  if ( !this->vol_video_info.pixels_ptr ) { return; }
+
+  int w         = this->vol_video_info.w;
+  int h         = this->vol_video_info.h;
+  int first_mip = choose_video_first_mip( w, h );
+  int mip_w     = FMath::Max( w >> first_mip, 1 ), mip_h = FMath::Max( h >> first_mip, 1 );
+  if ( !_ensure_texture( texture_ptr, mip_w, mip_h, PF_R8G8B8A8, true, this->video_mips ? _mip_count( mip_w, mip_h ) : 1 ) ) { return; }
+  // vol_av converts to RGBA, with alpha already 0xFF, so the frame goes straight into the texture.
+  _fill_texture_mips( texture_ptr, this->vol_video_info.pixels_ptr, w * 4, w, h, 4, first_mip, this->mip_scratch );
+
+  bind_texture_to_material();
+}
+
 void AVologramActor::OnConstruction( const FTransform& Transform ) {
+#if WITH_EDITOR
+  UWorld* world_ptr = GetWorld();
+  if ( world_ptr && !world_ptr->IsGameWorld() ) {
+    FString key = editor_preview_key();
+    if ( key == this->editor_preview_key_shown ) { // Moved, or another setting changed.
+      TSharedPtr<const FVologramEditorCache::FPreview> preview = FVologramEditorCache::find( key );
+      if ( preview.IsValid() ) { set_editor_preview_material( *preview ); }
+      return;
+    }
+    // Paths are often changed one after another, so wait for the changes to settle before loading.
+    this->editor_preview_key_shown = key;
+    this->editor_preview_timer_s   = 0.5f;
+    proc_mesh_ptr->ClearAllMeshSections();
+  }
+#endif
+  wait_for_async_load();
+  stop_video_preroll();
   ClearMeshData();
-  texture_ptr = NULL; // should be garbage collected
+  texture_ptr        = NULL; // should be garbage collected
+  chroma_texture_ptr = NULL;
   // unload any previously loaded metadata
   vol_av_close( &this->vol_video_info );
   vol_geom_free_file_info( &this->vol_geom_info );
-  current_frame = 0;
+  vol_geom_bundle_close( vol_bundle_ptr );
+  vol_bundle_ptr           = NULL;
+  current_frame            = 0;
+  previous_keyframe_loaded = previous_frame_loaded = -1;
+  interp_frame_idx[0]      = interp_frame_idx[1]   = -1;
+  video_frame_loaded       = video_frame_decoded   = -1;
+  frame_work_frame         = -1;
+  mesh_topology.Reset();
+  free_normals_topology();
+  proc_mesh_ptr->set_local_bounds( FBox( ForceInit ) );
+  placeholder_ptr->SetHiddenInGame( true );
+  frame_cache.empty();
+  FVologramMemory::remove( this );
 }
 
 // Called when the game starts or when spawned
@@ -319,14 +1283,157 @@ void AVologramActor::BeginPlay() {
   // DynMaterial->SetScalarParameterValue("MyParameter", myFloatValue);
   proc_mesh_ptr->SetMaterial( 0, DynMaterial );
 
+  // An editor preview may have come along from the level. Its mesh has the header's transform applied, and its textures are shared with the editor.
+  proc_mesh_ptr->ClearAllMeshSections();
+  texture_ptr        = NULL;
+  chroma_texture_ptr = NULL;
   ClearMeshData();
-  update_mesh_with_frame( 0, false );
+  if ( this->async_loading ) {
+    start_async_load();
+    return;
+  }
+  if ( update_mesh_with_frame( 0, false ) ) { OnVologramReady.Broadcast( this ); }
+}
+
+bool AVologramActor::ShouldTickIfViewportsOnly() const {
+#if WITH_EDITOR
+  return this->editor_preview_timer_s >= 0.0f;
+#else
+  return false;
+#endif
+}
+
+#if WITH_EDITOR
+FString AVologramActor::editor_preview_key() const {
+  FString key;
+  if ( this->vologram_asset ) { // Each import of the asset has its own key, as the paths' modification times do.
+    key = this->vologram_asset->GetPathName() + TEXT( "@" ) + this->vologram_asset->import_guid.ToString();
+  } else {
+    key = FVologramEditorCache::path_key( this->vol_header_path.FilePath );
+    key += TEXT( "|" ) + FVologramEditorCache::path_key( this->vol_sequence_path.FilePath );
+    key += TEXT( "|" ) + FVologramEditorCache::path_key( this->vol_mp4_path.FilePath );
+  }
+  return key + FString::Printf( TEXT( "|%i%i" ), (int)this->use_embedded_textures, (int)( this->gpu_colour_conversion && this->yuv_material ) );
+}
+
+void AVologramActor::update_editor_preview( float delta_s ) {
+  if ( this->editor_preview_timer_s < 0.0f ) { return; }
+  this->editor_preview_timer_s -= delta_s;
+  if ( this->editor_preview_timer_s >= 0.0f ) { return; }
+
+  if ( !this->vologram_asset && this->vol_header_path.FilePath.IsEmpty() ) { return; }
+  TSharedPtr<const FVologramEditorCache::FPreview> preview = FVologramEditorCache::find( this->editor_preview_key_shown );
+  if ( !preview.IsValid() ) {
+    preview = load_editor_preview();
+    if ( !preview.IsValid() ) { return; }
+    FVologramEditorCache::add( this->editor_preview_key_shown, preview.ToSharedRef() );
+  }
+  show_editor_preview( *preview );
+}
+
+TSharedPtr<const FVologramEditorCache::FPreview> AVologramActor::load_editor_preview() {
+  TSharedPtr<FVologramEditorCache::FPreview> preview;
+  vol_geom_frame_data_t frame_data = {};
+  ClearMeshData();
+  if ( load_vologram_meta() && vol_geom_is_keyframe( &this->vol_geom_info, 0 ) && read_frame_mesh_data( 0, true, frame_data ) ) {
+    if ( PF_Unknown != this->embedded_pixel_format ) { upload_embedded_texture( 0, frame_data ); }
+    preview = MakeShared<FVologramEditorCache::FPreview>();
+
+    // The header's transform goes into the mesh, rather than onto the actor as in play, where it would build up every time the preview loads.
+    FTransform transform               = vologram_transform();
+    FVologramFrameCache::FFrame& frame = preview->frame;
+    frame.vertex_colours               = vertex_colours;
+    frame.vertices.SetNumUninitialized( vertices.Num() );
+    for ( int i = 0; i < vertices.Num(); i++ ) { frame.vertices[i] = transform.TransformPosition( vertices[i] ); }
+    frame.normals.SetNumUninitialized( normals.Num() );
+    for ( int i = 0; i < normals.Num(); i++ ) { frame.normals[i] = transform.TransformVectorNoScale( normals[i] ); }
+    frame.tangents = tangents;
+    for ( FProcMeshTangent& tangent : frame.tangents ) { tangent.TangentX = transform.TransformVectorNoScale( tangent.TangentX ); }
+    TSharedRef<FVologramFrameCache::FTopology> topology = MakeShared<FVologramFrameCache::FTopology>();
+    topology->keyframe_idx                               = 0;
+    topology->triangles                                  = triangles;
+    topology->uvs                                        = uvs;
+    frame.topology                                       = topology;
+
+    preview->bounds =
+      this->vol_geom_info.frame_aabbs_ptr ? _vols_aabb_to_box( this->vol_geom_info.sequence_aabb ).TransformBy( transform ) : FBox( frame.vertices );
+
+    preview->texture.Reset( texture_ptr );
+    preview->chroma_texture.Reset( this->video_planes ? chroma_texture_ptr : NULL );
+    preview->video_planes = this->video_planes;
+    preview->full_range   = this->vol_video_info.full_range;
+    preview->bt709        = this->vol_video_info.bt709;
+  }
+  // The preview holds everything shown, so the files, and the actor's own copies, can go.
+  close_vologram();
+  ClearMeshData();
+  texture_ptr        = NULL;
+  chroma_texture_ptr = NULL;
+  return preview;
+}
+
+void AVologramActor::show_editor_preview( const FVologramEditorCache::FPreview& preview ) {
+  const FVologramFrameCache::FFrame& frame = preview.frame;
+  proc_mesh_ptr->CreateMeshSection_LinearColor(
+    0, frame.vertices, frame.topology->triangles, frame.normals, frame.topology->uvs, frame.vertex_colours, frame.tangents, false );
+  proc_mesh_ptr->set_local_bounds( preview.bounds );
+  placeholder_ptr->SetRelativeLocation( preview.bounds.GetCenter() );
+  placeholder_ptr->SetBoxExtent( preview.bounds.GetExtent() );
+  set_editor_preview_material( preview );
+}
+
+void AVologramActor::set_editor_preview_material( const FVologramEditorCache::FPreview& preview ) {
+  UMaterialInterface* base_material_ptr = preview.video_planes ? this->yuv_material : this->Material;
+  if ( !base_material_ptr ) { return; }
+  UMaterialInstanceDynamic* material_ptr = Cast<UMaterialInstanceDynamic>( proc_mesh_ptr->GetMaterial( 0 ) );
+  if ( !material_ptr || material_ptr->Parent != base_material_ptr ) {
+    material_ptr = UMaterialInstanceDynamic::Create( base_material_ptr, this );
+    proc_mesh_ptr->SetMaterial( 0, material_ptr );
+  }
+  if ( preview.video_planes ) {
+    material_ptr->SetTextureParameterValue( FName( "luma" ), preview.texture.Get() );
+    material_ptr->SetTextureParameterValue( FName( "chroma" ), preview.chroma_texture.Get() );
+    material_ptr->SetScalarParameterValue( FName( "full_range" ), preview.full_range ? 1.0f : 0.0f );
+    material_ptr->SetScalarParameterValue( FName( "bt709" ), preview.bt709 ? 1.0f : 0.0f );
+  } else {
+    material_ptr->SetTextureParameterValue( FName( "colour" ), preview.texture.Get() );
+  }
+}
+#endif
+
+void AVologramActor::EndPlay( const EEndPlayReason::Type EndPlayReason ) {
+  wait_for_async_load();
+  stop_video_preroll();
+  free_normals_topology();
+  FVologramMemory::remove( this );
+  Super::EndPlay( EndPlayReason );
 }
 
 // Called every frame
 void AVologramActor::Tick( float DeltaTime ) {
   Super::Tick( DeltaTime );
 
+#if WITH_EDITOR
+  UWorld* world_ptr = GetWorld();
+  if ( world_ptr && !world_ptr->IsGameWorld() ) {
+    update_editor_preview( DeltaTime );
+    return;
+  }
+#endif
+
+  // Playback starts once the first frame is shown.
+  if ( is_async_loading() ) {
+    update_async_load();
+    return;
+  }
+
+  this->frame_work_t = -1.0f;
+  advance_playback( DeltaTime );
+  // The frame is shown after every actor has ticked, within the frame budget shared by all volograms.
+  if ( has_frame_work() ) { request_frame_work(); }
+}
+
+void AVologramActor::advance_playback( float delta_s ) {
   // INVALID  ( but don't want to print an error every tick )
   if ( this->vol_geom_info.hdr.frame_count < 1 ) { return; }
 
@@ -335,44 +1442,203 @@ void AVologramActor::Tick( float DeltaTime ) {
   // update timers to see if we should move to the next frame yet
   bool advance_frame = false;
   const double spf   = 1.0 / fps;
-  this->frame_timer_s += DeltaTime;
+  this->frame_timer_s += delta_s;
   if ( this->frame_timer_s >= spf ) {
     this->frame_timer_s -= spf;
     advance_frame = true;
   }
-  if ( !advance_frame ) { return; }
-
-  // TODO(Anton) add frameskip for really slow playback
+  if ( !advance_frame ) {
+    if ( this->interpolate_frames ) { this->frame_work_t = (float)( this->frame_timer_s * fps ); }
+    return;
+  }
 
-  if ( current_frame < this->vol_geom_info.hdr.frame_count - 1 ) {
-    current_frame++;
-    update_mesh_with_frame( current_frame, false );
-    if ( vol_geom_is_keyframe( &this->vol_geom_info, current_frame ) ) { this->previous_keyframe_loaded = current_frame; }
-    this->previous_frame_loaded = current_frame;
-    read_next_av_frame_to_texture();
-  } else if ( this->loop_vologram ) {
-    current_frame = 0;
+  const int frame_count = this->vol_geom_info.hdr.frame_count;
+  if ( EVologramPlaybackMode::Forward == this->playback_mode ) {
+    this->playback_step = 1;
+  } else if ( EVologramPlaybackMode::Reverse == this->playback_mode ) {
+    this->playback_step = -1;
+  } else if ( this->playback_step != 1 && this->playback_step != -1 ) {
+    this->playback_step = 1;
+  }
 
-    // have to close and re-open the whole video because it doesn't seek back to 0 properly.
-    FString mp4_fstr = this->vol_mp4_path.FilePath;
-    char mp4_char_array[2048];
-    mp4_char_array[0] = '\0';
-    strncat( mp4_char_array, TCHAR_TO_ANSI( *mp4_fstr ), 2047 );
-    if ( !vol_av_close( &this->vol_video_info ) ) {
-      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: closing VOL MP4 file: `%s`." ), *mp4_fstr );
-      return;
-    }
-    if ( !vol_av_open( mp4_char_array, &this->vol_video_info ) ) {
-      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *mp4_fstr );
+  int next_frame = current_frame + this->playback_step;
+  if ( next_frame < 0 || next_frame >= frame_count ) {
+    if ( EVologramPlaybackMode::PingPong == this->playback_mode ) {
+      // Turn around at the last frame. Back at the first frame a round trip is complete, so only turn around again if looping.
+      if ( next_frame < 0 && !this->loop_vologram ) { return; }
+      this->playback_step = -this->playback_step;
+      next_frame          = FMath::Clamp( current_frame + this->playback_step, 0, frame_count - 1 );
+    } else if ( !this->loop_vologram ) {
       return;
+    } else if ( this->playback_step < 0 || this->video_preroll_frames > 0 || PF_Unknown != this->embedded_pixel_format ) {
+      // Wrap around, reading the video by frame index. Preroll has already decoded the start of the video for a forward loop.
+      // Embedded textures are read with their frames, so there's no video to re-open.
+      next_frame = this->playback_step < 0 ? frame_count - 1 : 0;
+    } else {
+      current_frame = 0;
+      stop_video_preroll(); // In case preroll was turned off during play.
+
+      // have to close and re-open the whole video because it doesn't seek back to 0 properly.
+      // The first frame is a keyframe, so this is also where the rendition can change.
+      if ( !open_video_rendition( choose_video_rendition() ) ) { return; }
+      read_next_av_frame_to_texture();
+      this->video_frame_loaded = 0;
+      // just in case the file changed since last loop!
+      this->fps = vol_av_frame_rate( &this->vol_video_info );
+      if ( fps <= 0.0 ) { fps = 30.0; }
+      return; // The frame work shows frame 0's geometry.
     }
-    read_next_av_frame_to_texture();
-    // just in case the file changed since last loop!
-    this->fps = vol_av_frame_rate( &this->vol_video_info );
-    if ( fps <= 0.0 ) { fps = 30.0; }
+  }
 
-    update_mesh_with_frame( current_frame, false );
-    if ( vol_geom_is_keyframe( &this->vol_geom_info, current_frame ) ) { this->previous_keyframe_loaded = current_frame; }
-    this->previous_frame_loaded = current_frame;
+  current_frame = next_frame;
+}
+
+bool AVologramActor::has_frame_work() const {
+  if ( !this->vol_meta_info_loaded || this->vol_geom_info.hdr.frame_count < 1 ) { return false; }
+  bool geometry_pending = this->previous_frame_loaded != this->current_frame && this->frame_work_frame != this->current_frame;
+  // The video texture is retried every tick, as it is left alone while the preroll worker holds the video.
+  return geometry_pending || this->video_frame_loaded != this->current_frame || this->frame_work_t >= 0.0f;
+}
+
+void AVologramActor::request_frame_work() {
+  UWorld* world_ptr                 = GetWorld();
+  UVologramSubsystem* subsystem_ptr = world_ptr ? world_ptr->GetSubsystem<UVologramSubsystem>() : NULL;
+  if ( subsystem_ptr ) {
+    subsystem_ptr->request_frame_work( this );
+    return;
   }
+  begin_frame_work();
+  run_frame_work_job();
+  end_frame_work();
+}
+
+float AVologramActor::frame_work_priority() const {
+  // Volograms bigger on screen, which includes nearer ones, go first. Each tick waited counts as much again, so a vologram that has been put off
+  // soon goes ahead of bigger ones that were just shown.
+  float size_px = FMath::Max( screen_size_px(), 1.0f );
+  return size_px * (float)( 1 + this->frame_work_wait_ticks );
+}
+
+void AVologramActor::begin_frame_work() {
+  double start_s     = FPlatformTime::Seconds();
+  this->frame_read   = FFrameRead();
+  bool show_geometry = this->previous_frame_loaded != this->current_frame && this->frame_work_frame != this->current_frame;
+  // Frames skipped while over budget are never read: the frame shown jumps to current_frame, reading its keyframe first if it is in another group.
+  if ( show_geometry && !start_frame_update( this->current_frame, false, this->frame_read ) ) { this->frame_read = FFrameRead(); }
+  this->frame_work_s = FPlatformTime::Seconds() - start_s;
+}
+
+void AVologramActor::run_frame_work_job() {
+  double start_s = FPlatformTime::Seconds();
+  if ( this->frame_read.frame_idx >= 0 ) {
+    this->frame_read.ok = read_frame_mesh_data( this->frame_read.frame_idx, this->frame_read.is_keyframe, this->frame_read.frame_data );
+  }
+  // With preroll, its worker decodes the video, and may hold it now. Otherwise decode here, leaving only the upload for the game thread.
+  if ( PF_Unknown == this->embedded_pixel_format && this->video_preroll_frames <= 0 && this->video_frame_loaded != this->current_frame ) {
+    FScopeLock lock( &this->video_lock );
+    decode_video_frame();
+  }
+  this->frame_work_s += FPlatformTime::Seconds() - start_s;
+}
+
+void AVologramActor::end_frame_work() {
+  double start_s = FPlatformTime::Seconds();
+  if ( this->frame_read.frame_idx >= 0 ) {
+    if ( this->frame_read.ok ) { show_frame_mesh_data( this->frame_read.frame_idx, this->frame_read.topology_changed, this->frame_read.frame_data ); }
+    this->frame_read = FFrameRead();
+  } else if ( this->frame_work_t >= 0.0f && this->previous_frame_loaded == this->current_frame ) {
+    update_mesh_with_interpolation( this->frame_work_t );
+  }
+  update_video_texture();
+  this->frame_work_frame = this->current_frame;
+  this->frame_work_s += FPlatformTime::Seconds() - start_s;
+
+  // Smoothed, so that one slow frame, e.g. a keyframe, doesn't hold the vologram back for long.
+  this->frame_work_ms         = FMath::Lerp( this->frame_work_ms, (float)( this->frame_work_s * 1000.0 ), 0.25f );
+  this->frame_work_wait_ticks = 0;
+  update_memory_usage();
+}
+
+void AVologramActor::update_memory_usage() {
+  FVologramMemory::FUsage& usage = this->memory_usage;
+  // The preroll worker may be decoding, and reading the bundle's video chunk, so keep what was last reported for those until it lets go.
+  if ( this->video_lock.TryLock() ) {
+    usage.bytes[FVologramMemory::Sequences] = (int64)( this->vol_geom_info.sequence_blob_sz + vol_geom_bundle_memory_used( this->vol_bundle_ptr ) );
+    usage.bytes[FVologramMemory::Video]     = vol_av_memory_used( &this->vol_video_info );
+    this->video_cache_used_bytes            = vol_av_cache_bytes_used( &this->vol_video_info );
+    this->video_lock.Unlock();
+  }
+  usage.bytes[FVologramMemory::FrameBlobs]    = (int64)( vol_geom_memory_used( &this->vol_geom_info ) - this->vol_geom_info.sequence_blob_sz );
+  usage.bytes[FVologramMemory::GeometryCache] = this->frame_cache.bytes_used();
+
+  int64 mesh_bytes = vertices.GetAllocatedSize() + normals.GetAllocatedSize() + uvs.GetAllocatedSize() + vertex_colours.GetAllocatedSize() +
+                     tangents.GetAllocatedSize() + triangles.GetAllocatedSize();
+  for ( int i = 0; i < 2; i++ ) { mesh_bytes += interp_positions[i].GetAllocatedSize() + interp_normals[i].GetAllocatedSize(); }
+  mesh_bytes += blend_positions.GetAllocatedSize() + blend_normals.GetAllocatedSize() + generated_normals.GetAllocatedSize() +
+                generated_tangents.GetAllocatedSize() + tangent_handedness.GetAllocatedSize() + mip_scratch.GetAllocatedSize() +
+                chroma_scratch.GetAllocatedSize();
+  usage.bytes[FVologramMemory::MeshArrays] = mesh_bytes;
+  FVologramMemory::update( this, usage );
+}
+
+int64 AVologramActor::shrink_geometry_cache( int64 bytes ) {
+  int64 used_bytes = this->frame_cache.bytes_used();
+  if ( used_bytes <= 0 ) { return 0; }
+  this->geometry_cache_budget_bytes = FMath::Max( used_bytes - bytes, (int64)0 );
+  this->frame_cache.set_budget( this->geometry_cache_budget_bytes );
+  this->memory_usage.bytes[FVologramMemory::GeometryCache] = this->frame_cache.bytes_used();
+  return used_bytes - this->frame_cache.bytes_used();
+}
+
+int64 AVologramActor::shrink_video_cache( int64 bytes ) {
+  if ( !this->video_lock.TryLock() ) { return 0; }
+  // Least recently used frames go first, so the preroll window around the playhead is kept if it fits. The frame shown stays in the texture.
+  int64 freed_bytes = 0;
+  int64 used_bytes  = vol_av_cache_bytes_used( &this->vol_video_info );
+  if ( used_bytes > 0 ) {
+    this->video_cache_budget_bytes = FMath::Max( FMath::Min( this->video_cache_budget_bytes, used_bytes ) - bytes, (int64)0 );
+    freed_bytes                    = vol_av_resize_cache( &this->vol_video_info, this->video_cache_budget_bytes );
+    this->video_cache_used_bytes   = used_bytes - freed_bytes;
+  }
+  this->video_lock.Unlock();
+  this->memory_usage.bytes[FVologramMemory::Video] -= freed_bytes;
+  return freed_bytes;
+}
+
+int64 AVologramActor::release_decoded_sequence() {
+  // A playing vologram would decode its sequence again on the next frame, hidden or not: frames are still read while it is hidden.
+  if ( !this->vol_bundle_ptr || is_async_loading() || this->playing ) { return 0; }
+  if ( !this->video_lock.TryLock() ) { return 0; }
+  int64 freed_bytes = (int64)vol_geom_bundle_release_decoded( this->vol_bundle_ptr );
+  this->memory_usage.bytes[FVologramMemory::Sequences] -= freed_bytes;
+  this->video_lock.Unlock();
+  return freed_bytes;
+}
+
+int64 AVologramActor::restore_cache_budgets( int64 headroom_bytes ) {
+  int64 added_bytes    = 0;
+  int64 geometry_bytes = (int64)this->geometry_cache_mb * 1024 * 1024;
+  if ( this->geometry_cache_budget_bytes < geometry_bytes ) {
+    added_bytes = FMath::Min( geometry_bytes - this->geometry_cache_budget_bytes, headroom_bytes );
+    this->geometry_cache_budget_bytes += added_bytes;
+    this->frame_cache.set_budget( this->geometry_cache_budget_bytes );
+  }
+  int64 video_bytes = (int64)this->video_cache_mb * 1024 * 1024;
+  if ( this->video_cache_budget_bytes < video_bytes && added_bytes < headroom_bytes && this->video_lock.TryLock() ) {
+    int64 video_added = FMath::Min( video_bytes - this->video_cache_budget_bytes, headroom_bytes - added_bytes );
+    vol_av_resize_cache( &this->vol_video_info, this->video_cache_budget_bytes + video_added );
+    this->video_cache_budget_bytes += video_added;
+    this->video_lock.Unlock();
+    added_bytes += video_added;
+  }
+  return added_bytes;
+}
+
+void AVologramActor::seek_to_frame( int32 frame_idx ) {
+  if ( !this->vol_meta_info_loaded || frame_idx < 0 || frame_idx >= this->vol_geom_info.hdr.frame_count ) { return; }
+
+  this->current_frame = frame_idx;
+  this->frame_timer_s = 0.0;
+  update_mesh_with_frame( frame_idx, false );
+  update_video_texture();
 }
@@ -0,0 +1,164 @@
+/**
+ * Vologram asset, imported into the content browser.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramAsset.h"
+#include "Misc/FileHelper.h"
+#include "VologramFileIO.h"
+#include "vol_geom.h"
+
+UVologramAsset::UVologramAsset() {
+  // Kept out of the package's exports, so loading the asset reads none of the vologram. It is streamed a frame at a time instead.
+  bundle_data.SetBulkDataFlags( BULKDATA_Force_NOT_InlinePayload );
+}
+
+void UVologramAsset::Serialize( FArchive& Ar ) {
+  Super::Serialize( Ar );
+  bundle_data.Serialize( Ar, this );
+}
+
+#if WITH_EDITOR
+
+/** A chunk to write into a bundle. */
+struct FBundleChunkSource {
+  const char* id;
+  const void* data_ptr;
+  int64 sz;
+};
+
+/** Lays out a bundle as `vol_geom_pack bundle` does without compression, so every chunk can be streamed.
+ * @returns                - False if the bundle would be too big for a TArray.
+ */
+static bool _build_bundle( const FBundleChunkSource* sources_ptr, int n_chunks, TArray<uint8>& bundle_bytes ) {
+  int64 table_sz = (int64)sizeof( vol_geom_bundle_hdr_t ) + n_chunks * (int64)sizeof( vol_geom_bundle_chunk_t );
+  int64 total_sz = table_sz;
+  TArray<vol_geom_bundle_chunk_t> chunks;
+  chunks.SetNumZeroed( n_chunks );
+  for ( int c = 0; c < n_chunks; c++ ) {
+    memcpy( chunks[c].id, sources_ptr[c].id, 4 );
+    chunks[c].codec     = VOL_GEOM_BUNDLE_CODEC_STORED;
+    chunks[c].offset    = (uint64)Align( total_sz, (int64)VOL_GEOM_BUNDLE_ALIGNMENT );
+    chunks[c].stored_sz = chunks[c].raw_sz = (uint64)sources_ptr[c].sz;
+    total_sz                               = (int64)( chunks[c].offset + chunks[c].stored_sz );
+  }
+  if ( total_sz > MAX_int32 ) { return false; }
+
+  vol_geom_bundle_hdr_t bundle_hdr = {};
+  memcpy( bundle_hdr.magic, VOL_GEOM_BUNDLE_MAGIC, 4 );
+  bundle_hdr.version     = VOL_GEOM_BUNDLE_VERSION;
+  bundle_hdr.chunk_count = (uint32)n_chunks;
+  bundle_bytes.SetNumZeroed( (int32)total_sz );
+  memcpy( bundle_bytes.GetData(), &bundle_hdr, sizeof( vol_geom_bundle_hdr_t ) );
+  memcpy( &bundle_bytes[sizeof( vol_geom_bundle_hdr_t )], chunks.GetData(), n_chunks * sizeof( vol_geom_bundle_chunk_t ) );
+  for ( int c = 0; c < n_chunks; c++ ) {
+    if ( sources_ptr[c].sz > 0 ) { memcpy( &bundle_bytes[(int32)chunks[c].offset], sources_ptr[c].data_ptr, (size_t)sources_ptr[c].sz ); }
+  }
+  return true;
+}
+
+bool UVologramAsset::import_bundle( const FString& bundle_path ) {
+  TArray<uint8> bundle_bytes;
+  if ( !FFileHelper::LoadFileToArray( bundle_bytes, *bundle_path ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: reading VOL bundle: `%s`." ), *bundle_path );
+    return false;
+  }
+  return set_bundle( bundle_bytes, { bundle_path } );
+}
+
+bool UVologramAsset::import_files( const FString& hdr_path, const FString& seq_path, const FString& video_path ) {
+  // Each frame's bounds are worked out now, once, so the actor can cull frames before they are read.
+  vol_geom_io_t geom_io = FVologramFileIO::geom_io();
+  vol_geom_info_t info  = {};
+  if ( !vol_geom_create_file_info_io( TCHAR_TO_ANSI( *hdr_path ), TCHAR_TO_ANSI( *seq_path ), &info, true, &geom_io ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL from files. %s %s" ), *hdr_path, *seq_path );
+    return false;
+  }
+  int n_frames = info.hdr.frame_count;
+  TArray<float> aabbs; // The sequence's bounds, then each frame's.
+  aabbs.SetNumZeroed( ( n_frames + 1 ) * 6 );
+  float* seq_aabb_ptr = aabbs.GetData();
+  bool ok             = true;
+  for ( int i = 0; ok && i < n_frames; i++ ) {
+    vol_geom_frame_data_t frame_data = {};
+    ok                               = vol_geom_read_frame( "", &info, i, &frame_data );
+    if ( !ok ) { break; }
+    float* frame_aabb_ptr = &aabbs[( i + 1 ) * 6];
+    int n_vertices        = (int)( frame_data.vertices_sz / ( 3 * sizeof( float ) ) );
+    vol_geom_compute_aabb( (const float*)&frame_data.block_data_ptr[frame_data.vertices_offset], n_vertices, frame_aabb_ptr );
+    for ( int c = 0; c < 3; c++ ) {
+      seq_aabb_ptr[c]     = 0 == i || frame_aabb_ptr[c] < seq_aabb_ptr[c] ? frame_aabb_ptr[c] : seq_aabb_ptr[c];
+      seq_aabb_ptr[3 + c] = 0 == i || frame_aabb_ptr[3 + c] > seq_aabb_ptr[3 + c] ? frame_aabb_ptr[3 + c] : seq_aabb_ptr[3 + c];
+    }
+  }
+  vol_geom_free_file_info( &info );
+  if ( !ok ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: reading VOL frames. %s %s" ), *hdr_path, *seq_path );
+    return false;
+  }
+
+  TArray<uint8> hdr_bytes, seq_bytes, video_bytes;
+  TArray<FString> paths = { hdr_path, seq_path };
+  if ( !FFileHelper::LoadFileToArray( hdr_bytes, *hdr_path ) || !FFileHelper::LoadFileToArray( seq_bytes, *seq_path ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL from files. %s %s" ), *hdr_path, *seq_path );
+    return false;
+  }
+  if ( !video_path.IsEmpty() ) {
+    if ( !FFileHelper::LoadFileToArray( video_bytes, *video_path ) ) {
+      UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: loading VOL MP4 file: `%s`." ), *video_path );
+      return false;
+    }
+    paths.Add( video_path );
+  }
+
+  // Same chunk order as `vol_geom_pack bundle`: the bounds go last, after the optional video.
+  FBundleChunkSource sources[4] = {
+    { VOL_GEOM_BUNDLE_CHUNK_HEADER, hdr_bytes.GetData(), hdr_bytes.Num() },
+    { VOL_GEOM_BUNDLE_CHUNK_SEQUENCE, seq_bytes.GetData(), seq_bytes.Num() },
+    { VOL_GEOM_BUNDLE_CHUNK_VIDEO, video_bytes.GetData(), video_bytes.Num() },
+    { VOL_GEOM_BUNDLE_CHUNK_BOUNDS, aabbs.GetData(), (int64)aabbs.Num() * (int64)sizeof( float ) },
+  };
+  if ( video_path.IsEmpty() ) { sources[2] = sources[3]; }
+  TArray<uint8> bundle_bytes;
+  if ( !_build_bundle( sources, video_path.IsEmpty() ? 3 : 4, bundle_bytes ) ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: vologram `%s` is over 2 GB, too big to import." ), *hdr_path );
+    return false;
+  }
+  return set_bundle( bundle_bytes, paths );
+}
+
+bool UVologramAsset::set_bundle( TArray<uint8>& bundle_bytes, const TArray<FString>& paths ) {
+  // Check the bundle opens, the way the actor will open it, before replacing the current one.
+  const vol_geom_memory_file_t files[2] = { { "vologram.volb", bundle_bytes.GetData(), bundle_bytes.Num() }, { NULL, NULL, 0 } };
+  vol_geom_io_t memory_io               = vol_geom_io_memory( files );
+  vol_geom_bundle_t* bundle_ptr         = vol_geom_bundle_open( files[0].path, &memory_io );
+  vol_geom_info_t info                  = {};
+  bool valid                            = bundle_ptr && vol_geom_create_file_info_bundle( bundle_ptr, &info, true );
+  if ( valid ) {
+    Modify();
+    this->frame_count           = info.hdr.frame_count;
+    this->has_video             = NULL != vol_geom_bundle_find_chunk( bundle_ptr, VOL_GEOM_BUNDLE_CHUNK_VIDEO );
+    this->has_embedded_textures = info.hdr.version >= 11 && info.hdr.textured;
+    vol_geom_free_file_info( &info );
+  }
+  vol_geom_bundle_close( bundle_ptr );
+  if ( !valid ) {
+    UE_LOG( LogClass, Warning, TEXT( "[VOL] ERROR: `%s` is not a valid vologram bundle." ), paths.Num() > 0 ? *paths[0] : TEXT( "" ) );
+    return false;
+  }
+
+  this->bundle_data.Lock( LOCK_READ_WRITE );
+  void* dst_ptr = this->bundle_data.Realloc( bundle_bytes.Num() );
+  FMemory::Memcpy( dst_ptr, bundle_bytes.GetData(), bundle_bytes.Num() );
+  this->bundle_data.Unlock();
+  this->imported_bundle = MoveTemp( bundle_bytes );
+  this->source_paths    = paths;
+  this->import_guid     = FGuid::NewGuid();
+  return true;
+}
+
+#endif
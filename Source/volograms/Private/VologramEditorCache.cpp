@@ -0,0 +1,43 @@
+/**
+ * Editor cache of vologram previews.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramEditorCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+
+/** Previews, oldest first. Only a few are kept, so a linear search is fine. */
+static TArray<TPair<FString, TSharedRef<const FVologramEditorCache::FPreview>>>& _previews() {
+  static TArray<TPair<FString, TSharedRef<const FVologramEditorCache::FPreview>>> previews;
+  return previews;
+}
+
+TSharedPtr<const FVologramEditorCache::FPreview> FVologramEditorCache::find( const FString& key ) {
+  for ( const TPair<FString, TSharedRef<const FPreview>>& pair : _previews() ) {
+    if ( pair.Key == key ) { return pair.Value; }
+  }
+  return TSharedPtr<const FPreview>();
+}
+
+void FVologramEditorCache::add( const FString& key, const TSharedRef<const FPreview>& preview ) {
+  auto& previews = _previews();
+  previews.RemoveAll( [&key]( const TPair<FString, TSharedRef<const FPreview>>& pair ) { return pair.Key == key; } );
+  previews.Add( TPair<FString, TSharedRef<const FPreview>>( key, preview ) );
+  if ( previews.Num() > max_previews ) { previews.RemoveAt( 0, previews.Num() - max_previews ); }
+}
+
+FString FVologramEditorCache::path_key( const FString& path ) {
+  if ( path.IsEmpty() || path.Contains( TEXT( "://" ) ) ) { return path; }
+  FString full_path = FPaths::ConvertRelativePathToFull( path );
+  // FDateTime::MinValue() if the file doesn't exist, so creating it later changes the key.
+  return full_path + TEXT( "@" ) + IFileManager::Get().GetTimeStamp( *full_path ).ToString();
+}
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Editor cache of vologram previews.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * In the editor, a VologramActor shows its vologram's first frame. OnConstruction() runs on every property edit and every move of the actor, so the
+ * preview is kept here, ready for the mesh section, rather than read again each time. Previews are keyed by the vologram's resolved paths and file
+ * modification times, so moving the actor, undo, or placing another copy of the same vologram opens no files, while a re-exported file is read again.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture2D.h"
+#include "UObject/StrongObjectPtr.h"
+#include "VologramFrameCache.h"
+
+#if WITH_EDITOR
+
+class FVologramEditorCache {
+  public:
+  struct FPreview {
+    /** First frame, in the mesh's axes, with the header's transform applied, as the actor's own transform is left alone in the editor. */
+    FVologramFrameCache::FFrame frame;
+    /** Bounds of the whole sequence, if the vologram stores them, otherwise of the first frame. In the same space as frame. */
+    FBox bounds = FBox( ForceInit );
+    /** The first video frame or embedded texture, or with video_planes, the luma plane. */
+    TStrongObjectPtr<UTexture2D> texture;
+    /** With video_planes, the chroma plane. */
+    TStrongObjectPtr<UTexture2D> chroma_texture;
+    /** True if the textures are YUV planes for the actor's YUV material, with the video's range and colour matrix. */
+    bool video_planes = false, full_range = false, bt709 = false;
+  };
+
+  /** @return The preview added with key, or NULL. */
+  static TSharedPtr<const FPreview> find( const FString& key );
+
+  /** Adds a preview, evicting the oldest beyond max_previews. */
+  static void add( const FString& key, const TSharedRef<const FPreview>& preview );
+
+  /** @return Part of a preview key for a path: the full path and its modification time for a file, or a URL as it is. */
+  static FString path_key( const FString& path );
+
+  private:
+  /** Enough for every vologram in a typical level. Each holds a frame and a video frame: a few tens of MB. */
+  static const int max_previews = 8;
+};
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * Engine file I/O for the vologram libraries.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramFileIO.h"
+#include "Async/AsyncFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "VologramAsset.h"
+
+/** An open file and its size, which vol_geom asks for more than once. */
+struct FAsyncFile {
+  IAsyncReadFileHandle* handle = NULL;
+  int64 size                   = -1;
+};
+
+static void* _file_open( const char* path, void* user_ptr ) {
+  IPlatformFile& platform_file = FPlatformFileManager::Get().GetPlatformFile();
+  FString path_fstr            = ANSI_TO_TCHAR( path );
+  if ( !platform_file.FileExists( *path_fstr ) ) { return NULL; }
+
+  FAsyncFile* file_ptr = new FAsyncFile();
+  file_ptr->handle     = platform_file.OpenAsyncRead( *path_fstr );
+  if ( file_ptr->handle ) {
+    IAsyncReadRequest* request_ptr = file_ptr->handle->SizeRequest();
+    if ( request_ptr ) {
+      request_ptr->WaitCompletion();
+      file_ptr->size = request_ptr->GetSizeResults();
+      delete request_ptr;
+    }
+  }
+  if ( file_ptr->size < 0 ) {
+    delete file_ptr->handle;
+    delete file_ptr;
+    return NULL;
+  }
+  return file_ptr;
+}
+
+static vol_geom_size_t _file_size( void* file_ptr, void* user_ptr ) { return ( (FAsyncFile*)file_ptr )->size; }
+
+static void* _file_async_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  // Reading into our own memory means the request doesn't allocate, and GetReadResults() returns dst_ptr on success.
+  return ( (FAsyncFile*)file_ptr )->handle->ReadRequest( offset, sz, AIOP_Normal, NULL, (uint8*)dst_ptr );
+}
+
+static bool _file_async_wait( void* request_ptr, void* user_ptr ) {
+  IAsyncReadRequest* read_request_ptr = (IAsyncReadRequest*)request_ptr;
+  read_request_ptr->WaitCompletion();
+  bool ok = NULL != read_request_ptr->GetReadResults();
+  delete read_request_ptr;
+  return ok;
+}
+
+static bool _file_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  if ( 0 == sz ) { return true; }
+  void* request_ptr = _file_async_read_at( file_ptr, offset, sz, dst_ptr, user_ptr );
+  return request_ptr && _file_async_wait( request_ptr, user_ptr );
+}
+
+static void _file_close( void* file_ptr, void* user_ptr ) {
+  // vol_geom waits for every request before closing, as the engine requires before the handle is deleted.
+  delete ( (FAsyncFile*)file_ptr )->handle;
+  delete (FAsyncFile*)file_ptr;
+}
+
+static int _video_read( void* user_ptr, uint8_t* buf_ptr, int buf_sz ) {
+  IFileHandle* handle_ptr = (IFileHandle*)user_ptr;
+  int64 n                 = FMath::Min( (int64)buf_sz, handle_ptr->Size() - handle_ptr->Tell() );
+  if ( n <= 0 ) { return 0; }
+  return handle_ptr->Read( buf_ptr, n ) ? (int)n : -1;
+}
+
+static bool _video_seek( void* user_ptr, int64_t offset ) { return ( (IFileHandle*)user_ptr )->Seek( offset ); }
+
+static int64_t _video_size( void* user_ptr ) { return ( (IFileHandle*)user_ptr )->Size(); }
+
+static void _video_close( void* user_ptr ) { delete (IFileHandle*)user_ptr; }
+
+/** The read position in a bundle's video chunk. */
+struct FBundleVideo {
+  vol_geom_bundle_t* bundle_ptr            = NULL;
+  const vol_geom_bundle_chunk_t* chunk_ptr = NULL;
+  int64 pos                                = 0;
+};
+
+static int _bundle_video_read( void* user_ptr, uint8_t* buf_ptr, int buf_sz ) {
+  FBundleVideo* video_ptr = (FBundleVideo*)user_ptr;
+  int64 n                 = FMath::Min( (int64)buf_sz, (int64)video_ptr->chunk_ptr->raw_sz - video_ptr->pos );
+  if ( n <= 0 ) { return 0; }
+  if ( !vol_geom_bundle_read_chunk_at( video_ptr->bundle_ptr, video_ptr->chunk_ptr, video_ptr->pos, n, buf_ptr ) ) { return -1; }
+  video_ptr->pos += n;
+  return (int)n;
+}
+
+static bool _bundle_video_seek( void* user_ptr, int64_t offset ) {
+  FBundleVideo* video_ptr = (FBundleVideo*)user_ptr;
+  if ( offset < 0 || offset > (int64)video_ptr->chunk_ptr->raw_sz ) { return false; }
+  video_ptr->pos = offset;
+  return true;
+}
+
+static int64_t _bundle_video_size( void* user_ptr ) { return (int64_t)( (FBundleVideo*)user_ptr )->chunk_ptr->raw_sz; }
+
+static void _bundle_video_close( void* user_ptr ) { delete (FBundleVideo*)user_ptr; }
+
+/** A read from an asset's bundle. A bundle still held in memory after import is read at once, with no request. */
+struct FAssetRead {
+  IBulkDataIORequest* request = NULL;
+};
+
+static void* _asset_open( const char* path, void* user_ptr ) { return user_ptr; }
+
+static vol_geom_size_t _asset_size( void* file_ptr, void* user_ptr ) { return ( (const UVologramAsset*)file_ptr )->bundle_data.GetBulkDataSize(); }
+
+static void* _asset_async_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  const UVologramAsset* asset_ptr = (const UVologramAsset*)file_ptr;
+  if ( offset < 0 || sz < 0 || offset + sz > asset_ptr->bundle_data.GetBulkDataSize() ) { return NULL; }
+  FAssetRead* read_ptr = new FAssetRead();
+#if WITH_EDITORONLY_DATA
+  if ( asset_ptr->imported_bundle.Num() > 0 ) {
+    FMemory::Memcpy( dst_ptr, &asset_ptr->imported_bundle.GetData()[offset], sz );
+    return read_ptr;
+  }
+#endif
+  read_ptr->request = asset_ptr->bundle_data.CreateStreamingRequest( offset, sz, AIOP_Normal, NULL, (uint8*)dst_ptr );
+  if ( !read_ptr->request ) {
+    delete read_ptr;
+    return NULL;
+  }
+  return read_ptr;
+}
+
+static bool _asset_async_wait( void* request_ptr, void* user_ptr ) {
+  FAssetRead* read_ptr = (FAssetRead*)request_ptr;
+  bool ok              = true;
+  if ( read_ptr->request ) {
+    read_ptr->request->WaitCompletion();
+    ok = NULL != read_ptr->request->GetReadResults();
+    delete read_ptr->request;
+  }
+  delete read_ptr;
+  return ok;
+}
+
+static bool _asset_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  if ( 0 == sz ) { return true; }
+  void* request_ptr = _asset_async_read_at( file_ptr, offset, sz, dst_ptr, user_ptr );
+  return request_ptr && _asset_async_wait( request_ptr, user_ptr );
+}
+
+static void _asset_close( void* file_ptr, void* user_ptr ) {}
+
+vol_geom_io_t FVologramFileIO::geom_io() {
+  vol_geom_io_t io    = {};
+  io.open_fn          = _file_open;
+  io.size_fn          = _file_size;
+  io.read_at_fn       = _file_read_at;
+  io.async_read_at_fn = _file_async_read_at;
+  io.async_wait_fn    = _file_async_wait;
+  io.close_fn         = _file_close;
+  return io;
+}
+
+bool FVologramFileIO::video_io( const char* path, vol_av_io_t* io_ptr ) {
+  IFileHandle* handle_ptr = FPlatformFileManager::Get().GetPlatformFile().OpenRead( ANSI_TO_TCHAR( path ) );
+  if ( !handle_ptr ) { return false; }
+  *io_ptr          = {};
+  io_ptr->read_fn  = _video_read;
+  io_ptr->seek_fn  = _video_seek;
+  io_ptr->size_fn  = _video_size;
+  io_ptr->close_fn = _video_close;
+  io_ptr->user_ptr = handle_ptr;
+  return true;
+}
+
+bool FVologramFileIO::bundle_video_io( vol_geom_bundle_t* bundle_ptr, vol_av_io_t* io_ptr ) {
+  const vol_geom_bundle_chunk_t* chunk_ptr = vol_geom_bundle_find_chunk( bundle_ptr, VOL_GEOM_BUNDLE_CHUNK_VIDEO );
+  if ( !chunk_ptr ) { return false; }
+  FBundleVideo* video_ptr = new FBundleVideo();
+  video_ptr->bundle_ptr   = bundle_ptr;
+  video_ptr->chunk_ptr    = chunk_ptr;
+  *io_ptr                 = {};
+  io_ptr->read_fn         = _bundle_video_read;
+  io_ptr->seek_fn         = _bundle_video_seek;
+  io_ptr->size_fn         = _bundle_video_size;
+  io_ptr->close_fn        = _bundle_video_close;
+  io_ptr->user_ptr        = video_ptr;
+  return true;
+}
+
+vol_geom_io_t FVologramFileIO::asset_io( const UVologramAsset* asset_ptr ) {
+  vol_geom_io_t io    = {};
+  io.open_fn          = _asset_open;
+  io.size_fn          = _asset_size;
+  io.read_at_fn       = _asset_read_at;
+  io.async_read_at_fn = _asset_async_read_at;
+  io.async_wait_fn    = _asset_async_wait;
+  io.close_fn         = _asset_close;
+  io.user_ptr         = (void*)asset_ptr;
+  return io;
+}
@@ -0,0 +1,49 @@
+/**
+ * Engine file I/O for the vologram libraries.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * Files are read through the engine's platform file layer rather than stdio, so volograms can be packaged inside pak files (loose, non-asset files are
+ * kept in pak files even when IoStore is enabled), and reads are issued as IAsyncReadFileHandle requests that can run while the game thread works.
+ * Video is read with a plain IFileHandle: FFmpeg reads sequentially through its own buffer, and seeks only when the playhead jumps.
+ * A bundle's video is read through the geometry's async handle instead, which is safe because the handle takes requests from any thread, so the
+ * video preroll worker and the game thread can both read from it.
+ * A bundle at an http:// URL is read with vol_geom's own HTTP backend, not these. Its reads take turns on the bundle's one connection,
+ * so it can also be read from any thread, though the video and the geometry then wait for each other's requests.
+ * An imported UVologramAsset is read with bulk data streaming requests, which go through IoStore or the package's bulk data file in cooked games. They
+ * read into our own memory, as the file handle's requests do, and can also be issued from any thread.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "vol_geom.h"
+#include "vol_av.h"
+
+class UVologramAsset;
+
+class FVologramFileIO {
+  public:
+  /** @return A vol_geom I/O backend that reads engine file paths with IAsyncReadFileHandle, including asynchronous reads for vol_geom_prefetch_frame(). */
+  static vol_geom_io_t geom_io();
+
+  /** Opens an engine file path for vol_av_open_io(). The returned callbacks own the file handle, which vol_av_close() releases.
+   * @return False if the file couldn't be opened.
+   */
+  static bool video_io( const char* path, vol_av_io_t* io_ptr );
+
+  /** Reads a bundle's video chunk through the bundle's own file handle, for vol_av_open_io(). The bundle must stay open until vol_av_close().
+   * @return False if the bundle has no video chunk.
+   */
+  static bool bundle_video_io( vol_geom_bundle_t* bundle_ptr, vol_av_io_t* io_ptr );
+
+  /** @return A vol_geom I/O backend that reads an asset's bundle, for vol_geom_bundle_open(), which may be given any path. The asset must stay loaded
+   * until the bundle is closed.
+   */
+  static vol_geom_io_t asset_io( const UVologramAsset* asset_ptr );
+};
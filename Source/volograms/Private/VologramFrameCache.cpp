@@ -0,0 +1,98 @@
+/**
+ * Memory-budgeted cache of engine-ready vologram frames.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramFrameCache.h"
+
+void FVologramFrameCache::set_budget( int64 max_bytes ) {
+  budget_bytes = FMath::Max( max_bytes, (int64)0 );
+  evict_to_fit( budget_bytes );
+}
+
+void FVologramFrameCache::empty() {
+  entries.Empty();
+  topology_refs.Empty();
+  used_bytes = 0;
+}
+
+const FVologramFrameCache::FFrame* FVologramFrameCache::find( int frame_idx ) {
+  FEntry* entry_ptr = entries.Find( frame_idx );
+  if ( !entry_ptr ) { return NULL; }
+  entry_ptr->last_used = ++clock;
+  return &entry_ptr->frame;
+}
+
+TSharedPtr<const FVologramFrameCache::FTopology> FVologramFrameCache::find_topology( const vol_geom_info_t* info_ptr, int frame_idx ) const {
+  // Only a few groups of frames are cached at a time, so a linear search is fine.
+  for ( const TPair<int, FEntry>& pair : entries ) {
+    const TSharedPtr<const FTopology>& topology = pair.Value.frame.topology;
+    if ( topology.IsValid() && vol_geom_frames_share_topology( info_ptr, topology->keyframe_idx, frame_idx ) ) { return topology; }
+  }
+  return TSharedPtr<const FTopology>();
+}
+
+void FVologramFrameCache::add( int frame_idx, FFrame&& frame ) {
+  remove( frame_idx );
+
+  int64 bytes               = frame_bytes( frame );
+  const FTopology* topo_ptr = frame.topology.Get();
+  bool new_topology         = topo_ptr && !topology_refs.Contains( topo_ptr );
+  int64 total_bytes         = bytes + ( new_topology ? topology_bytes( *topo_ptr ) : 0 );
+  if ( total_bytes > budget_bytes ) { return; }
+  evict_to_fit( budget_bytes - total_bytes );
+
+  // The topology may have been evicted just now, along with the last frame using it.
+  if ( topo_ptr && !topology_refs.Contains( topo_ptr ) ) {
+    topology_refs.Add( topo_ptr, 0 );
+    used_bytes += topology_bytes( *topo_ptr );
+  }
+  if ( topo_ptr ) { topology_refs[topo_ptr]++; }
+
+  FEntry& entry   = entries.Add( frame_idx );
+  entry.frame     = MoveTemp( frame );
+  entry.bytes     = bytes;
+  entry.last_used = ++clock;
+  used_bytes += bytes;
+}
+
+int64 FVologramFrameCache::frame_bytes( const FFrame& frame ) {
+  return (int64)frame.vertices.GetAllocatedSize() + frame.normals.GetAllocatedSize() + frame.vertex_colours.GetAllocatedSize() +
+         frame.tangents.GetAllocatedSize();
+}
+
+int64 FVologramFrameCache::topology_bytes( const FTopology& topology ) { return (int64)topology.triangles.GetAllocatedSize() + topology.uvs.GetAllocatedSize(); }
+
+void FVologramFrameCache::remove( int frame_idx ) {
+  FEntry* entry_ptr = entries.Find( frame_idx );
+  if ( !entry_ptr ) { return; }
+
+  const FTopology* topo_ptr = entry_ptr->frame.topology.Get();
+  if ( topo_ptr ) {
+    int& refs = topology_refs[topo_ptr];
+    if ( --refs <= 0 ) {
+      used_bytes -= topology_bytes( *topo_ptr );
+      topology_refs.Remove( topo_ptr );
+    }
+  }
+  used_bytes -= entry_ptr->bytes;
+  entries.Remove( frame_idx );
+}
+
+void FVologramFrameCache::evict_to_fit( int64 max_bytes ) {
+  while ( used_bytes > max_bytes && entries.Num() > 0 ) {
+    int oldest_idx     = -1;
+    uint64 oldest_used = MAX_uint64;
+    for ( const TPair<int, FEntry>& pair : entries ) {
+      if ( pair.Value.last_used < oldest_used ) {
+        oldest_used = pair.Value.last_used;
+        oldest_idx  = pair.Key;
+      }
+    }
+    remove( oldest_idx );
+  }
+}
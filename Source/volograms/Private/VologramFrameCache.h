@@ -0,0 +1,79 @@
+/**
+ * Memory-budgeted cache of engine-ready vologram frames.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * Frames are kept in the form given to UProceduralMeshComponent, so a cached frame is shown without reading or converting anything.
+ * Each tracked frame shares the indices and UVs ("topology") of its keyframe. The topology is stored once, and is pinned by reference counting for as
+ * long as any frame using it is cached, even if the keyframe itself is evicted. Seeking into the middle of a group of tracked frames then doesn't need
+ * the keyframe to be read again.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "vol_geom.h"
+
+class FVologramFrameCache {
+  public:
+  /** Indices and UVs shared by a keyframe and its tracked frames. */
+  struct FTopology {
+    /** Frame the topology was read from. */
+    int keyframe_idx = -1;
+    TArray<int32> triangles;
+    TArray<FVector2D> uvs;
+  };
+
+  struct FFrame {
+    TArray<FVector> vertices, normals;
+    TArray<FLinearColor> vertex_colours;
+    TArray<FProcMeshTangent> tangents;
+    TSharedPtr<const FTopology> topology;
+  };
+
+  /** Sets the memory budget, evicting least recently used frames to fit. 0 disables the cache. */
+  void set_budget( int64 max_bytes );
+
+  /** Removes all frames and topologies. */
+  void empty();
+
+  /** @return The cached frame, or NULL. Marks the frame as most recently used. The pointer is valid until the next call that adds or removes frames. */
+  const FFrame* find( int frame_idx );
+
+  /** @return True if the frame is cached. Doesn't change which frames are least recently used. */
+  bool contains( int frame_idx ) const { return entries.Contains( frame_idx ); }
+
+  /** @return A cached topology that frame_idx can use, or NULL. */
+  TSharedPtr<const FTopology> find_topology( const vol_geom_info_t* info_ptr, int frame_idx ) const;
+
+  /** Adds a frame, as most recently used, evicting least recently used frames to fit in the budget. Does nothing if the frame doesn't fit at all. */
+  void add( int frame_idx, FFrame&& frame );
+
+  /** @return Bytes held by cached frames and the topologies they use. */
+  int64 bytes_used() const { return used_bytes; }
+
+  private:
+  struct FEntry {
+    FFrame frame;
+    int64 bytes      = 0;
+    uint64 last_used = 0;
+  };
+
+  static int64 frame_bytes( const FFrame& frame );
+  static int64 topology_bytes( const FTopology& topology );
+  void remove( int frame_idx );
+  void evict_to_fit( int64 max_bytes );
+
+  TMap<int, FEntry> entries;
+  /** Number of cached frames using each topology. */
+  TMap<const FTopology*, int> topology_refs;
+  int64 budget_bytes = 0;
+  int64 used_bytes   = 0;
+  uint64 clock       = 0;
+};
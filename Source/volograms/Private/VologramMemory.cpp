@@ -0,0 +1,163 @@
+/**
+ * Accounts for the memory held by every vologram, and keeps it within a global budget.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramMemory.h"
+#include "VologramActor.h"
+#include "volograms.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_MEMORY_STAT( TEXT( "Frame Blobs" ), STAT_VologramFrameBlobMemory, STATGROUP_Volograms );
+DECLARE_MEMORY_STAT( TEXT( "Decoded Sequences" ), STAT_VologramSequenceMemory, STATGROUP_Volograms );
+DECLARE_MEMORY_STAT( TEXT( "Mesh Arrays" ), STAT_VologramMeshMemory, STATGROUP_Volograms );
+DECLARE_MEMORY_STAT( TEXT( "Geometry Frame Cache" ), STAT_VologramGeometryCacheMemory, STATGROUP_Volograms );
+DECLARE_MEMORY_STAT( TEXT( "Video" ), STAT_VologramVideoMemory, STATGROUP_Volograms );
+
+static TAutoConsoleVariable<int32> CVarVologramMemoryBudgetMB( TEXT( "vol.MemoryBudgetMB" ), 0,
+  TEXT( "Megabytes that all volograms together may hold, evicting frame caches and decoded sequences to fit. 0 for no budget." ) );
+
+static FAutoConsoleCommandWithOutputDevice VologramMemoryCommand( TEXT( "vol.Memory" ), TEXT( "Lists the memory held by each vologram, by category." ),
+  FConsoleCommandWithOutputDeviceDelegate::CreateStatic( &FVologramMemory::dump ) );
+
+static const TCHAR* _category_names[FVologramMemory::NumCategories] = {
+  TEXT( "Frame blobs" ), TEXT( "Sequences" ), TEXT( "Mesh arrays" ), TEXT( "Geometry cache" ), TEXT( "Video" ) };
+
+struct FUsageEntry {
+  TWeakObjectPtr<AVologramActor> actor;
+  FVologramMemory::FUsage usage;
+};
+
+/** Usage reported by each actor. Only a few volograms are open at once, so a linear search is fine. */
+static TArray<FUsageEntry>& _entries() {
+  static TArray<FUsageEntry> entries;
+  return entries;
+}
+
+static double _mb( int64 bytes ) { return (double)bytes / ( 1024.0 * 1024.0 ); }
+
+static void _update_stats() {
+  FVologramMemory::FUsage totals = FVologramMemory::totals();
+  SET_MEMORY_STAT( STAT_VologramFrameBlobMemory, totals.bytes[FVologramMemory::FrameBlobs] );
+  SET_MEMORY_STAT( STAT_VologramSequenceMemory, totals.bytes[FVologramMemory::Sequences] );
+  SET_MEMORY_STAT( STAT_VologramMeshMemory, totals.bytes[FVologramMemory::MeshArrays] );
+  SET_MEMORY_STAT( STAT_VologramGeometryCacheMemory, totals.bytes[FVologramMemory::GeometryCache] );
+  SET_MEMORY_STAT( STAT_VologramVideoMemory, totals.bytes[FVologramMemory::Video] );
+}
+
+/** Frees up to excess_bytes of a category, from the actors holding most of it first.
+ * @param shrink_fn        - Frees about the bytes asked for from an actor, and returns the bytes it actually freed.
+ * @returns                - The bytes freed.
+ */
+template <typename FShrinkFn> static int64 _evict( FVologramMemory::ECategory category, int64 excess_bytes, FShrinkFn shrink_fn ) {
+  TArray<FUsageEntry>& entries = _entries();
+  entries.Sort( [category]( const FUsageEntry& a, const FUsageEntry& b ) { return a.usage.bytes[category] > b.usage.bytes[category]; } );
+  int64 freed_bytes = 0;
+  for ( FUsageEntry& entry : entries ) {
+    if ( freed_bytes >= excess_bytes || entry.usage.bytes[category] <= 0 ) { break; }
+    int64 actor_freed = shrink_fn( entry.actor.Get(), FMath::Min( excess_bytes - freed_bytes, entry.usage.bytes[category] ) );
+    if ( actor_freed <= 0 ) { continue; }
+    entry.usage.bytes[category] -= actor_freed;
+    freed_bytes += actor_freed;
+  }
+  return freed_bytes;
+}
+
+int64 FVologramMemory::FUsage::total() const {
+  int64 sum = 0;
+  for ( int c = 0; c < NumCategories; c++ ) { sum += bytes[c]; }
+  return sum;
+}
+
+void FVologramMemory::update( AVologramActor* actor_ptr, const FUsage& usage ) {
+  TArray<FUsageEntry>& entries = _entries();
+  FUsageEntry* entry_ptr       = entries.FindByPredicate( [actor_ptr]( const FUsageEntry& entry ) { return entry.actor.Get() == actor_ptr; } );
+  if ( !entry_ptr ) {
+    entry_ptr        = &entries.AddDefaulted_GetRef();
+    entry_ptr->actor = actor_ptr;
+  }
+  entry_ptr->usage = usage;
+  _update_stats();
+}
+
+void FVologramMemory::remove( AVologramActor* actor_ptr ) {
+  int n_removed = _entries().RemoveAll( [actor_ptr]( const FUsageEntry& entry ) { return entry.actor.Get() == actor_ptr; } );
+  if ( n_removed > 0 ) { _update_stats(); }
+}
+
+int64 FVologramMemory::budget_bytes() { return (int64)FMath::Max( CVarVologramMemoryBudgetMB.GetValueOnGameThread(), 0 ) * 1024 * 1024; }
+
+bool FVologramMemory::is_over_budget() {
+  int64 budget = budget_bytes();
+  return budget > 0 && totals().total() > budget;
+}
+
+FVologramMemory::FUsage FVologramMemory::totals() {
+  FUsage totals;
+  for ( const FUsageEntry& entry : _entries() ) {
+    if ( !entry.actor.IsValid() ) { continue; }
+    for ( int c = 0; c < NumCategories; c++ ) { totals.bytes[c] += entry.usage.bytes[c]; }
+  }
+  return totals;
+}
+
+void FVologramMemory::enforce_budget() {
+  TArray<FUsageEntry>& entries = _entries();
+  entries.RemoveAll( []( const FUsageEntry& entry ) { return !entry.actor.IsValid(); } );
+  int64 budget = budget_bytes();
+  int64 total  = totals().total();
+
+  if ( budget > 0 && total > budget ) {
+    // Cheapest to lose first: cached mesh frames are read again, video frames are decoded again, and a decoded sequence is decoded again whole.
+    int64 excess = total - budget;
+    excess -= _evict( GeometryCache, excess, []( AVologramActor* actor_ptr, int64 bytes ) { return actor_ptr->shrink_geometry_cache( bytes ); } );
+    if ( excess > 0 ) {
+      excess -= _evict( Video, excess, []( AVologramActor* actor_ptr, int64 bytes ) { return actor_ptr->shrink_video_cache( bytes ); } );
+    }
+    if ( excess > 0 ) {
+      excess -= _evict( Sequences, excess, []( AVologramActor* actor_ptr, int64 ) { return actor_ptr->release_decoded_sequence(); } );
+    }
+    _update_stats();
+    return;
+  }
+
+  // Give cache budgets back, counting each cache as full, so their frames don't fill past the budget between calls.
+  int64 headroom = budget > 0 ? budget - total : MAX_int64;
+  for ( const FUsageEntry& entry : entries ) {
+    if ( budget <= 0 ) { break; }
+    headroom -= FMath::Max( entry.actor->geometry_cache_budget_bytes - entry.usage.bytes[GeometryCache], (int64)0 );
+    headroom -= FMath::Max( entry.actor->video_cache_budget_bytes - entry.actor->video_cache_used_bytes, (int64)0 );
+  }
+  for ( const FUsageEntry& entry : entries ) {
+    if ( headroom <= 0 ) { break; }
+    headroom -= entry.actor->restore_cache_budgets( headroom );
+  }
+}
+
+void FVologramMemory::dump( FOutputDevice& output ) {
+  FString header = FString::Printf( TEXT( "%-40s" ), TEXT( "Vologram (MB)" ) );
+  for ( int c = 0; c < NumCategories; c++ ) { header += FString::Printf( TEXT( " %16s" ), _category_names[c] ); }
+  output.Logf( TEXT( "%s %16s" ), *header, TEXT( "Total" ) );
+
+  for ( const FUsageEntry& entry : _entries() ) {
+    if ( !entry.actor.IsValid() ) { continue; }
+    FString line = FString::Printf( TEXT( "%-40s" ), *entry.actor->GetName() );
+    for ( int c = 0; c < NumCategories; c++ ) { line += FString::Printf( TEXT( " %16.1f" ), _mb( entry.usage.bytes[c] ) ); }
+    output.Logf( TEXT( "%s %16.1f" ), *line, _mb( entry.usage.total() ) );
+  }
+
+  FUsage totals = FVologramMemory::totals();
+  FString line  = FString::Printf( TEXT( "%-40s" ), TEXT( "All volograms" ) );
+  for ( int c = 0; c < NumCategories; c++ ) { line += FString::Printf( TEXT( " %16.1f" ), _mb( totals.bytes[c] ) ); }
+  output.Logf( TEXT( "%s %16.1f" ), *line, _mb( totals.total() ) );
+  int64 budget = budget_bytes();
+  if ( budget > 0 ) {
+    output.Logf( TEXT( "Budget (vol.MemoryBudgetMB): %.1f MB, %.1f MB free." ), _mb( budget ), _mb( budget - totals.total() ) );
+  } else {
+    output.Logf( TEXT( "No budget. Set vol.MemoryBudgetMB to keep volograms within one." ) );
+  }
+}
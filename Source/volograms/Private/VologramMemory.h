@@ -0,0 +1,68 @@
+/**
+ * Accounts for the memory held by every vologram, and keeps it within a global budget.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * vol_geom and vol_av allocate with malloc(), and FFmpeg with its own allocator, so the engine's memory trackers only see the mesh arrays. Each
+ * AVologramActor instead reports what it holds, by category, asking the libraries for theirs, and the totals are shown in STATGROUP_Volograms and by
+ * the `vol.Memory` console command. With `vol.MemoryBudgetMB` set, UVologramSubsystem calls enforce_budget() once the tick's frame work is done, which
+ * lowers the budgets of the geometry frame caches, then of the video frame caches, largest first, then frees the decoded sequences of paused or hidden
+ * volograms. Frame blobs and mesh arrays are needed to show a frame, so they are counted but never evicted. Cache budgets are given back as memory is
+ * freed, e.g. when a vologram is closed.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AVologramActor;
+
+class FVologramMemory {
+  public:
+  enum ECategory {
+    /** vol_geom's frame blobs, frame directory, streaming read buffers, and decoder state. */
+    FrameBlobs,
+    /** Sequences held whole in memory: decoded compressed bundle chunks, including video, or the sequence file if not streaming. */
+    Sequences,
+    /** Vertices, normals, UVs, indices, and tangents of the frame shown, interpolation buffers, and texture upload scratch. */
+    MeshArrays,
+    /** Frames in each actor's FVologramFrameCache. */
+    GeometryCache,
+    /** vol_av's decoded frame, its conversion, and the decoded video frame cache. */
+    Video,
+    NumCategories
+  };
+
+  struct FUsage {
+    int64 bytes[NumCategories] = {};
+    int64 total() const;
+  };
+
+  /** Records what an actor holds now, replacing what it reported before. */
+  static void update( AVologramActor* actor_ptr, const FUsage& usage );
+
+  /** Forgets an actor, e.g. when its vologram is closed or it leaves play. */
+  static void remove( AVologramActor* actor_ptr );
+
+  /** @return The budget set by `vol.MemoryBudgetMB` in bytes, or 0 if there is none. */
+  static int64 budget_bytes();
+
+  /** @return True if the volograms together hold more than the budget. */
+  static bool is_over_budget();
+
+  /** Evicts caches and decoded sequences until the volograms fit in the budget, or gives cache budgets back if there is room. Call on the game thread
+   * when no frame work is running.
+   */
+  static void enforce_budget();
+
+  /** Writes each vologram's memory, by category, then the totals and the budget. */
+  static void dump( FOutputDevice& output );
+
+  /** @return The memory held by every vologram. */
+  static FUsage totals();
+};
@@ -0,0 +1,22 @@
+/**
+ * Procedural mesh component for volograms, with bounds known before any frame is loaded.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramMeshComponent.h"
+
+void UVologramMeshComponent::set_local_bounds( const FBox& local_box ) {
+  if ( local_box.IsValid == local_bounds.IsValid && ( !local_box.IsValid || local_box == local_bounds ) ) { return; }
+  local_bounds = local_box;
+  UpdateBounds();
+  MarkRenderTransformDirty();
+}
+
+FBoxSphereBounds UVologramMeshComponent::CalcBounds( const FTransform& LocalToWorld ) const {
+  if ( !local_bounds.IsValid ) { return Super::CalcBounds( LocalToWorld ); }
+  return FBoxSphereBounds( local_bounds ).TransformBy( LocalToWorld );
+}
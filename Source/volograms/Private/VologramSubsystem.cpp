@@ -0,0 +1,81 @@
+/**
+ * Schedules the frame work of every vologram in a world.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramSubsystem.h"
+#include "VologramActor.h"
+#include "VologramMemory.h"
+#include "volograms.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT( TEXT( "Frame Work" ), STAT_VologramFrameWork, STATGROUP_Volograms );
+DECLARE_DWORD_COUNTER_STAT( TEXT( "Frames Put Off" ), STAT_VologramFramesDeferred, STATGROUP_Volograms );
+
+static TAutoConsoleVariable<float> CVarVologramFrameBudgetMs( TEXT( "vol.FrameBudgetMs" ), 4.0f,
+  TEXT( "Milliseconds per tick that volograms may spend reading, decoding, and uploading frames, over all threads. 0 for no budget." ) );
+static TAutoConsoleVariable<int32> CVarVologramMaxFrameSkip( TEXT( "vol.MaxFrameSkip" ), 3,
+  TEXT( "Most ticks in a row a vologram's frame may be put off to keep within vol.FrameBudgetMs, before it is shown anyway." ) );
+
+void UVologramSubsystem::request_frame_work( AVologramActor* actor_ptr ) { this->requests.AddUnique( actor_ptr ); }
+
+void UVologramSubsystem::Tick( float DeltaTime ) {
+  SCOPE_CYCLE_COUNTER( STAT_VologramFrameWork );
+
+  struct FRequest {
+    AVologramActor* actor_ptr;
+    float priority;
+  };
+  TArray<FRequest> queue;
+  for ( const TWeakObjectPtr<AVologramActor>& weak_ptr : this->requests ) {
+    AVologramActor* actor_ptr = weak_ptr.Get();
+    if ( !actor_ptr || !actor_ptr->HasActorBegunPlay() || !actor_ptr->has_frame_work() ) { continue; }
+    queue.Add( { actor_ptr, actor_ptr->frame_work_priority() } );
+  }
+  this->requests.Reset();
+  queue.Sort( []( const FRequest& a, const FRequest& b ) { return a.priority > b.priority; } );
+
+  // Take volograms in order while their expected cost fits. Overdue ones are taken anyway, as is the first, so playback always moves on.
+  float budget_ms   = CVarVologramFrameBudgetMs.GetValueOnGameThread();
+  int max_frameskip = CVarVologramMaxFrameSkip.GetValueOnGameThread();
+  float planned_ms  = 0.0f;
+  TArray<AVologramActor*> actors;
+  this->deferred_count = 0;
+  for ( const FRequest& request : queue ) {
+    AVologramActor* actor_ptr = request.actor_ptr;
+    bool fits                 = budget_ms <= 0.0f || actors.Num() == 0 || planned_ms + actor_ptr->frame_work_ms <= budget_ms;
+    if ( fits || actor_ptr->frame_work_wait_ticks >= max_frameskip ) {
+      actors.Add( actor_ptr );
+      planned_ms += actor_ptr->frame_work_ms;
+    } else {
+      actor_ptr->frame_work_wait_ticks++;
+      this->deferred_count++;
+    }
+  }
+  INC_DWORD_STAT_BY( STAT_VologramFramesDeferred, this->deferred_count );
+
+  for ( AVologramActor* actor_ptr : actors ) { actor_ptr->begin_frame_work(); }
+  // Reading and decoding are most of the work. Each job only touches its own actor, so they run side by side.
+  ParallelFor( actors.Num(), [&actors]( int32 i ) { actors[i]->run_frame_work_job(); } );
+  this->frame_work_ms = 0.0f;
+  for ( AVologramActor* actor_ptr : actors ) {
+    actor_ptr->end_frame_work();
+    this->frame_work_ms += (float)( actor_ptr->frame_work_s * 1000.0 );
+  }
+  // Caches have grown by the frames just shown. No frame work is running now, so they can be evicted from.
+  FVologramMemory::enforce_budget();
+}
+
+bool UVologramSubsystem::IsTickable() const { return this->requests.Num() > 0 || FVologramMemory::is_over_budget(); }
+
+TStatId UVologramSubsystem::GetStatId() const { RETURN_QUICK_DECLARE_CYCLE_STAT( UVologramSubsystem, STATGROUP_Tickables ); }
+
+ETickableTickType UVologramSubsystem::GetTickableTickType() const {
+  // The class default object is constructed as a tickable too, but mustn't tick.
+  return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
@@ -1,7 +1,7 @@
 /** @file vol_av.c
  * Volograms SDK Audio-Video Decoding API
  *
- * Version:   0.9.0 \n
+ * Version:   0.18.0 \n
  * Authors:   Anton Gerdelan <anton@volograms.com> \n
  * Copyright: 2021, Volograms (http://volograms.com/) \n
  * Language:  C99 \n
@@ -17,8 +17,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined( __AVX2__ )
+#define VOL_AV_AVX2
+#include <immintrin.h>
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define VOL_AV_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+#define VOL_AV_NEON
+#include <arm_neon.h>
+#endif
 
 #define VOL_AV_LOG_STR_MAX_LEN 512 // Careful - this is stored on the stack to be thread and memory-safe so don't make it too large.
+/// Default memory budget for decoded frames kept by vol_av_seek_frame(). 256MB holds about 20 frames of 2048x2048 RGB, or 85 frames of 1024x1024.
+#define VOL_AV_DEFAULT_CACHE_BYTES ( 256 * 1024 * 1024 )
+/// Safety limit on frames decoded forward from a keyframe in one seek, in case timestamps never reach the target.
+#define VOL_AV_MAX_SEEK_DECODE_FRAMES 4096
+/// Microseconds to wait for a network read or write before giving up, when playing from a URL.
+#define VOL_AV_NETWORK_TIMEOUT_US "10000000"
+/// Size of the buffer FFmpeg reads through when vol_av_io_t.buffer_sz is 0. FFmpeg's own default is 32kB.
+#define VOL_AV_DEFAULT_IO_BUFFER_SZ ( 64 * 1024 )
+/// Rows of an image converted to RGBA, or downsampled, by each job. Enough that job overhead is small, and a 4K frame is still spread over 34 jobs.
+#define VOL_AV_CONVERT_JOB_ROWS 64
+/// Largest number of jobs used to convert one image. Taller images get more rows per job.
+#define VOL_AV_MAX_CONVERT_JOBS 64
 
 /** Internal ffmepg-specific context variables. This struct lives inside the vol_av_video_t interface struct. */
 struct vol_av_internal_t {
@@ -27,6 +50,14 @@ struct vol_av_internal_t {
   AVCodec* codec_ptr;            /** Video codec - decoder found for file format. http://ffmpeg.org/doxygen/trunk/structAVCodec.html */
   AVCodecContext* codec_ctx_ptr; /** Video codec context. https://ffmpeg.org/doxygen/trunk/structAVCodecContext.html */
   int video_stream_idx;          /** The valid video stream index we found by looping over the stream ptrs. */
+  bool network_initialised;      /** True if opened from a URL, so avformat_network_deinit() is needed on close. */
+
+  // Custom I/O. Only used when opened with vol_av_open_io() or vol_av_open_memory().
+  AVIOContext* avio_ctx_ptr; /** Reads through `io` callbacks. Owned by us, not by `fmt_ctx_ptr`. */
+  vol_av_io_t io;            /** Copy of the application's callbacks. */
+  int64_t io_pos;            /** Position of the last read or seek, for relative seeks. */
+  const uint8_t* memory_ptr; /** File contents, for vol_av_open_memory(). */
+  int64_t memory_sz, memory_pos;
 
   // Current Decoded Frame Output
   AVFrame* output_frame_ptr;     /** Decoded frame in native format. // https://ffmpeg.org/doxygen/trunk/structAVFrame.html */
@@ -37,6 +68,32 @@ struct vol_av_internal_t {
   struct SwsContext* sws_conv_ctx_ptr; /** Scaling/image conversion context. */
 
   int w, h; /** Dimensions of `output_frame_rgb_ptr`. */
+
+  // YUV Plane Output. Only used with VOL_AV_OUTPUT_YUV420_PLANES.
+  vol_av_output_format_t output_format;
+  AVFrame* planes_frame_ptr;             /** Reference to the decoded frame, so its planes outlive the next call to avcodec_receive_frame(). */
+  AVFrame* planes_conv_frame_ptr;        /** Conversion of `output_frame_ptr` to YUV420P, if the decoder outputs something other than 4:2:0. */
+  struct SwsContext* sws_planes_ctx_ptr; /** Converts to `planes_conv_frame_ptr`. */
+  const uint8_t* planes_ptrs[3];         /** Planes of the frame last decoded. */
+  int plane_strides[3];
+  vol_av_plane_layout_t plane_layout;
+  bool full_range, bt709;
+
+  // RGBA Output. Only used with VOL_AV_OUTPUT_RGBA32.
+  uint8_t* rgba_ptr;                   /** Tightly-packed RGBA image of the frame last decoded. */
+  struct SwsContext* sws_rgba_ctx_ptr; /** Converts to `rgba_ptr` from formats other than 4:2:0. */
+
+  int64_t decoded_frame_idx; /** Index of the frame last decoded into `output_frame_rgb_ptr`, or -1 if none. Found from the frame's timestamp. */
+  bool key_frame;            /** True if the frame last decoded is a keyframe. */
+
+  // Decoded Frame Cache. Filled while decoding forward through a GOP in vol_av_seek_frame(), so reverse playback decodes each GOP once.
+  int64_t cache_budget_bytes;  /** Memory budget for the cache. */
+  int cache_capacity;          /** Number of slots, from the budget and the frame size. 0 until the first frame is cached. */
+  uint8_t** cache_pixels_ptrs; /** Image of each slot: RGB laid out as in `output_frame_rgb_ptr`, or tightly-packed planes. */
+  int64_t* cache_frame_idxs;   /** Frame index in each slot, or -1 if the slot is empty. */
+  bool* cache_key_frames;      /** True for each slot holding a keyframe. */
+  uint64_t* cache_last_used;   /** Value of `cache_clock` when each slot was last stored or found. The least recently used slot is replaced first. */
+  uint64_t cache_clock;
 };
 
 static void _default_logger( vol_av_log_type_t log_type, const char* message_str ) {
@@ -46,6 +103,12 @@ static void _default_logger( vol_av_log_type_t log_type, const char* message_str
 
 static void ( *_logger_ptr )( vol_av_log_type_t log_type, const char* message_str ) = _default_logger;
 
+static void _default_parallel_for( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr ) {
+  for ( int i = 0; i < job_count; i++ ) { job_fn( job_ctx_ptr, i ); }
+}
+
+static vol_av_parallel_for_fn_t _parallel_for_ptr = _default_parallel_for;
+
 // This function is used in this file as a printf-style logger. It converts that format to a simple string and passes it to _logger_ptr.
 static void _vol_loggerf( vol_av_log_type_t log_type, const char* message_str, ... ) {
   if ( !_logger_ptr ) { return; }
@@ -58,24 +121,559 @@ static void _vol_loggerf( vol_av_log_type_t log_type, const char* message_str, .
   _logger_ptr( log_type, log_str );
 }
 
-//
-//
-bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
-  if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+/******************************************************************************
+  YUV TO RGBA CONVERSION
+******************************************************************************/
 
-  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
+/** Fixed-point YUV to RGB coefficients, with 6 fractional bits so that every term fits in 16-bit SIMD lanes.
+ * Y' = ( ( Y * 257 * y_mul ) >> 16 ) + y_bias, then R = Y' + rv * V, G = Y' - gu * U - gv * V, and B = Y' + bu * U, with U and V centred on 0,
+ * and each channel is R >> 6 clamped to 0-255. y_bias folds in the black level and rounding. Results are within a level of floating point.
+ */
+typedef struct vol_av_yuv_coeffs_t {
+  uint16_t y_mul;
+  int16_t y_bias, rv, gu, gv, bu;
+} vol_av_yuv_coeffs_t;
+
+/** Y scale, black level, and chroma scale of limited range video, which stretches Y from 16-235 to 0-255, and U and V from 16-240. */
+#define VOL_AV_LIMITED_RANGE 255.0 / 219.0, 16.0, 255.0 / 224.0
+/** Y scale, black level, and chroma scale of full range video. */
+#define VOL_AV_FULL_RANGE 1.0, 0.0, 1.0
+/** Converts the coefficients of a YUV to RGB matrix, for a range, to fixed point. */
+#define VOL_AV_YUV_COEFFS( range, matrix ) VOL_AV_YUV_COEFFS_EXPANDED( range, matrix )
+#define VOL_AV_YUV_COEFFS_EXPANDED( y_scale, y_black, c_scale, r_v, g_u, g_v, b_u )                                                                            \
+  {                                                                                                                                                            \
+    (uint16_t)( ( y_scale ) * 64.0 * 65536.0 / 257.0 + 0.5 ), (int16_t)( 32 - (int)( ( y_black ) * ( y_scale ) * 64.0 + 0.5 ) ),                               \
+      (int16_t)( ( r_v ) * ( c_scale ) * 64.0 + 0.5 ), (int16_t)( ( g_u ) * ( c_scale ) * 64.0 + 0.5 ), (int16_t)( ( g_v ) * ( c_scale ) * 64.0 + 0.5 ),       \
+      (int16_t)( ( b_u ) * ( c_scale ) * 64.0 + 0.5 )                                                                                                          \
+  }
+#define VOL_AV_BT601 1.402, 0.344136, 0.714136, 1.772
+#define VOL_AV_BT709 1.5748, 0.187324, 0.468124, 1.8556
+
+/** Indexed by [bt709][full_range]. */
+static const vol_av_yuv_coeffs_t _yuv_coeffs[2][2] = {
+  { VOL_AV_YUV_COEFFS( VOL_AV_LIMITED_RANGE, VOL_AV_BT601 ), VOL_AV_YUV_COEFFS( VOL_AV_FULL_RANGE, VOL_AV_BT601 ) },
+  { VOL_AV_YUV_COEFFS( VOL_AV_LIMITED_RANGE, VOL_AV_BT709 ), VOL_AV_YUV_COEFFS( VOL_AV_FULL_RANGE, VOL_AV_BT709 ) },
+};
+
+static uint8_t _clamp_fix6( int x ) { return x <= 0 ? 0 : x >= ( 255 << 6 ) ? 255 : (uint8_t)( x >> 6 ); }
+
+#if defined( VOL_AV_SSE2 )
+/** Interleaves 16 pixels of R, G, and B with opaque alpha, and stores them as RGBA. */
+static void _store_rgba_sse2( uint8_t* dst_ptr, __m128i r, __m128i g, __m128i b ) {
+  const __m128i alpha = _mm_set1_epi8( (char)0xFF );
+  __m128i rg_lo = _mm_unpacklo_epi8( r, g ), rg_hi = _mm_unpackhi_epi8( r, g );
+  __m128i ba_lo = _mm_unpacklo_epi8( b, alpha ), ba_hi = _mm_unpackhi_epi8( b, alpha );
+  _mm_storeu_si128( (__m128i*)&dst_ptr[0], _mm_unpacklo_epi16( rg_lo, ba_lo ) );
+  _mm_storeu_si128( (__m128i*)&dst_ptr[16], _mm_unpackhi_epi16( rg_lo, ba_lo ) );
+  _mm_storeu_si128( (__m128i*)&dst_ptr[32], _mm_unpacklo_epi16( rg_hi, ba_hi ) );
+  _mm_storeu_si128( (__m128i*)&dst_ptr[48], _mm_unpackhi_epi16( rg_hi, ba_hi ) );
+}
+#endif
+
+/** Converts one row of 4:2:0 video to RGBA. Chroma samples are shared by each pair of pixels, as in swscale's unscaled conversion.
+ * @param u_ptr NV12's interleaved UV row if `v_ptr` is NULL.
+ */
+static void _yuv_row_to_rgba( const uint8_t* y_ptr, const uint8_t* u_ptr, const uint8_t* v_ptr, int w, const vol_av_yuv_coeffs_t* c, uint8_t* dst_ptr ) {
+  int x = 0;
+#if defined( VOL_AV_AVX2 )
+  {
+    const __m256i y_mul = _mm256_set1_epi16( (short)c->y_mul ), y_bias = _mm256_set1_epi16( c->y_bias ), bias = _mm256_set1_epi16( 128 );
+    const __m256i rv = _mm256_set1_epi16( c->rv ), gu = _mm256_set1_epi16( c->gu ), gv = _mm256_set1_epi16( c->gv ), bu = _mm256_set1_epi16( c->bu );
+    for ( ; x + 32 <= w; x += 32 ) {
+      __m256i u, v; // 16 chroma samples each. Lane 0 holds samples 0-7, lane 1 samples 8-15.
+      if ( v_ptr ) {
+        u = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)&u_ptr[x / 2] ) );
+        v = _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)&v_ptr[x / 2] ) );
+      } else {
+        __m256i uv = _mm256_loadu_si256( (const __m256i*)&u_ptr[x] );
+        u          = _mm256_and_si256( uv, _mm256_set1_epi16( 0xFF ) );
+        v          = _mm256_srli_epi16( uv, 8 );
+      }
+      u          = _mm256_sub_epi16( u, bias );
+      v          = _mm256_sub_epi16( v, bias );
+      __m256i rc = _mm256_mullo_epi16( v, rv );
+      __m256i gc = _mm256_add_epi16( _mm256_mullo_epi16( u, gu ), _mm256_mullo_epi16( v, gv ) );
+      __m256i bc = _mm256_mullo_epi16( u, bu );
+      // unpack works within 128-bit lanes, so the low half holds pixels 0-7 and 16-23, and the high half 8-15 and 24-31. The chroma terms line up.
+      __m256i yy    = _mm256_loadu_si256( (const __m256i*)&y_ptr[x] );
+      __m256i y_lo  = _mm256_add_epi16( _mm256_mulhi_epu16( _mm256_unpacklo_epi8( yy, yy ), y_mul ), y_bias );
+      __m256i y_hi  = _mm256_add_epi16( _mm256_mulhi_epu16( _mm256_unpackhi_epi8( yy, yy ), y_mul ), y_bias );
+      __m256i rc_lo = _mm256_unpacklo_epi16( rc, rc ), rc_hi = _mm256_unpackhi_epi16( rc, rc );
+      __m256i gc_lo = _mm256_unpacklo_epi16( gc, gc ), gc_hi = _mm256_unpackhi_epi16( gc, gc );
+      __m256i bc_lo = _mm256_unpacklo_epi16( bc, bc ), bc_hi = _mm256_unpackhi_epi16( bc, bc );
+      __m256i r = _mm256_packus_epi16( _mm256_srai_epi16( _mm256_adds_epi16( y_lo, rc_lo ), 6 ), _mm256_srai_epi16( _mm256_adds_epi16( y_hi, rc_hi ), 6 ) );
+      __m256i g = _mm256_packus_epi16( _mm256_srai_epi16( _mm256_subs_epi16( y_lo, gc_lo ), 6 ), _mm256_srai_epi16( _mm256_subs_epi16( y_hi, gc_hi ), 6 ) );
+      __m256i b = _mm256_packus_epi16( _mm256_srai_epi16( _mm256_adds_epi16( y_lo, bc_lo ), 6 ), _mm256_srai_epi16( _mm256_adds_epi16( y_hi, bc_hi ), 6 ) );
+      // Packing undoes the lane split, so r, g, and b hold pixels 0-31 in order.
+      _store_rgba_sse2( &dst_ptr[x * 4], _mm256_castsi256_si128( r ), _mm256_castsi256_si128( g ), _mm256_castsi256_si128( b ) );
+      _store_rgba_sse2( &dst_ptr[x * 4 + 64], _mm256_extracti128_si256( r, 1 ), _mm256_extracti128_si256( g, 1 ), _mm256_extracti128_si256( b, 1 ) );
+    }
+  }
+#endif
+#if defined( VOL_AV_SSE2 )
+  {
+    const __m128i zero = _mm_setzero_si128(), y_mul = _mm_set1_epi16( (short)c->y_mul ), y_bias = _mm_set1_epi16( c->y_bias ), bias = _mm_set1_epi16( 128 );
+    const __m128i rv = _mm_set1_epi16( c->rv ), gu = _mm_set1_epi16( c->gu ), gv = _mm_set1_epi16( c->gv ), bu = _mm_set1_epi16( c->bu );
+    for ( ; x + 16 <= w; x += 16 ) {
+      __m128i u, v; // 8 chroma samples each.
+      if ( v_ptr ) {
+        u = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i*)&u_ptr[x / 2] ), zero );
+        v = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i*)&v_ptr[x / 2] ), zero );
+      } else {
+        __m128i uv = _mm_loadu_si128( (const __m128i*)&u_ptr[x] );
+        u          = _mm_and_si128( uv, _mm_set1_epi16( 0xFF ) );
+        v          = _mm_srli_epi16( uv, 8 );
+      }
+      u           = _mm_sub_epi16( u, bias );
+      v           = _mm_sub_epi16( v, bias );
+      __m128i rc  = _mm_mullo_epi16( v, rv );
+      __m128i gc  = _mm_add_epi16( _mm_mullo_epi16( u, gu ), _mm_mullo_epi16( v, gv ) );
+      __m128i bc  = _mm_mullo_epi16( u, bu );
+      __m128i yy  = _mm_loadu_si128( (const __m128i*)&y_ptr[x] );
+      __m128i y_lo = _mm_add_epi16( _mm_mulhi_epu16( _mm_unpacklo_epi8( yy, yy ), y_mul ), y_bias ); // Y * 257 is Y in both bytes.
+      __m128i y_hi = _mm_add_epi16( _mm_mulhi_epu16( _mm_unpackhi_epi8( yy, yy ), y_mul ), y_bias );
+      __m128i r    = _mm_packus_epi16( _mm_srai_epi16( _mm_adds_epi16( y_lo, _mm_unpacklo_epi16( rc, rc ) ), 6 ),
+           _mm_srai_epi16( _mm_adds_epi16( y_hi, _mm_unpackhi_epi16( rc, rc ) ), 6 ) );
+      __m128i g    = _mm_packus_epi16( _mm_srai_epi16( _mm_subs_epi16( y_lo, _mm_unpacklo_epi16( gc, gc ) ), 6 ),
+           _mm_srai_epi16( _mm_subs_epi16( y_hi, _mm_unpackhi_epi16( gc, gc ) ), 6 ) );
+      __m128i b    = _mm_packus_epi16( _mm_srai_epi16( _mm_adds_epi16( y_lo, _mm_unpacklo_epi16( bc, bc ) ), 6 ),
+           _mm_srai_epi16( _mm_adds_epi16( y_hi, _mm_unpackhi_epi16( bc, bc ) ), 6 ) );
+      _store_rgba_sse2( &dst_ptr[x * 4], r, g, b );
+    }
+  }
+#elif defined( VOL_AV_NEON )
+  {
+    const uint8x8_t bias = vdup_n_u8( 128 );
+    const int16x8_t y_bias = vdupq_n_s16( c->y_bias );
+    for ( ; x + 16 <= w; x += 16 ) {
+      uint8x8_t u8, v8; // 8 chroma samples each.
+      if ( v_ptr ) {
+        u8 = vld1_u8( &u_ptr[x / 2] );
+        v8 = vld1_u8( &v_ptr[x / 2] );
+      } else {
+        uint8x8x2_t uv = vld2_u8( &u_ptr[x] );
+        u8             = uv.val[0];
+        v8             = uv.val[1];
+      }
+      int16x8_t u  = vreinterpretq_s16_u16( vsubl_u8( u8, bias ) ); // Wraps to the right signed value.
+      int16x8_t v  = vreinterpretq_s16_u16( vsubl_u8( v8, bias ) );
+      int16x8_t rc = vmulq_n_s16( v, c->rv );
+      int16x8_t gc = vmlaq_n_s16( vmulq_n_s16( u, c->gu ), v, c->gv );
+      int16x8_t bc = vmulq_n_s16( u, c->bu );
+      int16x8x2_t rc2 = vzipq_s16( rc, rc ), gc2 = vzipq_s16( gc, gc ), bc2 = vzipq_s16( bc, bc );
+      uint8x16_t yy = vld1q_u8( &y_ptr[x] );
+      uint8x16x2_t yy2 = vzipq_u8( yy, yy ); // Y * 257 is Y in both bytes.
+      uint16x8_t y257_lo = vreinterpretq_u16_u8( yy2.val[0] ), y257_hi = vreinterpretq_u16_u8( yy2.val[1] );
+      int16x8_t y_lo = vaddq_s16( vreinterpretq_s16_u16( vcombine_u16( vshrn_n_u32( vmull_n_u16( vget_low_u16( y257_lo ), c->y_mul ), 16 ),
+                                                                       vshrn_n_u32( vmull_n_u16( vget_high_u16( y257_lo ), c->y_mul ), 16 ) ) ),
+        y_bias );
+      int16x8_t y_hi = vaddq_s16( vreinterpretq_s16_u16( vcombine_u16( vshrn_n_u32( vmull_n_u16( vget_low_u16( y257_hi ), c->y_mul ), 16 ),
+                                                                       vshrn_n_u32( vmull_n_u16( vget_high_u16( y257_hi ), c->y_mul ), 16 ) ) ),
+        y_bias );
+      uint8x16x4_t rgba;
+      rgba.val[0] = vcombine_u8( vqshrun_n_s16( vqaddq_s16( y_lo, rc2.val[0] ), 6 ), vqshrun_n_s16( vqaddq_s16( y_hi, rc2.val[1] ), 6 ) );
+      rgba.val[1] = vcombine_u8( vqshrun_n_s16( vqsubq_s16( y_lo, gc2.val[0] ), 6 ), vqshrun_n_s16( vqsubq_s16( y_hi, gc2.val[1] ), 6 ) );
+      rgba.val[2] = vcombine_u8( vqshrun_n_s16( vqaddq_s16( y_lo, bc2.val[0] ), 6 ), vqshrun_n_s16( vqaddq_s16( y_hi, bc2.val[1] ), 6 ) );
+      rgba.val[3] = vdupq_n_u8( 0xFF );
+      vst4q_u8( &dst_ptr[x * 4], rgba );
+    }
+  }
+#endif
+  for ( ; x < w; x++ ) {
+    int u          = ( v_ptr ? u_ptr[x / 2] : u_ptr[x / 2 * 2] ) - 128;
+    int v          = ( v_ptr ? v_ptr[x / 2] : u_ptr[x / 2 * 2 + 1] ) - 128;
+    int y          = (int)( ( (uint32_t)y_ptr[x] * 257u * c->y_mul ) >> 16 ) + c->y_bias;
+    dst_ptr[x * 4 + 0] = _clamp_fix6( y + c->rv * v );
+    dst_ptr[x * 4 + 1] = _clamp_fix6( y - c->gu * u - c->gv * v );
+    dst_ptr[x * 4 + 2] = _clamp_fix6( y + c->bu * u );
+    dst_ptr[x * 4 + 3] = 0xFF;
+  }
+}
+
+/** Conversion of one image, split into jobs of `rows_per_job` rows. An even number, so rows that share chroma are converted by the same job. */
+typedef struct vol_av_convert_job_t {
+  const uint8_t* const* planes_ptrs;
+  const int* plane_strides;
+  bool nv12;
+  int w, h, rows_per_job;
+  const vol_av_yuv_coeffs_t* coeffs_ptr;
+  uint8_t* dst_ptr;
+  int dst_stride;
+} vol_av_convert_job_t;
+
+static void _convert_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_av_convert_job_t* job_ptr = job_ctx_ptr;
+  int row_end                         = ( job_idx + 1 ) * job_ptr->rows_per_job < job_ptr->h ? ( job_idx + 1 ) * job_ptr->rows_per_job : job_ptr->h;
+  for ( int y = job_idx * job_ptr->rows_per_job; y < row_end; y++ ) {
+    const uint8_t* y_row_ptr = &job_ptr->planes_ptrs[0][(size_t)y * job_ptr->plane_strides[0]];
+    const uint8_t* u_row_ptr = &job_ptr->planes_ptrs[1][(size_t)( y / 2 ) * job_ptr->plane_strides[1]];
+    const uint8_t* v_row_ptr = job_ptr->nv12 ? NULL : &job_ptr->planes_ptrs[2][(size_t)( y / 2 ) * job_ptr->plane_strides[2]];
+    _yuv_row_to_rgba( y_row_ptr, u_row_ptr, v_row_ptr, job_ptr->w, job_ptr->coeffs_ptr, &job_ptr->dst_ptr[(size_t)y * job_ptr->dst_stride] );
+  }
+}
+
+/******************************************************************************
+  MIP DOWNSAMPLING
+******************************************************************************/
+
+#if defined( VOL_AV_NEON )
+/** Loads 32 bytes of pixels, split into even pixels in val[0] and odd pixels in val[1]. */
+static uint8x16x2_t _vld2_pixels( const uint8_t* ptr, int n_channels ) {
+  uint8x16x2_t pixels;
+  if ( 4 == n_channels ) {
+    uint32x4x2_t v = vld2q_u32( (const uint32_t*)ptr );
+    pixels.val[0]  = vreinterpretq_u8_u32( v.val[0] );
+    pixels.val[1]  = vreinterpretq_u8_u32( v.val[1] );
+  } else if ( 2 == n_channels ) {
+    uint16x8x2_t v = vld2q_u16( (const uint16_t*)ptr );
+    pixels.val[0]  = vreinterpretq_u8_u16( v.val[0] );
+    pixels.val[1]  = vreinterpretq_u8_u16( v.val[1] );
+  } else {
+    pixels = vld2q_u8( ptr );
+  }
+  return pixels;
+}
+#endif
+
+/** Averages each 2x2 block of pixels in two rows into one pixel of `dst_w`, rounding to nearest. `row1_ptr` may equal `row0_ptr` for a 1-row image. */
+static void _downsample_row( const uint8_t* row0_ptr, const uint8_t* row1_ptr, int src_w, int n_channels, uint8_t* dst_ptr, int dst_w ) {
+  int i = 0, n_bytes = dst_w * n_channels; // i counts destination bytes, each averaged from source bytes near i * 2.
+#if defined( VOL_AV_SSE2 )
+  {
+    const __m128i zero = _mm_setzero_si128(), ones = _mm_set1_epi16( 1 ), two = _mm_set1_epi16( 2 );
+    for ( ; i + 8 <= n_bytes; i += 8 ) {
+      __m128i a  = _mm_loadu_si128( (const __m128i*)&row0_ptr[i * 2] ), b = _mm_loadu_si128( (const __m128i*)&row1_ptr[i * 2] );
+      __m128i lo = _mm_add_epi16( _mm_unpacklo_epi8( a, zero ), _mm_unpacklo_epi8( b, zero ) ); // Column sums, 16 bits per channel.
+      __m128i hi = _mm_add_epi16( _mm_unpackhi_epi8( a, zero ), _mm_unpackhi_epi8( b, zero ) );
+      __m128i sum;
+      if ( 4 == n_channels ) { // 2 pixels in each of lo and hi. Add each even pixel to the odd one after it.
+        sum = _mm_add_epi16( _mm_unpacklo_epi64( lo, hi ), _mm_unpackhi_epi64( lo, hi ) );
+      } else if ( 2 == n_channels ) { // 4 pixels in each. Gather even pixels into the low half and odd ones into the high half first.
+        lo  = _mm_shuffle_epi32( lo, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        hi  = _mm_shuffle_epi32( hi, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        sum = _mm_add_epi16( _mm_unpacklo_epi64( lo, hi ), _mm_unpackhi_epi64( lo, hi ) );
+      } else { // 8 pixels in each, summed in pairs.
+        sum = _mm_packs_epi32( _mm_madd_epi16( lo, ones ), _mm_madd_epi16( hi, ones ) );
+      }
+      _mm_storel_epi64( (__m128i*)&dst_ptr[i], _mm_packus_epi16( _mm_srli_epi16( _mm_add_epi16( sum, two ), 2 ), zero ) );
+    }
+  }
+#elif defined( VOL_AV_NEON )
+  for ( ; i + 16 <= n_bytes; i += 16 ) {
+    uint8x16x2_t a    = _vld2_pixels( &row0_ptr[i * 2], n_channels ), b = _vld2_pixels( &row1_ptr[i * 2], n_channels );
+    uint16x8_t sum_lo = vaddq_u16( vaddl_u8( vget_low_u8( a.val[0] ), vget_low_u8( a.val[1] ) ), vaddl_u8( vget_low_u8( b.val[0] ), vget_low_u8( b.val[1] ) ) );
+    uint16x8_t sum_hi =
+      vaddq_u16( vaddl_u8( vget_high_u8( a.val[0] ), vget_high_u8( a.val[1] ) ), vaddl_u8( vget_high_u8( b.val[0] ), vget_high_u8( b.val[1] ) ) );
+    vst1q_u8( &dst_ptr[i], vcombine_u8( vrshrn_n_u16( sum_lo, 2 ), vrshrn_n_u16( sum_hi, 2 ) ) );
+  }
+#endif
+  for ( ; i < n_bytes; i++ ) {
+    int x0     = ( i / n_channels ) * 2 * n_channels + i % n_channels;
+    int x1     = src_w > 1 ? x0 + n_channels : x0;
+    dst_ptr[i] = (uint8_t)( ( row0_ptr[x0] + row0_ptr[x1] + row1_ptr[x0] + row1_ptr[x1] + 2 ) >> 2 );
+  }
+}
+
+/** Downsampling of one image, split into jobs of `rows_per_job` destination rows. */
+typedef struct vol_av_downsample_job_t {
+  const uint8_t* src_ptr;
+  int src_stride, src_w, src_h, n_channels;
+  uint8_t* dst_ptr;
+  int dst_stride, dst_w, dst_h, rows_per_job;
+} vol_av_downsample_job_t;
+
+static void _downsample_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_av_downsample_job_t* job_ptr = job_ctx_ptr;
+  int row_end                            = ( job_idx + 1 ) * job_ptr->rows_per_job < job_ptr->dst_h ? ( job_idx + 1 ) * job_ptr->rows_per_job : job_ptr->dst_h;
+  for ( int y = job_idx * job_ptr->rows_per_job; y < row_end; y++ ) {
+    const uint8_t* row0_ptr = &job_ptr->src_ptr[(size_t)y * 2 * job_ptr->src_stride];
+    const uint8_t* row1_ptr = job_ptr->src_h > 1 ? &row0_ptr[job_ptr->src_stride] : row0_ptr;
+    _downsample_row( row0_ptr, row1_ptr, job_ptr->src_w, job_ptr->n_channels, &job_ptr->dst_ptr[(size_t)y * job_ptr->dst_stride], job_ptr->dst_w );
+  }
+}
+
+/******************************************************************************
+  FRAME OUTPUT AND CACHE
+******************************************************************************/
+
+/** Gets the size of plane `plane_idx` of a `w` by `h` frame: the bytes in each row, and the number of rows. Both are 0 if the layout has no such plane. */
+static void _plane_dims( vol_av_plane_layout_t layout, int w, int h, int plane_idx, int* row_sz_ptr, int* n_rows_ptr ) {
+  *row_sz_ptr = *n_rows_ptr = 0;
+  if ( VOL_AV_PLANES_NONE == layout || ( VOL_AV_PLANES_NV12 == layout && plane_idx > 1 ) ) { return; }
+  if ( 0 == plane_idx ) {
+    *row_sz_ptr = w;
+    *n_rows_ptr = h;
+    return;
+  }
+  *row_sz_ptr = VOL_AV_PLANES_NV12 == layout ? ( w + 1 ) / 2 * 2 : ( w + 1 ) / 2;
+  *n_rows_ptr = ( h + 1 ) / 2;
+}
+
+/** Size in bytes of one frame in the output format: RGB as laid out in `output_frame_rgb_ptr`, or RGBA or 4:2:0 planes without row padding. */
+static int64_t _frame_sz( const vol_av_internal_t* p ) {
+  int64_t w = p->codec_ctx_ptr->width, h = p->codec_ctx_ptr->height;
+  if ( VOL_AV_OUTPUT_YUV420_PLANES == p->output_format ) { return w * h + 2 * ( ( w + 1 ) / 2 ) * ( ( h + 1 ) / 2 ); }
+  if ( VOL_AV_OUTPUT_RGBA32 == p->output_format ) { return w * h * 4; }
+  return (int64_t)p->output_frame_rgb_ptr->linesize[0] * h;
+}
 
+static void _clear_output_planes( vol_av_video_t* info_ptr ) {
+  memset( info_ptr->planes_ptrs, 0, sizeof( info_ptr->planes_ptrs ) );
+  memset( info_ptr->plane_strides, 0, sizeof( info_ptr->plane_strides ) );
+  info_ptr->plane_layout = VOL_AV_PLANES_NONE;
+}
+
+/** Image of the frame last decoded, in the RGB or RGBA output formats. */
+static uint8_t* _decoded_pixels_ptr( const vol_av_internal_t* p ) {
+  return VOL_AV_OUTPUT_RGBA32 == p->output_format ? p->rgba_ptr : p->output_frame_rgb_ptr->data[0];
+}
+
+/** Points the application's output at the frame last decoded. */
+static void _output_decoded( vol_av_video_t* info_ptr ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  info_ptr->key_frame  = p->key_frame;
+  if ( VOL_AV_OUTPUT_YUV420_PLANES != p->output_format ) {
+    info_ptr->pixels_ptr = _decoded_pixels_ptr( p );
+    return;
+  }
+  memcpy( info_ptr->planes_ptrs, p->planes_ptrs, sizeof( p->planes_ptrs ) );
+  memcpy( info_ptr->plane_strides, p->plane_strides, sizeof( p->plane_strides ) );
+  info_ptr->plane_layout = p->plane_layout;
+  info_ptr->full_range   = p->full_range;
+  info_ptr->bt709        = p->bt709;
+}
+
+/** Points the application's output at the frame image in a cache slot. */
+static void _output_cached( vol_av_video_t* info_ptr, int slot ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  uint8_t* image_ptr   = p->cache_pixels_ptrs[slot];
+  info_ptr->key_frame  = p->cache_key_frames[slot];
+  if ( VOL_AV_OUTPUT_YUV420_PLANES != p->output_format ) {
+    info_ptr->pixels_ptr = image_ptr;
+    return;
+  }
+  for ( int i = 0; i < 3; i++ ) {
+    int row_sz = 0, n_rows = 0;
+    _plane_dims( p->plane_layout, p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, i, &row_sz, &n_rows );
+    info_ptr->planes_ptrs[i]   = row_sz > 0 ? image_ptr : NULL;
+    info_ptr->plane_strides[i] = row_sz;
+    image_ptr += (size_t)row_sz * n_rows;
+  }
+  info_ptr->plane_layout = p->plane_layout;
+}
+
+static void _free_cache( vol_av_internal_t* p ) {
+  for ( int i = 0; i < p->cache_capacity; i++ ) { free( p->cache_pixels_ptrs[i] ); }
+  free( p->cache_pixels_ptrs );
+  free( p->cache_frame_idxs );
+  free( p->cache_key_frames );
+  free( p->cache_last_used );
+  p->cache_pixels_ptrs = NULL;
+  p->cache_frame_idxs  = NULL;
+  p->cache_key_frames  = NULL;
+  p->cache_last_used   = NULL;
+  p->cache_capacity    = 0;
+}
+
+/** Allocates cache slot bookkeeping on first use. Slot images are allocated when first stored to. */
+static bool _init_cache( vol_av_internal_t* p ) {
+  if ( p->cache_capacity > 0 ) { return true; }
+  int64_t frame_sz = _frame_sz( p );
+  if ( frame_sz <= 0 || p->cache_budget_bytes < frame_sz ) { return false; }
+  int64_t capacity = p->cache_budget_bytes / frame_sz;
+  if ( capacity > VOL_AV_MAX_SEEK_DECODE_FRAMES ) { capacity = VOL_AV_MAX_SEEK_DECODE_FRAMES; }
+  p->cache_pixels_ptrs = calloc( (size_t)capacity, sizeof( uint8_t* ) );
+  p->cache_frame_idxs  = malloc( (size_t)capacity * sizeof( int64_t ) );
+  p->cache_key_frames  = calloc( (size_t)capacity, sizeof( bool ) );
+  p->cache_last_used   = calloc( (size_t)capacity, sizeof( uint64_t ) );
+  if ( !p->cache_pixels_ptrs || !p->cache_frame_idxs || !p->cache_key_frames || !p->cache_last_used ) {
+    _free_cache( p );
+    return false;
+  }
+  for ( int64_t i = 0; i < capacity; i++ ) { p->cache_frame_idxs[i] = -1; }
+  p->cache_capacity = (int)capacity;
+  return true;
+}
+
+/** Reallocates the slot bookkeeping for a new number of slots. Slots beyond the new number must already be empty and freed; new slots start empty. */
+static bool _resize_cache_slots( vol_av_internal_t* p, int capacity ) {
+  uint8_t** pixels_ptrs = realloc( p->cache_pixels_ptrs, (size_t)capacity * sizeof( uint8_t* ) );
+  if ( pixels_ptrs ) { p->cache_pixels_ptrs = pixels_ptrs; }
+  int64_t* frame_idxs = realloc( p->cache_frame_idxs, (size_t)capacity * sizeof( int64_t ) );
+  if ( frame_idxs ) { p->cache_frame_idxs = frame_idxs; }
+  bool* key_frames = realloc( p->cache_key_frames, (size_t)capacity * sizeof( bool ) );
+  if ( key_frames ) { p->cache_key_frames = key_frames; }
+  uint64_t* last_used = realloc( p->cache_last_used, (size_t)capacity * sizeof( uint64_t ) );
+  if ( last_used ) { p->cache_last_used = last_used; }
+  // A failed realloc leaves its array as it was, which is still big enough when shrinking.
+  if ( !pixels_ptrs || !frame_idxs || !key_frames || !last_used ) { return capacity < p->cache_capacity; }
+  for ( int i = p->cache_capacity; i < capacity; i++ ) {
+    p->cache_pixels_ptrs[i] = NULL;
+    p->cache_frame_idxs[i]  = -1;
+    p->cache_key_frames[i]  = false;
+    p->cache_last_used[i]   = 0;
+  }
+  return true;
+}
+
+/** @return The cache slot holding a frame, or -1 if it isn't cached. */
+static int _cache_find( vol_av_internal_t* p, int64_t frame_idx ) {
+  for ( int i = 0; i < p->cache_capacity; i++ ) {
+    if ( p->cache_frame_idxs[i] == frame_idx ) {
+      p->cache_last_used[i] = ++p->cache_clock;
+      return i;
+    }
+  }
+  return -1;
+}
+
+/** Copies the frame last decoded into the cache, replacing the least recently used slot. */
+static void _cache_store( vol_av_internal_t* p, int64_t frame_idx ) {
+  bool planes = VOL_AV_OUTPUT_YUV420_PLANES == p->output_format;
+  if ( ( planes && VOL_AV_PLANES_NONE == p->plane_layout ) || !_decoded_pixels_ptr( p ) ) { return; }
+  if ( !_init_cache( p ) || _cache_find( p, frame_idx ) >= 0 ) { return; }
+  int slot = 0;
+  for ( int i = 1; i < p->cache_capacity; i++ ) {
+    if ( p->cache_last_used[i] < p->cache_last_used[slot] ) { slot = i; }
+  }
+  if ( !p->cache_pixels_ptrs[slot] ) {
+    p->cache_pixels_ptrs[slot] = malloc( (size_t)_frame_sz( p ) );
+    if ( !p->cache_pixels_ptrs[slot] ) { return; }
+  }
+  if ( planes ) { // Packed one after another, without the decoder's row padding.
+    uint8_t* dst_ptr = p->cache_pixels_ptrs[slot];
+    for ( int i = 0; i < 3; i++ ) {
+      int row_sz = 0, n_rows = 0;
+      _plane_dims( p->plane_layout, p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, i, &row_sz, &n_rows );
+      if ( row_sz <= 0 ) { continue; }
+      av_image_copy_plane( dst_ptr, row_sz, p->planes_ptrs[i], p->plane_strides[i], row_sz, n_rows );
+      dst_ptr += (size_t)row_sz * n_rows;
+    }
+  } else {
+    memcpy( p->cache_pixels_ptrs[slot], _decoded_pixels_ptr( p ), (size_t)_frame_sz( p ) );
+  }
+  p->cache_frame_idxs[slot] = frame_idx;
+  p->cache_key_frames[slot] = p->key_frame;
+  p->cache_last_used[slot]  = ++p->cache_clock;
+}
+
+/** Stream start time, in stream time base units. */
+static int64_t _start_pts( const vol_av_internal_t* p ) {
+  int64_t start_time = p->fmt_ctx_ptr->streams[p->video_stream_idx]->start_time;
+  return AV_NOPTS_VALUE == start_time ? 0 : start_time;
+}
+
+/** Converts a frame timestamp to a frame index using the stream's average frame rate. Returns -1 if the stream has no usable frame rate. */
+static int64_t _pts_to_frame_idx( const vol_av_internal_t* p, int64_t pts ) {
+  AVStream* strm_ptr = p->fmt_ctx_ptr->streams[p->video_stream_idx];
+  if ( strm_ptr->avg_frame_rate.num <= 0 || strm_ptr->avg_frame_rate.den <= 0 ) { return -1; }
+  return av_rescale_q_rnd( pts - _start_pts( p ), strm_ptr->time_base, av_inv_q( strm_ptr->avg_frame_rate ), AV_ROUND_NEAR_INF );
+}
+
+static int64_t _frame_idx_to_pts( const vol_av_internal_t* p, int64_t frame_idx ) {
+  AVStream* strm_ptr = p->fmt_ctx_ptr->streams[p->video_stream_idx];
+  return _start_pts( p ) + av_rescale_q( frame_idx, av_inv_q( strm_ptr->avg_frame_rate ), strm_ptr->time_base );
+}
+
+static int _io_read_packet( void* opaque_ptr, uint8_t* buf_ptr, int buf_sz ) {
+  vol_av_internal_t* p = opaque_ptr;
+  int n                = p->io.read_fn( p->io.user_ptr, buf_ptr, buf_sz );
+  if ( n < 0 ) { return AVERROR( EIO ); }
+  if ( 0 == n ) { return AVERROR_EOF; }
+  p->io_pos += n;
+  return n;
+}
+
+/** FFmpeg's seek callback: `whence` is SEEK_SET, SEEK_CUR, SEEK_END, or AVSEEK_SIZE to ask for the size without seeking. */
+static int64_t _io_seek( void* opaque_ptr, int64_t offset, int whence ) {
+  vol_av_internal_t* p = opaque_ptr;
+  int64_t sz           = p->io.size_fn ? p->io.size_fn( p->io.user_ptr ) : -1;
+  whence &= ~AVSEEK_FORCE;
+  if ( AVSEEK_SIZE == whence ) { return sz >= 0 ? sz : AVERROR( ENOSYS ); }
+  if ( !p->io.seek_fn ) { return AVERROR( ENOSYS ); }
+
+  int64_t pos = -1;
+  if ( SEEK_SET == whence ) {
+    pos = offset;
+  } else if ( SEEK_CUR == whence ) {
+    pos = p->io_pos + offset;
+  } else if ( SEEK_END == whence && sz >= 0 ) {
+    pos = sz + offset;
+  }
+  if ( pos < 0 || !p->io.seek_fn( p->io.user_ptr, pos ) ) { return AVERROR( EIO ); }
+  p->io_pos = pos;
+  return pos;
+}
+
+static int _memory_read( void* user_ptr, uint8_t* buf_ptr, int buf_sz ) {
+  vol_av_internal_t* p = user_ptr;
+  int64_t n            = p->memory_sz - p->memory_pos < buf_sz ? p->memory_sz - p->memory_pos : buf_sz;
+  if ( n <= 0 ) { return 0; }
+  memcpy( buf_ptr, &p->memory_ptr[p->memory_pos], (size_t)n );
+  p->memory_pos += n;
+  return (int)n;
+}
+
+static bool _memory_seek( void* user_ptr, int64_t offset ) {
+  vol_av_internal_t* p = user_ptr;
+  if ( offset < 0 || offset > p->memory_sz ) { return false; }
+  p->memory_pos = offset;
+  return true;
+}
+
+static int64_t _memory_size( void* user_ptr ) { return ( (vol_av_internal_t*)user_ptr )->memory_sz; }
+
+static bool _create_context( vol_av_video_t* info_ptr ) {
   memset( info_ptr, 0, sizeof( vol_av_video_t ) );
   info_ptr->_context_ptr = calloc( 1, sizeof( vol_av_internal_t ) );
   if ( !info_ptr->_context_ptr ) {
     _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for internal pointer\n" );
     return false;
   }
+  info_ptr->_context_ptr->decoded_frame_idx  = -1;
+  info_ptr->_context_ptr->cache_budget_bytes = VOL_AV_DEFAULT_CACHE_BYTES;
+  return true;
+}
+
+/** Opens a video into a context made by _create_context(). If the context's `io` callbacks are set, the video is read through them and `filename` is
+ * only used in log messages. Nothing is cleaned up on failure. The caller closes the video.
+ */
+static bool _open( const char* filename, vol_av_video_t* info_ptr ) {
+  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
+
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  bool custom_io       = NULL != p->io.read_fn;
+  if ( custom_io ) { // FFmpeg reads the file through a buffer that it refills with io.read_fn().
+    int buffer_sz      = p->io.buffer_sz > 0 ? p->io.buffer_sz : VOL_AV_DEFAULT_IO_BUFFER_SZ;
+    uint8_t* io_buffer = av_malloc( buffer_sz );
+    if ( !io_buffer ) { return false; }
+    p->avio_ctx_ptr = avio_alloc_context( io_buffer, buffer_sz, 0, p, _io_read_packet, NULL, _io_seek );
+    if ( !p->avio_ctx_ptr ) {
+      av_free( io_buffer );
+      return false;
+    }
+    p->avio_ctx_ptr->seekable = p->io.seek_fn ? AVIO_SEEKABLE_NORMAL : 0;
+    p->fmt_ctx_ptr            = avformat_alloc_context();
+    if ( !p->fmt_ctx_ptr ) { return false; }
+    p->fmt_ctx_ptr->pb = p->avio_ctx_ptr;
+    p->fmt_ctx_ptr->flags |= AVFMT_FLAG_CUSTOM_IO;
+  }
 
   { // Open the file and read its header. The codecs are not opened. -- note that if first param is NULL then this allocates memory.
-    if ( avformat_open_input( &p->fmt_ctx_ptr, filename, NULL, NULL ) < 0 ) { // NOTE(Anton) the second param is `url` and we can try a web stream.
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open input file.\n" );
+    // URLs such as http:// are read progressively by FFmpeg's protocols, with range requests when seeking. Playback can start once the header and first
+    // GOP have arrived, if the MP4 was written with its index at the front (`-movflags +faststart`).
+    AVDictionary* options_ptr = NULL;
+    if ( !custom_io && strstr( filename, "://" ) ) {
+      avformat_network_init();
+      p->network_initialised = true;
+      av_dict_set( &options_ptr, "multiple_requests", "1", 0 ); // Keep the connection alive between the range requests made when seeking.
+      av_dict_set( &options_ptr, "reconnect", "1", 0 );
+      av_dict_set( &options_ptr, "rw_timeout", VOL_AV_NETWORK_TIMEOUT_US, 0 );
+    }
+    int open_ret = avformat_open_input( &p->fmt_ctx_ptr, custom_io ? NULL : filename, NULL, &options_ptr );
+    av_dict_free( &options_ptr );
+    if ( open_ret < 0 ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open input file: %s\n", av_err2str( open_ret ) );
       return false;
     }
     _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "format: %s, duration: %lld us, bit_rate: %lld\n", p->fmt_ctx_ptr->iformat->name, p->fmt_ctx_ptr->duration,
@@ -176,7 +774,8 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
   { // Allocate Frame Storage
     p->output_frame_ptr     = av_frame_alloc();
     p->output_frame_rgb_ptr = av_frame_alloc();
-    if ( !p->output_frame_ptr || !p->output_frame_rgb_ptr ) {
+    p->planes_frame_ptr     = av_frame_alloc();
+    if ( !p->output_frame_ptr || !p->output_frame_rgb_ptr || !p->planes_frame_ptr ) {
       _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate frame storage.\n" );
       return false;
     }
@@ -221,6 +820,46 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
   return true;
 }
 
+//
+//
+bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
+  if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+  if ( !_create_context( info_ptr ) ) { return false; }
+  if ( !_open( filename, info_ptr ) ) {
+    vol_av_close( info_ptr );
+    return false;
+  }
+  return true;
+}
+
+bool vol_av_open_io( const vol_av_io_t* io_ptr, vol_av_video_t* info_ptr ) {
+  if ( !io_ptr || !io_ptr->read_fn || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+  if ( !_create_context( info_ptr ) ) {
+    if ( io_ptr->close_fn ) { io_ptr->close_fn( io_ptr->user_ptr ); }
+    return false;
+  }
+  info_ptr->_context_ptr->io = *io_ptr; // From here vol_av_close() calls close_fn.
+  if ( !_open( "custom I/O", info_ptr ) ) {
+    vol_av_close( info_ptr );
+    return false;
+  }
+  return true;
+}
+
+bool vol_av_open_memory( const void* data_ptr, int64_t sz, int buffer_sz, vol_av_video_t* info_ptr ) {
+  if ( !data_ptr || sz <= 0 || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
+  if ( !_create_context( info_ptr ) ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  p->memory_ptr        = data_ptr;
+  p->memory_sz         = sz;
+  p->io = ( vol_av_io_t ){ .read_fn = _memory_read, .seek_fn = _memory_seek, .size_fn = _memory_size, .user_ptr = p, .buffer_sz = buffer_sz };
+  if ( !_open( "memory", info_ptr ) ) {
+    vol_av_close( info_ptr );
+    return false;
+  }
+  return true;
+}
+
 //
 //
 bool vol_av_close( vol_av_video_t* info_ptr ) {
@@ -231,15 +870,28 @@ bool vol_av_close( vol_av_video_t* info_ptr ) {
   vol_av_internal_t* p = info_ptr->_context_ptr;
 
   if ( p->fmt_ctx_ptr ) { avformat_close_input( &p->fmt_ctx_ptr ); }
+  if ( p->avio_ctx_ptr ) { // FFmpeg may have replaced the buffer we gave it, so free whichever it has now.
+    av_freep( &p->avio_ctx_ptr->buffer );
+    avio_context_free( &p->avio_ctx_ptr );
+  }
+  if ( p->io.close_fn ) { p->io.close_fn( p->io.user_ptr ); }
   if ( p->output_frame_ptr ) { av_frame_free( &p->output_frame_ptr ); }
   if ( p->output_frame_rgb_ptr ) {
     av_freep( &p->output_frame_rgb_ptr->data[0] );
     av_frame_free( &p->output_frame_rgb_ptr );
   }
+  if ( p->planes_frame_ptr ) { av_frame_free( &p->planes_frame_ptr ); }
+  if ( p->planes_conv_frame_ptr ) { av_frame_free( &p->planes_conv_frame_ptr ); }
   if ( p->codec_ctx_ptr ) { avcodec_free_context( &p->codec_ctx_ptr ); }
 
+  free( p->rgba_ptr );
+
   // tools
   if ( p->sws_conv_ctx_ptr ) { sws_freeContext( p->sws_conv_ctx_ptr ); }
+  if ( p->sws_planes_ctx_ptr ) { sws_freeContext( p->sws_planes_ctx_ptr ); }
+  if ( p->sws_rgba_ctx_ptr ) { sws_freeContext( p->sws_rgba_ctx_ptr ); }
+  _free_cache( p );
+  if ( p->network_initialised ) { avformat_network_deinit(); }
 
   free( info_ptr->_context_ptr );                  // this is our internal struct we allocated
   memset( info_ptr, 0, sizeof( vol_av_video_t ) ); // wipe for subsequent use
@@ -247,13 +899,113 @@ bool vol_av_close( vol_av_video_t* info_ptr ) {
   return true;
 }
 
-//
-//
-static void _save_rgb_frame( vol_av_video_t* info_ptr ) {
+/** Sets up conversion to YUV420P planes, for decoders that output other formats, e.g. 4:4:4 or 10-bit video. */
+static bool _init_planes_conversion( vol_av_internal_t* p ) {
+  if ( p->sws_planes_ctx_ptr ) { return true; }
+  if ( !p->planes_conv_frame_ptr ) {
+    p->planes_conv_frame_ptr = av_frame_alloc();
+    if ( !p->planes_conv_frame_ptr ) { return false; }
+    p->planes_conv_frame_ptr->format = AV_PIX_FMT_YUV420P;
+    p->planes_conv_frame_ptr->width  = p->codec_ctx_ptr->width;
+    p->planes_conv_frame_ptr->height = p->codec_ctx_ptr->height;
+    if ( av_frame_get_buffer( p->planes_conv_frame_ptr, 32 ) < 0 ) {
+      av_frame_free( &p->planes_conv_frame_ptr );
+      return false;
+    }
+  }
+  p->sws_planes_ctx_ptr = sws_getContext( p->codec_ctx_ptr->width, p->codec_ctx_ptr->height, p->codec_ctx_ptr->pix_fmt, p->codec_ctx_ptr->width,
+    p->codec_ctx_ptr->height, AV_PIX_FMT_YUV420P, SWS_BILINEAR, NULL, NULL, NULL );
+  return NULL != p->sws_planes_ctx_ptr;
+}
+
+/** Finds the planes of `output_frame_ptr`, converting them to 4:2:0 if they aren't already. */
+static void _save_planes( vol_av_internal_t* p ) {
+  AVFrame* frame_ptr  = p->output_frame_ptr;
+  AVFrame* planes_ptr = NULL;
+  bool converted      = false;
+  // The YUVJ formats are full range whatever their tag says.
+  bool jpeg_format = AV_PIX_FMT_YUVJ420P == frame_ptr->format || AV_PIX_FMT_YUVJ422P == frame_ptr->format || AV_PIX_FMT_YUVJ444P == frame_ptr->format;
+
+  p->plane_layout = VOL_AV_PLANES_NONE;
+  av_frame_unref( p->planes_frame_ptr );
+
+  if ( AV_PIX_FMT_YUV420P == frame_ptr->format || AV_PIX_FMT_YUVJ420P == frame_ptr->format || AV_PIX_FMT_NV12 == frame_ptr->format ) {
+    // Already 4:2:0, so the decoder's planes are given as they are. Referencing the frame keeps them alive without a copy.
+    if ( av_frame_ref( p->planes_frame_ptr, frame_ptr ) >= 0 ) {
+      planes_ptr      = p->planes_frame_ptr;
+      p->plane_layout = AV_PIX_FMT_NV12 == frame_ptr->format ? VOL_AV_PLANES_NV12 : VOL_AV_PLANES_I420;
+    }
+  } else if ( _init_planes_conversion( p ) && av_frame_make_writable( p->planes_conv_frame_ptr ) >= 0 ) {
+    sws_scale( p->sws_planes_ctx_ptr, (uint8_t const* const*)frame_ptr->data, frame_ptr->linesize, 0, frame_ptr->height, p->planes_conv_frame_ptr->data,
+      p->planes_conv_frame_ptr->linesize );
+    planes_ptr      = p->planes_conv_frame_ptr;
+    p->plane_layout = VOL_AV_PLANES_I420;
+    converted       = true;
+  }
+  if ( !planes_ptr ) { _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get YUV planes from pixel format %i.\n", frame_ptr->format ); }
+
+  for ( int i = 0; i < 3; i++ ) {
+    int row_sz = 0, n_rows = 0;
+    _plane_dims( p->plane_layout, frame_ptr->width, frame_ptr->height, i, &row_sz, &n_rows );
+    p->planes_ptrs[i]   = row_sz > 0 ? planes_ptr->data[i] : NULL;
+    p->plane_strides[i] = row_sz > 0 ? planes_ptr->linesize[i] : 0;
+  }
+  // swscale converts the YUVJ formats to limited range, and copies other formats' samples as they are.
+  p->full_range = converted ? ( !jpeg_format && AVCOL_RANGE_JPEG == frame_ptr->color_range ) : ( jpeg_format || AVCOL_RANGE_JPEG == frame_ptr->color_range );
+  p->bt709      = AVCOL_SPC_BT709 == frame_ptr->colorspace;
+}
+
+/** Converts `output_frame_ptr` to RGBA. 4:2:0 video is converted by vol_av_yuv420_to_rgba(), in parallel. Anything else falls back to swscale. */
+static void _save_rgba( vol_av_internal_t* p ) {
+  AVFrame* frame_ptr = p->output_frame_ptr;
+  int w = p->codec_ctx_ptr->width, h = p->codec_ctx_ptr->height;
+  if ( frame_ptr->width != w || frame_ptr->height != h ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: frame is %ix%i, but the video is %ix%i.\n", frame_ptr->width, frame_ptr->height, w, h );
+    return;
+  }
+  if ( !p->rgba_ptr ) {
+    p->rgba_ptr = malloc( (size_t)w * h * 4 );
+    if ( !p->rgba_ptr ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for RGBA frame.\n" );
+      return;
+    }
+  }
+
+  if ( AV_PIX_FMT_YUV420P == frame_ptr->format || AV_PIX_FMT_YUVJ420P == frame_ptr->format || AV_PIX_FMT_NV12 == frame_ptr->format ) {
+    _save_planes( p );
+    if ( VOL_AV_PLANES_NONE != p->plane_layout ) {
+      vol_av_yuv420_to_rgba( p->planes_ptrs, p->plane_strides, p->plane_layout, w, h, p->full_range, p->bt709, p->rgba_ptr, w * 4 );
+    }
+    return;
+  }
+  if ( !p->sws_rgba_ctx_ptr ) {
+    p->sws_rgba_ctx_ptr = sws_getContext( w, h, p->codec_ctx_ptr->pix_fmt, w, h, AV_PIX_FMT_RGBA, SWS_BILINEAR, NULL, NULL, NULL );
+    if ( !p->sws_rgba_ctx_ptr ) {
+      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get SWS context to convert pixel format %i to RGBA.\n", frame_ptr->format );
+      return;
+    }
+  }
+  uint8_t* dst_ptrs[4] = { p->rgba_ptr, NULL, NULL, NULL };
+  int dst_strides[4]   = { w * 4, 0, 0, 0 };
+  sws_scale( p->sws_rgba_ctx_ptr, (uint8_t const* const*)frame_ptr->data, frame_ptr->linesize, 0, h, dst_ptrs, dst_strides );
+}
+
+/** Converts `output_frame_ptr` to the output format, and points the application's output at it. */
+static void _convert_frame( vol_av_video_t* info_ptr ) {
   vol_av_internal_t* p = info_ptr->_context_ptr;
 
   info_ptr->w = p->output_frame_ptr->width;
   info_ptr->h = p->output_frame_ptr->height;
+  if ( VOL_AV_OUTPUT_YUV420_PLANES == p->output_format ) {
+    _save_planes( p );
+    _output_decoded( info_ptr );
+    return;
+  }
+  if ( VOL_AV_OUTPUT_RGBA32 == p->output_format ) {
+    _save_rgba( p );
+    _output_decoded( info_ptr );
+    return;
+  }
   //   printf("[vol_av] DEBUG - frame wxh %ix%i linesize %i\n", info_ptr->w, info_ptr->h, p->output_frame_rgb_ptr->linesize[0] );
   // Convert the image from its native format to RGB
   sws_scale( p->sws_conv_ctx_ptr,                     // context.
@@ -266,7 +1018,22 @@ static void _save_rgb_frame( vol_av_video_t* info_ptr ) {
   );
   // Remember that you can cast an AVFrame pointer to an AVPicture pointer.
   // can now save or use this data and increment frame counter
-  info_ptr->pixels_ptr = p->output_frame_rgb_ptr->data[0]; // [0] is the first (red) channel. output usually has 3 but can have 4 channels.
+  _output_decoded( info_ptr ); // [0] is the first (red) channel. output usually has 3 but can have 4 channels.
+}
+
+//
+//
+static void _save_frame( vol_av_video_t* info_ptr ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+
+  p->key_frame = 0 != p->output_frame_ptr->key_frame;
+  _convert_frame( info_ptr );
+
+  // Work out which frame this was from its timestamp, falling back to counting frames.
+  int64_t pts = p->output_frame_ptr->best_effort_timestamp;
+  if ( AV_NOPTS_VALUE == pts ) { pts = p->output_frame_ptr->pts; }
+  int64_t frame_idx    = AV_NOPTS_VALUE != pts ? _pts_to_frame_idx( p, pts ) : -1;
+  p->decoded_frame_idx = frame_idx >= 0 ? frame_idx : p->decoded_frame_idx + 1;
 }
 
 //
@@ -315,7 +1082,7 @@ static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
         av_get_picture_type_char( p->output_frame_ptr->pict_type ), p->output_frame_ptr->pkt_size, p->output_frame_ptr->format, p->output_frame_ptr->pts,
         p->output_frame_ptr->key_frame, p->output_frame_ptr->coded_picture_number );
 #endif
-      _save_rgb_frame( info_ptr );
+      _save_frame( info_ptr );
       return response;
     }
     overflow_retry_count++;
@@ -379,6 +1146,191 @@ bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) {
   return true;
 }
 
+//
+//
+bool vol_av_seek_frame( vol_av_video_t* info_ptr, int64_t frame_idx ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || frame_idx < 0 ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( vol_av_frame_rate( info_ptr ) <= 0.0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: can't seek in a video stream without a frame rate.\n" );
+    return false;
+  }
+
+  // Land on the keyframe at or before the target, then decode forward to it.
+  if ( av_seek_frame( p->fmt_ctx_ptr, p->video_stream_idx, _frame_idx_to_pts( p, frame_idx ), AVSEEK_FLAG_BACKWARD ) < 0 ) {
+    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: seeking to frame %lld failed.\n", (long long)frame_idx );
+    return false;
+  }
+  avcodec_flush_buffers( p->codec_ctx_ptr );
+  p->decoded_frame_idx = -1;
+
+  // Keep the frames decoded on the way, up to the cache's capacity, so that stepping backwards through this GOP needs no more decoding.
+  if ( !_init_cache( p ) ) { _vol_loggerf( VOL_AV_LOG_TYPE_WARNING, "WARNING: frame cache budget is too small to hold a frame.\n" ); }
+  int64_t first_cached_idx = frame_idx - p->cache_capacity + 1;
+  int n_stalled = 0; // Reads that produced no new frame, e.g. only audio packets or the end of the stream.
+  for ( int i = 0; i < VOL_AV_MAX_SEEK_DECODE_FRAMES && n_stalled < 8; i++ ) {
+    int64_t prev_idx = p->decoded_frame_idx;
+    if ( !vol_av_read_next_frame( info_ptr ) ) { return false; }
+    if ( p->decoded_frame_idx == prev_idx ) {
+      n_stalled++;
+      continue;
+    }
+    n_stalled = 0;
+    if ( p->decoded_frame_idx >= first_cached_idx && p->decoded_frame_idx <= frame_idx ) { _cache_store( p, p->decoded_frame_idx ); }
+    if ( p->decoded_frame_idx >= frame_idx ) { break; }
+  }
+  return p->decoded_frame_idx >= 0;
+}
+
+//
+//
+bool vol_av_read_frame( vol_av_video_t* info_ptr, int64_t frame_idx ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || frame_idx < 0 ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+
+  int slot = _cache_find( p, frame_idx );
+  if ( slot >= 0 ) {
+    _output_cached( info_ptr, slot );
+    return true;
+  }
+  if ( p->decoded_frame_idx >= 0 && frame_idx == p->decoded_frame_idx + 1 ) { return vol_av_read_next_frame( info_ptr ); }
+  if ( frame_idx == p->decoded_frame_idx ) {
+    _output_decoded( info_ptr );
+    return true;
+  }
+  return vol_av_seek_frame( info_ptr, frame_idx );
+}
+
+//
+//
+bool vol_av_cache_frame( vol_av_video_t* info_ptr, int64_t frame_idx ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || frame_idx < 0 ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+
+  if ( _cache_find( p, frame_idx ) >= 0 ) { return true; }
+  if ( !vol_av_read_frame( info_ptr, frame_idx ) ) { return false; }
+  if ( p->decoded_frame_idx == frame_idx ) { _cache_store( p, frame_idx ); }
+  return true;
+}
+
+//
+//
+void vol_av_set_cache_budget( vol_av_video_t* info_ptr, int64_t max_bytes ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( info_ptr->pixels_ptr != _decoded_pixels_ptr( p ) ) { info_ptr->pixels_ptr = NULL; } // Pointed into the cache.
+  if ( info_ptr->planes_ptrs[0] != p->planes_ptrs[0] ) { _clear_output_planes( info_ptr ); }
+  _free_cache( p );
+  p->cache_budget_bytes = max_bytes > 0 ? max_bytes : 0;
+}
+
+//
+//
+int64_t vol_av_resize_cache( vol_av_video_t* info_ptr, int64_t max_bytes ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return 0; }
+  vol_av_internal_t* p  = info_ptr->_context_ptr;
+  p->cache_budget_bytes = max_bytes > 0 ? max_bytes : 0;
+  if ( p->cache_capacity <= 0 ) { return 0; } // Slots are allocated for the new budget when the first frame is cached.
+
+  int64_t frame_sz = _frame_sz( p );
+  int64_t capacity = frame_sz > 0 ? p->cache_budget_bytes / frame_sz : 0;
+  if ( capacity > VOL_AV_MAX_SEEK_DECODE_FRAMES ) { capacity = VOL_AV_MAX_SEEK_DECODE_FRAMES; }
+
+  // Evict the least recently used frames until the rest fit.
+  int n_allocated = 0;
+  for ( int i = 0; i < p->cache_capacity; i++ ) { n_allocated += p->cache_pixels_ptrs[i] ? 1 : 0; }
+  int64_t freed_sz = 0;
+  while ( n_allocated > capacity ) {
+    int slot = -1;
+    for ( int i = 0; i < p->cache_capacity; i++ ) {
+      if ( p->cache_pixels_ptrs[i] && ( slot < 0 || p->cache_last_used[i] < p->cache_last_used[slot] ) ) { slot = i; }
+    }
+    if ( info_ptr->pixels_ptr == p->cache_pixels_ptrs[slot] ) { info_ptr->pixels_ptr = NULL; }
+    if ( info_ptr->planes_ptrs[0] == p->cache_pixels_ptrs[slot] ) { _clear_output_planes( info_ptr ); }
+    free( p->cache_pixels_ptrs[slot] );
+    p->cache_pixels_ptrs[slot] = NULL;
+    p->cache_frame_idxs[slot]  = -1;
+    p->cache_last_used[slot]   = 0;
+    freed_sz += frame_sz;
+    n_allocated--;
+  }
+  if ( capacity <= 0 ) {
+    _free_cache( p );
+    return freed_sz;
+  }
+
+  // Move the frames kept to the first slots, so the slots past the new capacity can be dropped.
+  int n_kept = 0;
+  for ( int i = 0; i < p->cache_capacity; i++ ) {
+    if ( !p->cache_pixels_ptrs[i] ) { continue; }
+    p->cache_pixels_ptrs[n_kept] = p->cache_pixels_ptrs[i];
+    p->cache_frame_idxs[n_kept]  = p->cache_frame_idxs[i];
+    p->cache_key_frames[n_kept]  = p->cache_key_frames[i];
+    p->cache_last_used[n_kept]   = p->cache_last_used[i];
+    if ( i != n_kept ) {
+      p->cache_pixels_ptrs[i] = NULL;
+      p->cache_frame_idxs[i]  = -1;
+    }
+    n_kept++;
+  }
+  if ( _resize_cache_slots( p, (int)capacity ) ) { p->cache_capacity = (int)capacity; }
+  return freed_sz;
+}
+
+//
+//
+int64_t vol_av_cache_bytes_used( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return 0; }
+  const vol_av_internal_t* p = info_ptr->_context_ptr;
+  int64_t sz                 = 0;
+  for ( int i = 0; i < p->cache_capacity; i++ ) {
+    if ( p->cache_pixels_ptrs[i] ) { sz += _frame_sz( p ); }
+  }
+  return sz;
+}
+
+//
+//
+int64_t vol_av_memory_used( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return 0; }
+  const vol_av_internal_t* p = info_ptr->_context_ptr;
+  int64_t w = p->codec_ctx_ptr->width, h = p->codec_ctx_ptr->height;
+  int64_t planes_sz = w * h + 2 * ( ( w + 1 ) / 2 ) * ( ( h + 1 ) / 2 );
+  int64_t sz        = planes_sz; // The decoded frame, assuming 4:2:0.
+  if ( p->output_frame_rgb_ptr && p->output_frame_rgb_ptr->data[0] ) { sz += (int64_t)p->output_frame_rgb_ptr->linesize[0] * h; }
+  if ( p->planes_conv_frame_ptr ) { sz += planes_sz; }
+  if ( p->rgba_ptr ) { sz += w * h * 4; }
+  sz += vol_av_cache_bytes_used( info_ptr );
+  sz += p->cache_capacity * (int64_t)( sizeof( uint8_t* ) + sizeof( int64_t ) + sizeof( bool ) + sizeof( uint64_t ) );
+  return sz;
+}
+
+//
+//
+bool vol_av_set_output_format( vol_av_video_t* info_ptr, vol_av_output_format_t format ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || format < VOL_AV_OUTPUT_RGB24 || format > VOL_AV_OUTPUT_RGBA32 ) { return false; }
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  if ( format == p->output_format ) { return true; }
+
+  _free_cache( p ); // Slots are sized for the previous format.
+  p->output_format     = format;
+  p->plane_layout      = VOL_AV_PLANES_NONE;
+  info_ptr->pixels_ptr = NULL;
+  _clear_output_planes( info_ptr );
+  memset( p->planes_ptrs, 0, sizeof( p->planes_ptrs ) );
+  av_frame_unref( p->planes_frame_ptr );
+  // The decoder's output frame still holds the frame last decoded, unless a read since then found no new frame.
+  if ( p->output_frame_ptr->data[0] ) { _convert_frame( info_ptr ); }
+  return true;
+}
+
+//
+//
+int64_t vol_av_decoded_frame_idx( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return -1; }
+  return info_ptr->_context_ptr->decoded_frame_idx;
+}
+
 //
 //
 void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
@@ -442,3 +1394,44 @@ void vol_av_set_log_callback( void ( *user_function_ptr )( vol_av_log_type_t log
 //
 //
 void vol_av_reset_log_callback( void ) { _logger_ptr = _default_logger; }
+
+//
+//
+void vol_av_set_parallel_for_callback( vol_av_parallel_for_fn_t user_function_ptr ) { _parallel_for_ptr = user_function_ptr ? user_function_ptr : _default_parallel_for; }
+
+//
+//
+void vol_av_reset_parallel_for_callback( void ) { _parallel_for_ptr = _default_parallel_for; }
+
+//
+//
+bool vol_av_yuv420_to_rgba( const uint8_t* const planes_ptrs[3], const int plane_strides[3], vol_av_plane_layout_t layout, int w, int h, bool full_range,
+  bool bt709, uint8_t* dst_ptr, int dst_stride ) {
+  if ( !planes_ptrs || !plane_strides || !dst_ptr || w <= 0 || h <= 0 || dst_stride < w * 4 ) { return false; }
+  if ( !planes_ptrs[0] || !planes_ptrs[1] || ( VOL_AV_PLANES_I420 == layout && !planes_ptrs[2] ) ) { return false; }
+  if ( VOL_AV_PLANES_I420 != layout && VOL_AV_PLANES_NV12 != layout ) { return false; }
+
+  vol_av_convert_job_t job = { .planes_ptrs = planes_ptrs, .plane_strides = plane_strides, .nv12 = VOL_AV_PLANES_NV12 == layout, .w = w, .h = h,
+    .rows_per_job = VOL_AV_CONVERT_JOB_ROWS, .coeffs_ptr = &_yuv_coeffs[bt709 ? 1 : 0][full_range ? 1 : 0], .dst_ptr = dst_ptr, .dst_stride = dst_stride };
+  int n_jobs = ( h + job.rows_per_job - 1 ) / job.rows_per_job;
+  if ( n_jobs > VOL_AV_MAX_CONVERT_JOBS ) {
+    job.rows_per_job = ( ( h + VOL_AV_MAX_CONVERT_JOBS - 1 ) / VOL_AV_MAX_CONVERT_JOBS + 1 ) & ~1; // Even, so no chroma row is split between jobs.
+    n_jobs           = ( h + job.rows_per_job - 1 ) / job.rows_per_job;
+  }
+  _parallel_for_ptr( n_jobs, _convert_job, &job );
+  return true;
+}
+
+//
+//
+bool vol_av_downsample_2x2( const uint8_t* src_ptr, int src_stride, int w, int h, int n_channels, uint8_t* dst_ptr, int dst_stride ) {
+  if ( !src_ptr || !dst_ptr || w <= 0 || h <= 0 || ( 1 != n_channels && 2 != n_channels && 4 != n_channels ) ) { return false; }
+  int dst_w = w > 1 ? w / 2 : 1, dst_h = h > 1 ? h / 2 : 1;
+  if ( src_stride < w * n_channels || dst_stride < dst_w * n_channels ) { return false; }
+
+  vol_av_downsample_job_t job = { .src_ptr = src_ptr, .src_stride = src_stride, .src_w = w, .src_h = h, .n_channels = n_channels, .dst_ptr = dst_ptr,
+    .dst_stride = dst_stride, .dst_w = dst_w, .dst_h = dst_h, .rows_per_job = VOL_AV_CONVERT_JOB_ROWS };
+  if ( dst_h > VOL_AV_CONVERT_JOB_ROWS * VOL_AV_MAX_CONVERT_JOBS ) { job.rows_per_job = ( dst_h + VOL_AV_MAX_CONVERT_JOBS - 1 ) / VOL_AV_MAX_CONVERT_JOBS; }
+  _parallel_for_ptr( ( dst_h + job.rows_per_job - 1 ) / job.rows_per_job, _downsample_job, &job );
+  return true;
+}
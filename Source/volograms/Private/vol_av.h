@@ -3,7 +3,7 @@
  *
  * vol_av    | Audio-Video Decoding API
  * --------- | ----------
- * Version   | 0.9
+ * Version   | 0.18
  * Authors   | Anton Gerdelan <anton@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -14,9 +14,7 @@
  * Current Limitations
  * -----------
  * * Only video is currently processed, audio is ignored.
- * * Seek frame is not implemented.
- * * Reverse play is not implemented.
- * * Network streaming is not implemented.
+ * * Network streaming relies on the protocols FFmpeg was built with, such as http and https.
  *
  * References
  * -----------
@@ -24,6 +22,19 @@
  *
  * History
  * -----------
+ * - 0.18.0 (2026/10/19) - vol_av_memory_used() and vol_av_cache_bytes_used() to account for the memory held by an open video, and vol_av_resize_cache()
+ *                         to change the cache's budget, evicting least recently used frames, without emptying it.
+ * - 0.17.0 (2026/10/19) - vol_av_downsample_2x2() halves images with a SIMD box filter in parallel jobs, to build mip chains for video textures.
+ * - 0.16.0 (2026/10/19) - `key_frame` says whether the frame given is a keyframe, e.g. to switch between renditions of a video there.
+ * - 0.15.0 (2026/10/19) - RGBA output, converted from 4:2:0 video by a SIMD kernel in parallel jobs. vol_av_set_parallel_for_callback() to run them
+ *                         on the application's worker threads.
+ * - 0.14.0 (2026/10/19) - vol_av_set_output_format() to get the decoder's YUV planes instead of RGB, to convert colour on the GPU.
+ * - 0.13.0 (2026/10/19) - vol_av_open_io() and vol_av_open_memory() read videos through application callbacks or from memory, with a configurable
+ *                         read buffer size. vol_av_open() now cleans up after itself when it fails.
+ * - 0.12.0 (2026/10/19) - vol_av_open() accepts URLs, read progressively with range requests.
+ * - 0.11.0 (2026/10/19) - vol_av_cache_frame() to decode frames ahead of time, e.g. around the playhead on a worker thread.
+ * - 0.10.0 (2026/10/19) - Frame seeking and random access with vol_av_seek_frame() and vol_av_read_frame(), with a bounded cache of decoded frames
+ *                         so that reverse playback decodes each GOP once.
  * - 0.9.0 (2022/03/23) - Added log reset from Unity plugin, multithreaded decoding, and tidied docs.
  * - 0.8.0 (2021/01/20) - Added customisable debug callback.
  * - 0.7.1 (2021/12/10) - Tidied comments.
@@ -55,6 +66,20 @@ extern "C" {
 /** Forward-declaration of internal video context struct type. */
 VOL_AV_EXPORT typedef struct vol_av_internal_t vol_av_internal_t;
 
+/** What a decoded frame is given to the application as. */
+typedef enum vol_av_output_format_t {
+  VOL_AV_OUTPUT_RGB24 = 0,     ///< Converted to RGB on the CPU, in `pixels_ptr`. The default.
+  VOL_AV_OUTPUT_YUV420_PLANES, ///< The decoder's own 4:2:0 planes, in `planes_ptrs`, for colour conversion on the GPU. Other formats are converted to 4:2:0.
+  VOL_AV_OUTPUT_RGBA32,        ///< Converted to tightly-packed RGBA on the CPU, in `pixels_ptr`, ready to copy into a texture. Uses vol_av_yuv420_to_rgba().
+} vol_av_output_format_t;
+
+/** Layout of the planes in `planes_ptrs`. Chroma planes are ( w + 1 ) / 2 by ( h + 1 ) / 2 samples. */
+typedef enum vol_av_plane_layout_t {
+  VOL_AV_PLANES_NONE = 0, ///< No planes. The output format is RGB, or no frame has been decoded.
+  VOL_AV_PLANES_I420,     ///< 3 planes: Y, U, and V, 1 byte per sample.
+  VOL_AV_PLANES_NV12,     ///< 2 planes: Y, and interleaved U and V, 2 bytes per chroma sample. Usual from hardware decoders.
+} vol_av_plane_layout_t;
+
 /** Context variables for an opened video stream.
 Have one copy of this struct in your app per opened mp4 file.
 Zero the memory for instances of this struct before use.
@@ -63,10 +88,23 @@ VOL_AV_EXPORT typedef struct vol_av_video_t {
   /** Internal context state. Must start == NULL. Should not need to be accessed by the application. */
   vol_av_internal_t* _context_ptr;
 
-  /** Pointer to decoded frame's tightly-packed 3-channel RGB image data. */
+  /** Pointer to decoded frame's tightly-packed 3-channel RGB image data, or 4-channel RGBA with `VOL_AV_OUTPUT_RGBA32`. */
   uint8_t* pixels_ptr;
-  /** Dimensions of image in `pixels_ptr`. */
+  /** Dimensions of image in `pixels_ptr`, or of the Y plane. */
   int w, h;
+
+  /** Decoded frame's planes, with `VOL_AV_OUTPUT_YUV420_PLANES`. Unused planes are NULL.
+   * Rows are `plane_strides` bytes apart, which may be more than a row's size. */
+  const uint8_t* planes_ptrs[3];
+  int plane_strides[3];
+  vol_av_plane_layout_t plane_layout;
+  /** True if samples use the full 0-255 range, rather than 16-235 for Y and 16-240 for U and V. */
+  bool full_range;
+  /** True if the video is tagged as using BT.709 colours, usual for HD video. Otherwise use BT.601, as FFmpeg does when converting to RGB. */
+  bool bt709;
+  /** True if the frame given is a keyframe, which decodes without the frames before it. Renditions of a video with the same keyframes can be swapped
+   * here: open the other rendition and `vol_av_read_frame()` this frame from it, which seeks straight to it. */
+  bool key_frame;
 } vol_av_video_t;
 
 /** In your application these enum values can be used to filter out or categorise messages given by vol_av_log_callback. */
@@ -82,6 +120,34 @@ VOL_AV_EXPORT void vol_av_set_log_callback( void ( *user_function_ptr )( vol_av_
 
 VOL_AV_EXPORT void vol_av_reset_log_callback( void );
 
+/** A function that calls `job_fn( job_ctx_ptr, job_idx )` once for every job_idx from 0 to job_count-1, in any order and on any threads,
+ * and only returns once every job has completed. Jobs never write to the same memory, so they need no locking.
+ */
+typedef void ( *vol_av_parallel_for_fn_t )( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr );
+
+/** Set the function used to spread colour conversion over worker threads. Engines should point this at their own job system.
+ * The default runs each job in turn on the calling thread.
+ */
+VOL_AV_EXPORT void vol_av_set_parallel_for_callback( vol_av_parallel_for_fn_t user_function_ptr );
+VOL_AV_EXPORT void vol_av_reset_parallel_for_callback( void );
+
+/** Callbacks for reading a video from somewhere other than a file path, e.g. an engine archive. Every callback is given `user_ptr`. */
+VOL_AV_EXPORT typedef struct vol_av_io_t {
+  /** Reads up to `buf_sz` bytes from the current position into `buf_ptr`, and advances the position. Returns the number of bytes read, 0 at the end of the
+   * file, or -1 on error. Must not be NULL. */
+  int ( *read_fn )( void* user_ptr, uint8_t* buf_ptr, int buf_sz );
+  /** Moves the position to `offset` bytes from the start of the file. Returns false on error. If NULL, the video can only be read from start to end,
+   * which most MP4 files don't allow. */
+  bool ( *seek_fn )( void* user_ptr, int64_t offset );
+  /** Returns the size of the file in bytes, or -1 if it isn't known. May be NULL. */
+  int64_t ( *size_fn )( void* user_ptr );
+  /** Called once the video is closed, or if opening it fails, to release `user_ptr`. May be NULL. */
+  void ( *close_fn )( void* user_ptr );
+  void* user_ptr;
+  /** Size of the buffer FFmpeg reads through, and so of most calls to `read_fn`. Match it to the storage's block size. 0 for a 64kB default. */
+  int buffer_sz;
+} vol_av_io_t;
+
 /** Open a video file given by `filename`.
  * @param filename File path to the movie file to open. Must not be NULL.
  * @param info_ptr This function populates the struct pointed to with context data about the file. Must not be NULL.
@@ -89,6 +155,22 @@ VOL_AV_EXPORT void vol_av_reset_log_callback( void );
  */
 VOL_AV_EXPORT bool vol_av_open( const char* filename, vol_av_video_t* info_ptr );
 
+/** Open a video read through application callbacks.
+ * @param io_ptr   Callbacks to read the file with. The struct is copied. `close_fn` is called by `vol_av_close()`, or before this function returns false.
+ * @param info_ptr This function populates the struct pointed to with context data about the file. Must not be NULL, and _context_ptr must be NULL.
+ * @return         False on error.
+ */
+VOL_AV_EXPORT bool vol_av_open_io( const vol_av_io_t* io_ptr, vol_av_video_t* info_ptr );
+
+/** Open a video file that is already in memory, e.g. shared with something else that has loaded or downloaded it.
+ * @param data_ptr  Contents of the file. Not copied, so it must stay valid until `vol_av_close()`. Must not be NULL.
+ * @param sz        Size of the file in bytes.
+ * @param buffer_sz As `vol_av_io_t.buffer_sz`.
+ * @param info_ptr  This function populates the struct pointed to with context data about the file. Must not be NULL, and _context_ptr must be NULL.
+ * @return          False on error.
+ */
+VOL_AV_EXPORT bool vol_av_open_memory( const void* data_ptr, int64_t sz, int buffer_sz, vol_av_video_t* info_ptr );
+
 /** Close a video file.
  * @param info_ptr The context data for the file to close. Must not be NULL.
  * @return         False on error.
@@ -143,6 +225,93 @@ while ( next_frame > frame ) {
 */
 VOL_AV_EXPORT bool vol_av_read_next_frame( vol_av_video_t* info_ptr );
 
+/** Seek to a frame and decode it. This seeks to the keyframe at or before `frame_idx` and decodes forward, keeping the frames decoded on the way
+ * in a cache (see `vol_av_set_cache_budget()`), so that `vol_av_read_frame()` can then step backwards through the GOP without decoding again.
+ * @param info_ptr  The context data for the file. Must not be NULL.
+ * @param frame_idx Index of the frame to decode, starting at 0. Frame indices are found from timestamps and the stream's average frame rate.
+ * @return          False on error. If the stream ends before `frame_idx`, the last frame is decoded and this returns true.
+ */
+VOL_AV_EXPORT bool vol_av_seek_frame( vol_av_video_t* info_ptr, int64_t frame_idx );
+
+/** Make `pixels_ptr`, or `planes_ptrs`, point to the image of any frame, in any order. Use this for reverse, ping-pong, and scrubbed playback.
+ * Frames in the cache are returned without decoding, the frame after the last decoded frame is read with `vol_av_read_next_frame()`,
+ * and anything else is found with `vol_av_seek_frame()`. Playing backwards therefore decodes each GOP once, if the cache can hold a GOP.
+ * @param info_ptr  The context data for the file. Must not be NULL.
+ * @param frame_idx Index of the frame, starting at 0.
+ * @return          False on error.
+ * @note            `pixels_ptr` and `planes_ptrs` may point into the cache, so are only valid until the next call to a vol_av function with this `info_ptr`.
+ */
+VOL_AV_EXPORT bool vol_av_read_frame( vol_av_video_t* info_ptr, int64_t frame_idx );
+
+/** Decode a frame into the cache, if it isn't already cached, so that a later `vol_av_read_frame()` for it returns without decoding.
+ * Call this for the frames around the playhead, in increasing order, to warm the cache for scrubbing. This changes `pixels_ptr`.
+ * @param info_ptr  The context data for the file. Must not be NULL.
+ * @param frame_idx Index of the frame, starting at 0.
+ * @return          False on error.
+ * @note            A vol_av_video_t is not thread-safe. If this is called on a worker thread then all calls using the same `info_ptr` must hold the same lock,
+ *                  including any use of `pixels_ptr`.
+ */
+VOL_AV_EXPORT bool vol_av_cache_frame( vol_av_video_t* info_ptr, int64_t frame_idx );
+
+/** Choose whether decoded frames are converted to RGB, or given as the decoder's YUV planes. Planes are 1.5 bytes per pixel instead of 3,
+ * and skip the CPU colour conversion, leaving that to a shader. Empties the frame cache. The frame last decoded, if any, is given again in the new format.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @param format   Output format for this and subsequent frames. With planes, `pixels_ptr` is NULL.
+ * @return         False on error.
+ */
+VOL_AV_EXPORT bool vol_av_set_output_format( vol_av_video_t* info_ptr, vol_av_output_format_t format );
+
+/** Convert a 4:2:0 image to RGBA, as for `VOL_AV_OUTPUT_RGBA32`. Rows are converted in parallel jobs via the parallel-for callback, each using
+ * AVX2, SSE2, or NEON where the build targets them. Chroma isn't interpolated, matching swscale's unscaled conversion, and results are within a level of it.
+ * @param planes_ptrs   Y, U, and V planes, or Y and interleaved UV planes for NV12, as in `vol_av_video_t`. Must not be NULL.
+ * @param plane_strides Bytes between the rows of each plane.
+ * @param layout        VOL_AV_PLANES_I420 or VOL_AV_PLANES_NV12.
+ * @param full_range    As `vol_av_video_t.full_range`.
+ * @param bt709         As `vol_av_video_t.bt709`.
+ * @param dst_ptr       RGBA image to write, `h` rows of `dst_stride` bytes. Must not be NULL.
+ * @param dst_stride    Bytes between rows of `dst_ptr`. At least w * 4.
+ * @return              False if a parameter is invalid.
+ */
+VOL_AV_EXPORT bool vol_av_yuv420_to_rgba( const uint8_t* const planes_ptrs[3], const int plane_strides[3], vol_av_plane_layout_t layout, int w, int h,
+  bool full_range, bool bt709, uint8_t* dst_ptr, int dst_stride );
+
+/** Halve an image with a 2x2 box filter, as for the next level of a mip chain. The result is max( w / 2, 1 ) by max( h / 2, 1 ) pixels, and an odd last
+ * row or column is left out. Rows are filtered in parallel jobs via the parallel-for callback, each using SSE2 or NEON where the build targets them.
+ * Channels are averaged as stored, so sRGB colours aren't linearised first.
+ * @param src_ptr    Image to halve, `h` rows of `src_stride` bytes. Must not be NULL.
+ * @param n_channels Bytes per pixel: 1, 2, or 4.
+ * @param dst_ptr    Image to write, with rows `dst_stride` bytes apart. Must not be NULL, and must not overlap `src_ptr`.
+ * @return           False if a parameter is invalid.
+ */
+VOL_AV_EXPORT bool vol_av_downsample_2x2( const uint8_t* src_ptr, int src_stride, int w, int h, int n_channels, uint8_t* dst_ptr, int dst_stride );
+
+/** Set the memory budget for the decoded frame cache used by `vol_av_seek_frame()` and `vol_av_read_frame()`. Empties the cache.
+ * The default is 256MB. For reverse playback without repeated decoding the cache should hold one GOP of frames (width * height * 3 bytes each,
+ * 4 with RGBA, or 1.5 with YUV planes).
+ * @param info_ptr  The context data for the file. Must not be NULL.
+ * @param max_bytes Memory budget in bytes. 0 disables the cache.
+ */
+VOL_AV_EXPORT void vol_av_set_cache_budget( vol_av_video_t* info_ptr, int64_t max_bytes );
+
+/** @return The bytes of memory held for a video: the frame last decoded, its conversion to the output format, and the decoded frame cache.
+ * FFmpeg's own buffers for reference frames and file I/O are not included. 0 if `info_ptr` is NULL or not open.
+ */
+VOL_AV_EXPORT int64_t vol_av_memory_used( const vol_av_video_t* info_ptr );
+
+/** @return The bytes of decoded frames held in the cache. 0 if `info_ptr` is NULL or not open. */
+VOL_AV_EXPORT int64_t vol_av_cache_bytes_used( const vol_av_video_t* info_ptr );
+
+/** Changes the memory budget for the decoded frame cache, as `vol_av_set_cache_budget()` does, but keeps the most recently used frames that fit in
+ * it, e.g. to stay within an application's memory budget without decoding the frames around the playhead again.
+ * @param info_ptr  The context data for the file. Must not be NULL.
+ * @param max_bytes Memory budget in bytes. 0 empties and disables the cache.
+ * @return          The bytes of cached frames freed.
+ */
+VOL_AV_EXPORT int64_t vol_av_resize_cache( vol_av_video_t* info_ptr, int64_t max_bytes );
+
+/** @return The index of the frame most recently decoded, or -1 if none has been decoded yet. */
+VOL_AV_EXPORT int64_t vol_av_decoded_frame_idx( const vol_av_video_t* info_ptr );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
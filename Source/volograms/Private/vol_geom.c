@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.10
+ * Version   | 0.22.3
  * Authors   | See matching header file.
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -11,25 +11,80 @@
  * Licence   | The MIT License. See LICENSE.md for details.
  */
 
+#if defined( __STRICT_ANSI__ ) && !defined( _WIN32 ) && !defined( __APPLE__ ) && !defined( _POSIX_C_SOURCE )
+#define _POSIX_C_SOURCE 200809L // fseeko(), getaddrinfo(), and friends in strict -std=c99 builds.
+#endif
 #include "vol_geom.h"
 #include <assert.h>
+#include <ctype.h>
+#include <errno.h>
 #include <inttypes.h> // 64-bit printfs (PRId64 for integer, PRIu64 for unsigned int, PRIx64 for hex)
+#include <math.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h> // Used for reading file sizes.
 #include <sys/types.h>
+#ifndef _WIN32
+#include <fcntl.h> // open() for the pread backend.
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define VOL_GEOM_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( _M_ARM64 )
+#define VOL_GEOM_NEON
+#include <arm_neon.h>
+#endif
+
+// Sockets, for reading sequences from http:// URLs.
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment( lib, "ws2_32.lib" )
+#endif
+typedef SOCKET vol_geom_socket_t;
+#define VOL_GEOM_INVALID_SOCKET INVALID_SOCKET
+#define vol_geom_closesocket closesocket
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+typedef int vol_geom_socket_t;
+#define VOL_GEOM_INVALID_SOCKET ( -1 )
+#define vol_geom_closesocket close
+#endif
+// Lock held for each request on a URL's one connection, so that several threads can read the same URL.
+#ifdef _WIN32
+typedef CRITICAL_SECTION vol_geom_mutex_t;
+#define vol_geom_mutex_init( mutex_ptr ) InitializeCriticalSection( mutex_ptr )
+#define vol_geom_mutex_lock( mutex_ptr ) EnterCriticalSection( mutex_ptr )
+#define vol_geom_mutex_unlock( mutex_ptr ) LeaveCriticalSection( mutex_ptr )
+#define vol_geom_mutex_destroy( mutex_ptr ) DeleteCriticalSection( mutex_ptr )
+#else
+#include <pthread.h>
+typedef pthread_mutex_t vol_geom_mutex_t;
+#define vol_geom_mutex_init( mutex_ptr ) pthread_mutex_init( mutex_ptr, NULL )
+#define vol_geom_mutex_lock( mutex_ptr ) pthread_mutex_lock( mutex_ptr )
+#define vol_geom_mutex_unlock( mutex_ptr ) pthread_mutex_unlock( mutex_ptr )
+#define vol_geom_mutex_destroy( mutex_ptr ) pthread_mutex_destroy( mutex_ptr )
+#endif
+#ifdef MSG_NOSIGNAL
+#define VOL_GEOM_SEND_FLAGS MSG_NOSIGNAL // Don't raise SIGPIPE if the server has closed the connection.
+#else
+#define VOL_GEOM_SEND_FLAGS 0
+#endif
 
 // NOTE: ftello() and fseeko() are replace ftell(), fseek(), and their Windows equivalents, to support 64-bit indices to >2GB files.
 #ifdef _WIN32
-#define vol_geom_stat64 _stat64
-#define vol_geom_stat64_t __stat64
 #define vol_geom_fseeko _fseeki64
 #define vol_geom_ftello _ftelli64
 #else
-#define vol_geom_stat64 stat
-#define vol_geom_stat64_t stat
 #define vol_geom_fseeko fseeko
 #define vol_geom_ftello ftello
 #endif
@@ -39,75 +94,1638 @@
 #define VOL_GEOM_FILE_HDR_V10_MIN_SZ 24 /// "VOLS" (4 bytes) + 4 string length bytes + 4 ints in v10 hdr.
 /// File header section size in bytes. Used in sanity checks to test for corrupted files that are below minimum sizes expected.
 #define VOL_GEOM_FRAME_MIN_SZ 17 /// 3 ints, 1 byte, 1 int inside vertices array. the rest are optional
+/// Vertices, normals, indices, UVs, texture.
+#define VOL_GEOM_MAX_FRAME_STREAMS 5
+/// Enough decode jobs for one job per byte plane of every stream in a frame.
+#define VOL_GEOM_MAX_DECODE_JOBS ( VOL_GEOM_MAX_FRAME_STREAMS * 4 )
+/// Floats per job when expanding 16-bit words back to floats. Big enough that job overhead is small.
+/// A multiple of 12, so every job starts on a whole vertex of 2, 3 or 4-channel arrays, with channels in the same SIMD lanes.
+#define VOL_GEOM_RECONSTRUCT_JOB_FLOATS ( 12 * 4096 )
+/// Largest number of jobs used to expand the quantized streams of one frame.
+#define VOL_GEOM_MAX_RECONSTRUCT_JOBS 64
+/// Triangles or vertices per job when generating normals.
+#define VOL_GEOM_NORMALS_JOB_ELEMENTS 16384
+/// Reads smaller than this fetch a whole block, so that e.g. the frame headers and stream headers read while scanning a frame need one I/O request.
+#define VOL_GEOM_READ_BLOCK_SZ ( 16 * 1024 )
+/// Largest chunk table accepted in a bundle. Bundles have 2 or 3 chunks; the rest is room for later chunk types.
+#define VOL_GEOM_BUNDLE_MAX_CHUNKS 64
+/// Largest HTTP response header accepted.
+#define VOL_GEOM_HTTP_MAX_HDR_SZ 8192
+/// Seconds to wait for a HTTP server to send or receive before giving up on a request.
+#define VOL_GEOM_HTTP_TIMEOUT_S 10
+/// Bytes fetched per request while scanning the frame headers of a sequence over HTTP. Large, so that one request covers the headers of many frames.
+#define VOL_GEOM_HTTP_SCAN_READ_SZ ( 4 * 1024 * 1024 )
+
+static void _default_logger( vol_geom_log_type_t log_type, const char* message_str ) {
+  FILE* stream_ptr = ( VOL_GEOM_LOG_TYPE_ERROR == log_type || VOL_GEOM_LOG_TYPE_WARNING == log_type ) ? stderr : stdout;
+  fprintf( stream_ptr, "%s", message_str );
+}
+
+static void ( *_logger_ptr )( vol_geom_log_type_t log_type, const char* message_str ) = _default_logger;
+
+static void _default_parallel_for( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr ) {
+  for ( int i = 0; i < job_count; i++ ) { job_fn( job_ctx_ptr, i ); }
+}
+
+static vol_geom_parallel_for_fn_t _parallel_for_ptr = _default_parallel_for;
+
+// This function is used in this file as a printf-style logger. It converts that format to a simple string and passes it to _logger_ptr.
+static void _vol_loggerf( vol_geom_log_type_t log_type, const char* message_str, ... ) {
+  char log_str[VOL_GEOM_LOG_STR_MAX_LEN];
+  log_str[0] = '\0';
+  va_list arg_ptr; // using va_args lets us make sure any printf-style formatting values are properly written into the string.
+  va_start( arg_ptr, message_str );
+  vsnprintf( log_str, VOL_GEOM_LOG_STR_MAX_LEN - 1, message_str, arg_ptr );
+  va_end( arg_ptr );
+  _logger_ptr( log_type, log_str );
+}
+
+/// Helper struct to refer to an entire file loaded from disk via `_read_entire_file()`.
+typedef struct vol_geom_file_record_t {
+  /// Pointer to contents of file.
+  uint8_t* byte_ptr;
+  /// Size of file in bytes.
+  vol_geom_size_t sz;
+} vol_geom_file_record_t;
+
+/******************************************************************************
+  STREAM CODECS
+******************************************************************************/
+
+/// One unit of work when decoding a compressed frame: a whole stream, or a single byte plane of a VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE stream.
+typedef struct vol_geom_decode_job_t {
+  const uint8_t* src_ptr;
+  vol_geom_size_t src_sz;
+  /// Start of the stream's decoded array. Plane jobs write every word_sz'th byte from dst_ptr[plane_idx].
+  uint8_t* dst_ptr;
+  vol_geom_size_t dst_sz;
+  vol_geom_stream_hdr_t stream_hdr;
+  int plane_idx;
+  /// Written by the job.
+  bool succeeded;
+} vol_geom_decode_job_t;
+
+/// Decoding state for sequences that use VOL_GEOM_STREAM_CODEC_DELTA_Q16 or any other codec that stores 16-bit words.
+struct vol_geom_decoder_state_t {
+  /// True if any stream is predicted from the previous frame, so frames must be decoded in order from a keyframe.
+  bool predicted;
+  /// Decoded vertices [0] and normals [1] of frame reference_frame_idx, which the next tracked frame is predicted from.
+  float* reference_ptrs[2];
+  vol_geom_size_t reference_szs[2];
+  /// Frame held in reference_ptrs, or -1 if none.
+  int reference_frame_idx;
+  /// 16-bit words of the frame being decoded, before they are expanded to floats.
+  int16_t* scratch_ptr;
+  vol_geom_size_t scratch_sz;
+};
+
+/// A range of floats to expand from 16-bit words decoded by the plane jobs.
+typedef struct vol_geom_reconstruct_job_t {
+  /// VOL_GEOM_STREAM_CODEC_DELTA_Q16, _UNORM16, _OCT16 or _HALF.
+  uint8_t codec;
+  /// First word of this range. OCT16 has 2 words per 3 floats, the others 1 word per float.
+  const int16_t* q_ptr;
+  /// DELTA_Q16 only: the previous frame's array and the quantization step.
+  const float* reference_ptr;
+  float step;
+  /// UNORM16 only: minimum of each channel, then maximum of each channel.
+  float bounds[8];
+  int channels;
+  float* dst_ptr;
+  vol_geom_size_t n_floats;
+} vol_geom_reconstruct_job_t;
+
+/** Reconstruction kernel for VOL_GEOM_STREAM_CODEC_DELTA_Q16: dst[i] = reference[i] + q[i] * step.
+ * The encoder reconstructs with this same function, so that it predicts from exactly what a player will decode. `dst_ptr` may equal `reference_ptr`.
+ */
+static void _dequantize_add_i16( const float* reference_ptr, const int16_t* q_ptr, float step, float* dst_ptr, vol_geom_size_t n_floats ) {
+  vol_geom_size_t i = 0;
+#if defined( VOL_GEOM_SSE2 )
+  const __m128 step4 = _mm_set1_ps( step );
+  for ( ; i + 8 <= n_floats; i += 8 ) {
+    __m128i q  = _mm_loadu_si128( (const __m128i*)&q_ptr[i] );
+    __m128i lo = _mm_srai_epi32( _mm_unpacklo_epi16( q, q ), 16 ); // sign-extend to 32 bits.
+    __m128i hi = _mm_srai_epi32( _mm_unpackhi_epi16( q, q ), 16 );
+    _mm_storeu_ps( &dst_ptr[i], _mm_add_ps( _mm_loadu_ps( &reference_ptr[i] ), _mm_mul_ps( _mm_cvtepi32_ps( lo ), step4 ) ) );
+    _mm_storeu_ps( &dst_ptr[i + 4], _mm_add_ps( _mm_loadu_ps( &reference_ptr[i + 4] ), _mm_mul_ps( _mm_cvtepi32_ps( hi ), step4 ) ) );
+  }
+#elif defined( VOL_GEOM_NEON )
+  const float32x4_t step4 = vdupq_n_f32( step );
+  for ( ; i + 8 <= n_floats; i += 8 ) {
+    int16x8_t q    = vld1q_s16( &q_ptr[i] );
+    float32x4_t lo = vcvtq_f32_s32( vmovl_s16( vget_low_s16( q ) ) );
+    float32x4_t hi = vcvtq_f32_s32( vmovl_s16( vget_high_s16( q ) ) );
+    vst1q_f32( &dst_ptr[i], vaddq_f32( vld1q_f32( &reference_ptr[i] ), vmulq_f32( lo, step4 ) ) );
+    vst1q_f32( &dst_ptr[i + 4], vaddq_f32( vld1q_f32( &reference_ptr[i + 4] ), vmulq_f32( hi, step4 ) ) );
+  }
+#endif
+  for ( ; i < n_floats; i++ ) {
+    float scaled = (float)q_ptr[i] * step;
+    dst_ptr[i]   = reference_ptr[i] + scaled;
+  }
+}
+
+/** Expansion kernel for VOL_GEOM_STREAM_CODEC_UNORM16: dst[i] = min[c] + q[i] * ( max[c] - min[c] ) / 65535, for channel c = i % channels.
+ * @param bounds_ptr Minimum of each channel, then maximum of each channel.
+ * @param channels   1 to 4. The first float must be channel 0.
+ */
+static void _dequantize_unorm16( const uint16_t* q_ptr, const float* bounds_ptr, int channels, float* dst_ptr, vol_geom_size_t n_floats ) {
+  // Channels repeat every 12 floats for any channel count up to 4, which is 3 SIMD registers.
+  float offset[12], scale[12];
+  for ( int k = 0; k < 12; k++ ) {
+    int c     = k % channels;
+    offset[k] = bounds_ptr[c];
+    scale[k]  = (float)( ( (double)bounds_ptr[channels + c] - bounds_ptr[c] ) / 65535.0 ); // Rounded once, not once per operation.
+  }
+  vol_geom_size_t i = 0;
+#if defined( VOL_GEOM_SSE2 )
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 o0 = _mm_loadu_ps( &offset[0] ), o1 = _mm_loadu_ps( &offset[4] ), o2 = _mm_loadu_ps( &offset[8] );
+  const __m128 s0 = _mm_loadu_ps( &scale[0] ), s1 = _mm_loadu_ps( &scale[4] ), s2 = _mm_loadu_ps( &scale[8] );
+  for ( ; i + 12 <= n_floats; i += 12 ) {
+    __m128i q01 = _mm_loadu_si128( (const __m128i*)&q_ptr[i] );
+    __m128i q2  = _mm_loadl_epi64( (const __m128i*)&q_ptr[i + 8] );
+    _mm_storeu_ps( &dst_ptr[i], _mm_add_ps( o0, _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( q01, zero ) ), s0 ) ) );
+    _mm_storeu_ps( &dst_ptr[i + 4], _mm_add_ps( o1, _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( q01, zero ) ), s1 ) ) );
+    _mm_storeu_ps( &dst_ptr[i + 8], _mm_add_ps( o2, _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( q2, zero ) ), s2 ) ) );
+  }
+#elif defined( VOL_GEOM_NEON )
+  const float32x4_t o0 = vld1q_f32( &offset[0] ), o1 = vld1q_f32( &offset[4] ), o2 = vld1q_f32( &offset[8] );
+  const float32x4_t s0 = vld1q_f32( &scale[0] ), s1 = vld1q_f32( &scale[4] ), s2 = vld1q_f32( &scale[8] );
+  for ( ; i + 12 <= n_floats; i += 12 ) {
+    uint16x8_t q01 = vld1q_u16( &q_ptr[i] );
+    uint16x4_t q2  = vld1_u16( &q_ptr[i + 8] );
+    vst1q_f32( &dst_ptr[i], vmlaq_f32( o0, vcvtq_f32_u32( vmovl_u16( vget_low_u16( q01 ) ) ), s0 ) );
+    vst1q_f32( &dst_ptr[i + 4], vmlaq_f32( o1, vcvtq_f32_u32( vmovl_u16( vget_high_u16( q01 ) ) ), s1 ) );
+    vst1q_f32( &dst_ptr[i + 8], vmlaq_f32( o2, vcvtq_f32_u32( vmovl_u16( q2 ) ), s2 ) );
+  }
+#endif
+  for ( ; i < n_floats; i++ ) {
+    float v = offset[i % 12] + (float)q_ptr[i] * scale[i % 12];
+    memcpy( &dst_ptr[i], &v, sizeof( float ) );
+  }
+}
+
+/** Nearest UNORM16 step to v over min to max. Computed in double, so the step picked is the nearest one, not one off near a half step. */
+static uint16_t _quantize_unorm16( float v, float min, float max ) {
+  if ( !( max > min ) ) { return 0; }
+  double q = ( (double)v - min ) / ( (double)max - min ) * 65535.0 + 0.5;
+  if ( !( q > 0.0 ) ) { return 0; } // Also catches NaN.
+  if ( q > 65535.0 ) { return 65535; }
+  return (uint16_t)q;
+}
+
+/** Octahedral encoding of a normal as two 16-bit SNORM values. The normal does not need to be unit length. */
+static void _encode_octahedral( const float* n_ptr, int16_t* q_ptr ) {
+  float ax = fabsf( n_ptr[0] ), ay = fabsf( n_ptr[1] ), az = fabsf( n_ptr[2] );
+  float l1 = ax + ay + az;
+  float u = 0.0f, v = 0.0f;
+  if ( l1 > 0.0f ) {
+    u = n_ptr[0] / l1;
+    v = n_ptr[1] / l1;
+    if ( n_ptr[2] < 0.0f ) { // Fold the lower hemisphere over the diagonals.
+      float fu = ( 1.0f - fabsf( v ) ) * ( u >= 0.0f ? 1.0f : -1.0f );
+      float fv = ( 1.0f - fabsf( u ) ) * ( v >= 0.0f ? 1.0f : -1.0f );
+      u        = fu;
+      v        = fv;
+    }
+  }
+  q_ptr[0] = (int16_t)lrintf( fminf( fmaxf( u, -1.0f ), 1.0f ) * 32767.0f );
+  q_ptr[1] = (int16_t)lrintf( fminf( fmaxf( v, -1.0f ), 1.0f ) * 32767.0f );
+}
+
+/** Inverse of _encode_octahedral(). Writes a unit-length normal. */
+static void _decode_octahedral( const int16_t* q_ptr, float* n_ptr ) {
+  float u = fmaxf( (float)q_ptr[0] / 32767.0f, -1.0f ), v = fmaxf( (float)q_ptr[1] / 32767.0f, -1.0f );
+  float z = 1.0f - fabsf( u ) - fabsf( v );
+  if ( z < 0.0f ) {
+    float fu = ( 1.0f - fabsf( v ) ) * ( u >= 0.0f ? 1.0f : -1.0f );
+    float fv = ( 1.0f - fabsf( u ) ) * ( v >= 0.0f ? 1.0f : -1.0f );
+    u        = fu;
+    v        = fv;
+  }
+  float len  = sqrtf( u * u + v * v + z * z );
+  float n[3] = { u / len, v / len, z / len };
+  memcpy( n_ptr, n, sizeof( n ) );
+}
+
+/** IEEE 754 float to half conversion, rounding to nearest even. Out-of-range values become infinity. */
+static uint16_t _float_to_half( float f ) {
+  uint32_t x = 0;
+  memcpy( &x, &f, sizeof( uint32_t ) );
+  uint32_t sign = x & 0x80000000u;
+  x ^= sign;
+  uint16_t h = 0;
+  if ( x >= ( 127u + 16u ) << 23 ) {
+    h = x > 0x7F800000u ? 0x7E00 : 0x7C00; // NaN stays NaN, everything else too big is infinity.
+  } else if ( x < 113u << 23 ) {
+    // Result is subnormal or zero: let float addition of 0.5 do the shifting and rounding.
+    float xf = 0.0f, magic = 0.5f;
+    uint32_t magic_bits = 0;
+    memcpy( &xf, &x, sizeof( float ) );
+    memcpy( &magic_bits, &magic, sizeof( uint32_t ) );
+    xf += magic;
+    memcpy( &x, &xf, sizeof( uint32_t ) );
+    h = (uint16_t)( x - magic_bits );
+  } else {
+    uint32_t mantissa_odd = ( x >> 13 ) & 1;
+    x += ( (uint32_t)( 15 - 127 ) << 23 ) + 0xFFF + mantissa_odd;
+    h = (uint16_t)( x >> 13 );
+  }
+  return (uint16_t)( h | ( sign >> 16 ) );
+}
+
+static float _half_to_float( uint16_t h ) {
+  const uint32_t shifted_exp = 0x7C00u << 13;
+  uint32_t o                 = ( (uint32_t)h & 0x7FFFu ) << 13;
+  uint32_t exp               = shifted_exp & o;
+  o += ( 127u - 15u ) << 23;
+  if ( exp == shifted_exp ) {
+    o += ( 128u - 16u ) << 23; // Infinity or NaN.
+  } else if ( 0 == exp ) {
+    // Subnormal: renormalise with a float subtraction.
+    float f = 0.0f, magic = 0.0f;
+    uint32_t magic_bits = 113u << 23;
+    o += 1u << 23;
+    memcpy( &f, &o, sizeof( float ) );
+    memcpy( &magic, &magic_bits, sizeof( float ) );
+    f -= magic;
+    memcpy( &o, &f, sizeof( uint32_t ) );
+  }
+  o |= ( (uint32_t)h & 0x8000u ) << 16;
+  float out = 0.0f;
+  memcpy( &out, &o, sizeof( float ) );
+  return out;
+}
+
+/** Expand one job's range of 16-bit words to floats, as the job's codec requires. Shared by the decoder and the encoders. */
+static void _expand_q16( const vol_geom_reconstruct_job_t* job_ptr ) {
+  switch ( job_ptr->codec ) {
+  case VOL_GEOM_STREAM_CODEC_DELTA_Q16: {
+    _dequantize_add_i16( job_ptr->reference_ptr, job_ptr->q_ptr, job_ptr->step, job_ptr->dst_ptr, job_ptr->n_floats );
+  } break;
+  case VOL_GEOM_STREAM_CODEC_UNORM16: {
+    _dequantize_unorm16( (const uint16_t*)job_ptr->q_ptr, job_ptr->bounds, job_ptr->channels, job_ptr->dst_ptr, job_ptr->n_floats );
+  } break;
+  case VOL_GEOM_STREAM_CODEC_OCT16: {
+    for ( vol_geom_size_t v = 0; v < job_ptr->n_floats / 3; v++ ) { _decode_octahedral( &job_ptr->q_ptr[v * 2], &job_ptr->dst_ptr[v * 3] ); }
+  } break;
+  case VOL_GEOM_STREAM_CODEC_HALF: {
+    const uint16_t* h_ptr = (const uint16_t*)job_ptr->q_ptr;
+    for ( vol_geom_size_t i = 0; i < job_ptr->n_floats; i++ ) {
+      float f = _half_to_float( h_ptr[i] );
+      memcpy( &job_ptr->dst_ptr[i], &f, sizeof( float ) );
+    }
+  } break;
+  default: break;
+  }
+}
+
+static void _reconstruct_job( void* job_ctx_ptr, int job_idx ) { _expand_q16( &( (vol_geom_reconstruct_job_t*)job_ctx_ptr )[job_idx] ); }
+
+/** Zero-run-length encode one byte plane of `src_ptr`, after predicting each byte from the same byte `channels` words earlier.
+ * Control byte c < 128 is followed by c+1 literal deltas. Control byte c >= 128 stands for c-127 zero deltas.
+ * @returns Bytes written to dst_ptr, or -1 if dst_max_sz was too small.
+ */
+static vol_geom_size_t _encode_rle_plane(
+  const uint8_t* src_ptr, vol_geom_size_t n_words, int word_sz, int channels, int plane_idx, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz ) {
+  vol_geom_size_t n_written = 0;
+  vol_geom_size_t i         = 0;
+#define _DELTA_AT( k ) ( (uint8_t)( src_ptr[(k)*word_sz + plane_idx] - ( ( k ) >= channels ? src_ptr[( (k)-channels ) * word_sz + plane_idx] : 0 ) ) )
+  while ( i < n_words ) {
+    vol_geom_size_t zeros = 0;
+    while ( i + zeros < n_words && zeros < 128 && 0 == _DELTA_AT( i + zeros ) ) { zeros++; }
+    if ( zeros >= 2 || ( zeros == 1 && i + 1 == n_words ) ) {
+      if ( n_written + 1 > dst_max_sz ) { return -1; }
+      dst_ptr[n_written++] = (uint8_t)( 127 + zeros );
+      i += zeros;
+      continue;
+    }
+    // Literal run until the next pair of zero deltas.
+    vol_geom_size_t lits = 0;
+    while ( i + lits < n_words && lits < 128 ) {
+      if ( i + lits + 1 < n_words && 0 == _DELTA_AT( i + lits ) && 0 == _DELTA_AT( i + lits + 1 ) ) { break; }
+      lits++;
+    }
+    if ( n_written + 1 + lits > dst_max_sz ) { return -1; }
+    dst_ptr[n_written++] = (uint8_t)( lits - 1 );
+    for ( vol_geom_size_t k = 0; k < lits; k++ ) { dst_ptr[n_written++] = _DELTA_AT( i + k ); }
+    i += lits;
+  }
+#undef _DELTA_AT
+  return n_written;
+}
+
+/// Inverse of _encode_rle_plane(). Writes every word_sz'th byte of dst_ptr starting at plane_idx.
+static bool _decode_rle_plane(
+  const uint8_t* src_ptr, vol_geom_size_t src_sz, vol_geom_size_t n_words, int word_sz, int channels, int plane_idx, uint8_t* dst_ptr ) {
+  vol_geom_size_t i = 0, k = 0;
+  uint8_t* out_ptr  = &dst_ptr[plane_idx];
+  while ( i < src_sz ) {
+    uint8_t c               = src_ptr[i++];
+    vol_geom_size_t run_len = c < 128 ? c + 1 : c - 127;
+    if ( k + run_len > n_words ) { return false; }
+    if ( c < 128 ) {
+      if ( i + run_len > src_sz ) { return false; }
+      for ( vol_geom_size_t r = 0; r < run_len; r++, k++ ) {
+        uint8_t pred         = k >= channels ? out_ptr[( k - channels ) * word_sz] : 0;
+        out_ptr[k * word_sz] = (uint8_t)( src_ptr[i++] + pred );
+      }
+    } else {
+      for ( vol_geom_size_t r = 0; r < run_len; r++, k++ ) { out_ptr[k * word_sz] = k >= channels ? out_ptr[( k - channels ) * word_sz] : 0; }
+    }
+  }
+  return k == n_words;
+}
+
+static vol_geom_size_t _encode_index_delta( const uint8_t* src_ptr, vol_geom_size_t n_words, int word_sz, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz ) {
+  vol_geom_size_t n_written = 0;
+  uint32_t prev             = 0;
+  for ( vol_geom_size_t i = 0; i < n_words; i++ ) {
+    uint32_t v = 0;
+    if ( 2 == word_sz ) {
+      uint16_t v16 = 0;
+      memcpy( &v16, &src_ptr[i * 2], sizeof( uint16_t ) );
+      v = v16;
+    } else {
+      memcpy( &v, &src_ptr[i * 4], sizeof( uint32_t ) );
+    }
+    int32_t delta = (int32_t)( v - prev );
+    uint32_t zz   = ( (uint32_t)delta << 1 ) ^ (uint32_t)( delta >> 31 );
+    prev          = v;
+    do {
+      if ( n_written >= dst_max_sz ) { return -1; }
+      dst_ptr[n_written++] = (uint8_t)( ( zz & 0x7F ) | ( zz > 0x7F ? 0x80 : 0 ) );
+      zz >>= 7;
+    } while ( zz );
+  }
+  return n_written;
+}
+
+static bool _decode_index_delta( const uint8_t* src_ptr, vol_geom_size_t src_sz, vol_geom_size_t n_words, int word_sz, uint8_t* dst_ptr ) {
+  vol_geom_size_t i = 0;
+  uint32_t prev     = 0;
+  for ( vol_geom_size_t k = 0; k < n_words; k++ ) {
+    uint32_t zz = 0;
+    for ( int shift = 0;; shift += 7 ) {
+      if ( i >= src_sz || shift > 28 ) { return false; }
+      uint8_t b = src_ptr[i++];
+      zz |= (uint32_t)( b & 0x7F ) << shift;
+      if ( !( b & 0x80 ) ) { break; }
+    }
+    prev += ( zz >> 1 ) ^ ( 0u - ( zz & 1 ) );
+    if ( 2 == word_sz ) {
+      uint16_t v16 = (uint16_t)prev;
+      prev         = v16;
+      memcpy( &dst_ptr[k * 2], &v16, sizeof( uint16_t ) );
+    } else {
+      memcpy( &dst_ptr[k * 4], &prev, sizeof( uint32_t ) );
+    }
+  }
+  return i == src_sz;
+}
+
+vol_geom_size_t vol_geom_encode_stream_bound( vol_geom_size_t src_sz, int word_sz ) {
+  // Worst cases: varints are 5 bytes per 4-byte word (3 per 2-byte word), or one control byte per 128 literal bytes in each plane.
+  return (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) + 4 * (vol_geom_size_t)sizeof( uint32_t ) + src_sz * 2 + ( word_sz > 0 ? word_sz : 1 ) * 2;
+}
+
+vol_geom_size_t vol_geom_encode_stream(
+  int codec, int word_sz, int channels, const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz ) {
+  if ( !dst_ptr || ( !src_ptr && src_sz > 0 ) || src_sz < 0 || src_sz > UINT32_MAX ) { return -1; }
+  if ( ( word_sz != 1 && word_sz != 2 && word_sz != 4 ) || channels < 1 || channels > 255 || src_sz % word_sz != 0 ) { return -1; }
+  if ( codec == VOL_GEOM_STREAM_CODEC_INDEX_DELTA && word_sz == 1 ) { return -1; }
+  if ( dst_max_sz < (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) ) { return -1; }
+
+  vol_geom_stream_hdr_t stream_hdr =
+    ( vol_geom_stream_hdr_t ){ .raw_sz = (uint32_t)src_sz, .codec = (uint8_t)codec, .word_sz = (uint8_t)word_sz, .channels = (uint8_t)channels };
+  memcpy( dst_ptr, &stream_hdr, sizeof( vol_geom_stream_hdr_t ) );
+  vol_geom_size_t n_written = (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t );
+  vol_geom_size_t n_words   = src_sz / word_sz;
+
+  switch ( codec ) {
+  case VOL_GEOM_STREAM_CODEC_RAW: {
+    if ( n_written + src_sz > dst_max_sz ) { return -1; }
+    if ( src_sz > 0 ) { memcpy( &dst_ptr[n_written], src_ptr, (size_t)src_sz ); }
+    return n_written + src_sz;
+  }
+  case VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE: {
+    // Table of encoded plane sizes, then the planes.
+    vol_geom_size_t table_offset = n_written;
+    n_written += word_sz * (vol_geom_size_t)sizeof( uint32_t );
+    if ( n_written > dst_max_sz ) { return -1; }
+    for ( int p = 0; p < word_sz; p++ ) {
+      vol_geom_size_t plane_sz = _encode_rle_plane( src_ptr, n_words, word_sz, channels, p, &dst_ptr[n_written], dst_max_sz - n_written );
+      if ( plane_sz < 0 ) { return -1; }
+      uint32_t plane_sz_u32 = (uint32_t)plane_sz;
+      memcpy( &dst_ptr[table_offset + p * sizeof( uint32_t )], &plane_sz_u32, sizeof( uint32_t ) );
+      n_written += plane_sz;
+    }
+    return n_written;
+  }
+  case VOL_GEOM_STREAM_CODEC_INDEX_DELTA: {
+    vol_geom_size_t encoded_sz = _encode_index_delta( src_ptr, n_words, word_sz, &dst_ptr[n_written], dst_max_sz - n_written );
+    if ( encoded_sz < 0 ) { return -1; }
+    return n_written + encoded_sz;
+  }
+  default: return -1;
+  }
+}
+
+/** Write a table of the two plane sizes, then the planes of a 16-bit word array coded as in VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE.
+ * @returns Bytes written to dst_ptr, or -1 if dst_max_sz was too small.
+ */
+static vol_geom_size_t _encode_q16_planes( const int16_t* q_ptr, vol_geom_size_t n_words, int channels, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz ) {
+  vol_geom_size_t n_written = 2 * (vol_geom_size_t)sizeof( uint32_t );
+  if ( n_written > dst_max_sz ) { return -1; }
+  for ( int p = 0; p < 2; p++ ) {
+    vol_geom_size_t plane_sz = _encode_rle_plane( (const uint8_t*)q_ptr, n_words, 2, channels, p, &dst_ptr[n_written], dst_max_sz - n_written );
+    if ( plane_sz < 0 ) { return -1; }
+    uint32_t plane_sz_u32 = (uint32_t)plane_sz;
+    memcpy( &dst_ptr[p * sizeof( uint32_t )], &plane_sz_u32, sizeof( uint32_t ) );
+    n_written += plane_sz;
+  }
+  return n_written;
+}
+
+vol_geom_size_t vol_geom_encode_delta_stream( float* reference_ptr, const float* src_ptr, vol_geom_size_t src_sz, int channels, float min_step,
+  uint8_t* dst_ptr, vol_geom_size_t dst_max_sz, float* max_error_ptr ) {
+  if ( !reference_ptr || !src_ptr || !dst_ptr || src_sz <= 0 || src_sz > UINT32_MAX || src_sz % sizeof( float ) != 0 ) { return -1; }
+  if ( channels < 1 || channels > 255 || !( min_step > 0.0f ) ) { return -1; }
+  vol_geom_size_t n_floats = src_sz / (vol_geom_size_t)sizeof( float );
+  vol_geom_size_t hdr_sz   = (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) + (vol_geom_size_t)sizeof( float ) + 2 * (vol_geom_size_t)sizeof( uint32_t );
+  if ( dst_max_sz < hdr_sz ) { return -1; }
+
+  // Widen the step if the largest difference would not fit in 16 bits.
+  float max_delta = 0.0f;
+  for ( vol_geom_size_t i = 0; i < n_floats; i++ ) {
+    float d = src_ptr[i] - reference_ptr[i];
+    if ( d < 0.0f ) { d = -d; }
+    if ( d > max_delta ) { max_delta = d; }
+  }
+  float step = min_step;
+  if ( max_delta / step > 32000.0f ) { step = max_delta / 32000.0f; }
+
+  int16_t* q_ptr = malloc( (size_t)( n_floats * sizeof( int16_t ) ) );
+  if ( !q_ptr ) { return -1; }
+  for ( vol_geom_size_t i = 0; i < n_floats; i++ ) {
+    float q = ( src_ptr[i] - reference_ptr[i] ) / step;
+    q       = q < 0.0f ? q - 0.5f : q + 0.5f; // Round to nearest.
+    if ( q > 32767.0f ) { q = 32767.0f; }
+    if ( q < -32768.0f ) { q = -32768.0f; }
+    q_ptr[i] = (int16_t)q;
+  }
+
+  vol_geom_stream_hdr_t stream_hdr =
+    ( vol_geom_stream_hdr_t ){ .raw_sz = (uint32_t)src_sz, .codec = VOL_GEOM_STREAM_CODEC_DELTA_Q16, .word_sz = 4, .channels = (uint8_t)channels };
+  memcpy( dst_ptr, &stream_hdr, sizeof( vol_geom_stream_hdr_t ) );
+  memcpy( &dst_ptr[sizeof( vol_geom_stream_hdr_t )], &step, sizeof( float ) );
+  vol_geom_size_t table_offset = (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) + (vol_geom_size_t)sizeof( float );
+  vol_geom_size_t planes_sz    = _encode_q16_planes( q_ptr, n_floats, channels, &dst_ptr[table_offset], dst_max_sz - table_offset );
+  if ( planes_sz < 0 ) {
+    free( q_ptr );
+    return -1;
+  }
+  vol_geom_size_t n_written = table_offset + planes_sz;
+
+  // Advance the reference exactly as a player will.
+  _dequantize_add_i16( reference_ptr, q_ptr, step, reference_ptr, n_floats );
+  if ( max_error_ptr ) {
+    float max_error = 0.0f;
+    for ( vol_geom_size_t i = 0; i < n_floats; i++ ) {
+      float e = src_ptr[i] - reference_ptr[i];
+      if ( e < 0.0f ) { e = -e; }
+      if ( e > max_error ) { max_error = e; }
+    }
+    *max_error_ptr = max_error;
+  }
+  free( q_ptr );
+  return n_written;
+}
+
+vol_geom_size_t vol_geom_encode_quantized_stream( int codec, const float* src_ptr, vol_geom_size_t src_sz, int channels, const float* bounds_ptr,
+  float* decoded_ptr, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz, float* max_error_ptr ) {
+  if ( !src_ptr || !dst_ptr || src_sz <= 0 || src_sz > UINT32_MAX || src_sz % sizeof( float ) != 0 || channels < 1 || channels > 4 ) { return -1; }
+  vol_geom_size_t n_floats  = src_sz / (vol_geom_size_t)sizeof( float );
+  vol_geom_size_t n_words   = n_floats;
+  vol_geom_size_t prefix_sz = 0;
+  switch ( codec ) {
+  case VOL_GEOM_STREAM_CODEC_UNORM16: {
+    if ( !bounds_ptr ) { return -1; }
+    prefix_sz = 2 * channels * (vol_geom_size_t)sizeof( float );
+  } break;
+  case VOL_GEOM_STREAM_CODEC_OCT16: {
+    if ( 3 != channels || n_floats % 3 != 0 ) { return -1; }
+    n_words = n_floats / 3 * 2;
+  } break;
+  case VOL_GEOM_STREAM_CODEC_HALF: break;
+  default: return -1;
+  }
+  vol_geom_size_t hdr_sz = (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) + prefix_sz;
+  if ( dst_max_sz < hdr_sz ) { return -1; }
+
+  int16_t* q_ptr = malloc( (size_t)( n_words * sizeof( int16_t ) ) );
+  float* out_ptr = decoded_ptr ? decoded_ptr : malloc( (size_t)src_sz );
+  if ( !q_ptr || !out_ptr ) {
+    free( q_ptr );
+    if ( out_ptr != decoded_ptr ) { free( out_ptr ); }
+    return -1;
+  }
+  vol_geom_reconstruct_job_t job = ( vol_geom_reconstruct_job_t ){ .codec = (uint8_t)codec, .q_ptr = q_ptr, .channels = channels, .dst_ptr = out_ptr, .n_floats = n_floats };
+  for ( vol_geom_size_t i = 0; i < n_floats; i++ ) {
+    float v = 0.0f;
+    memcpy( &v, &src_ptr[i], sizeof( float ) );
+    if ( VOL_GEOM_STREAM_CODEC_UNORM16 == codec ) {
+      q_ptr[i] = (int16_t)_quantize_unorm16( v, bounds_ptr[i % channels], bounds_ptr[channels + i % channels] );
+    } else if ( VOL_GEOM_STREAM_CODEC_HALF == codec ) {
+      q_ptr[i] = (int16_t)_float_to_half( v );
+    } else if ( i % 3 == 0 ) {
+      float n[3];
+      memcpy( n, &src_ptr[i], sizeof( n ) );
+      _encode_octahedral( n, &q_ptr[i / 3 * 2] );
+    }
+  }
+  if ( VOL_GEOM_STREAM_CODEC_UNORM16 == codec ) { memcpy( job.bounds, bounds_ptr, (size_t)prefix_sz ); }
+
+  vol_geom_stream_hdr_t stream_hdr =
+    ( vol_geom_stream_hdr_t ){ .raw_sz = (uint32_t)src_sz, .codec = (uint8_t)codec, .word_sz = 4, .channels = (uint8_t)channels };
+  memcpy( dst_ptr, &stream_hdr, sizeof( vol_geom_stream_hdr_t ) );
+  if ( prefix_sz > 0 ) { memcpy( &dst_ptr[sizeof( vol_geom_stream_hdr_t )], bounds_ptr, (size_t)prefix_sz ); }
+  int word_channels         = VOL_GEOM_STREAM_CODEC_OCT16 == codec ? 2 : channels;
+  vol_geom_size_t planes_sz = _encode_q16_planes( q_ptr, n_words, word_channels, &dst_ptr[hdr_sz], dst_max_sz - hdr_sz );
+
+  // Decode with the player's own kernels to measure the error.
+  if ( planes_sz >= 0 ) { _expand_q16( &job ); }
+  if ( planes_sz >= 0 && max_error_ptr ) {
+    float max_error = 0.0f;
+    for ( vol_geom_size_t i = 0; i < n_floats; i++ ) {
+      float v = 0.0f;
+      memcpy( &v, &src_ptr[i], sizeof( float ) );
+      float e = fabsf( v - out_ptr[i] );
+      if ( e > max_error ) { max_error = e; }
+    }
+    *max_error_ptr = max_error;
+  }
+  free( q_ptr );
+  if ( out_ptr != decoded_ptr ) { free( out_ptr ); }
+  return planes_sz < 0 ? -1 : hdr_sz + planes_sz;
+}
+
+void vol_geom_pack_vertices( const float* positions_ptr, const float* normals_ptr, const float* uvs_ptr, int n_vertices, const float* bounds_ptr,
+  vol_geom_packed_vertex_t* dst_ptr ) {
+  if ( !positions_ptr || !bounds_ptr || !dst_ptr || n_vertices < 1 ) { return; }
+  for ( int i = 0; i < n_vertices; i++ ) {
+    vol_geom_packed_vertex_t pv = ( vol_geom_packed_vertex_t ){ .position = { 0 } };
+    float p[3], n[3], uv[2];
+    memcpy( p, &positions_ptr[i * 3], sizeof( p ) );
+    for ( int c = 0; c < 3; c++ ) { pv.position[c] = _quantize_unorm16( p[c], bounds_ptr[c], bounds_ptr[3 + c] ); }
+    if ( normals_ptr ) {
+      memcpy( n, &normals_ptr[i * 3], sizeof( n ) );
+      _encode_octahedral( n, pv.normal );
+    }
+    if ( uvs_ptr ) {
+      memcpy( uv, &uvs_ptr[i * 2], sizeof( uv ) );
+      pv.uv[0] = _float_to_half( uv[0] );
+      pv.uv[1] = _float_to_half( uv[1] );
+    }
+    dst_ptr[i] = pv;
+  }
+}
+
+static void _decode_job( void* job_ctx_ptr, int job_idx ) {
+  vol_geom_decode_job_t* job_ptr  = &( (vol_geom_decode_job_t*)job_ctx_ptr )[job_idx];
+  const vol_geom_stream_hdr_t* sh = &job_ptr->stream_hdr;
+  vol_geom_size_t n_words         = sh->word_sz > 0 ? job_ptr->dst_sz / sh->word_sz : 0;
+
+  switch ( sh->codec ) {
+  case VOL_GEOM_STREAM_CODEC_RAW: {
+    job_ptr->succeeded = job_ptr->src_sz == job_ptr->dst_sz;
+    if ( job_ptr->succeeded && job_ptr->dst_sz > 0 ) { memcpy( job_ptr->dst_ptr, job_ptr->src_ptr, (size_t)job_ptr->dst_sz ); }
+  } break;
+  case VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE: {
+    job_ptr->succeeded = _decode_rle_plane( job_ptr->src_ptr, job_ptr->src_sz, n_words, sh->word_sz, sh->channels, job_ptr->plane_idx, job_ptr->dst_ptr );
+  } break;
+  case VOL_GEOM_STREAM_CODEC_INDEX_DELTA: {
+    job_ptr->succeeded = _decode_index_delta( job_ptr->src_ptr, job_ptr->src_sz, n_words, sh->word_sz, job_ptr->dst_ptr );
+  } break;
+  default: job_ptr->succeeded = false; break;
+  }
+}
+
+/** Decode one stream written by vol_geom_encode_stream(), such as a compressed bundle chunk. Byte planes are decoded in parallel via _parallel_for_ptr.
+ * Only the lossless codecs are accepted, as the others need a frame's decoder state.
+ * @param dst_sz     Expected decoded size in bytes. The stream must decode to exactly this size.
+ */
+static bool _decode_stream( const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr, vol_geom_size_t dst_sz ) {
+  vol_geom_decode_job_t jobs[4];
+  int n_jobs                       = 0;
+  vol_geom_stream_hdr_t stream_hdr = ( vol_geom_stream_hdr_t ){ .raw_sz = 0 };
+  if ( src_sz < (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) ) { return false; }
+  memcpy( &stream_hdr, src_ptr, sizeof( vol_geom_stream_hdr_t ) );
+  if ( stream_hdr.raw_sz != dst_sz || stream_hdr.codec > VOL_GEOM_STREAM_CODEC_INDEX_DELTA ) { return false; }
+  if ( ( stream_hdr.word_sz != 1 && stream_hdr.word_sz != 2 && stream_hdr.word_sz != 4 ) || stream_hdr.channels < 1 ||
+       stream_hdr.raw_sz % stream_hdr.word_sz != 0 ) {
+    return false;
+  }
+  const uint8_t* data_ptr = &src_ptr[sizeof( vol_geom_stream_hdr_t )];
+  vol_geom_size_t data_sz = src_sz - (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t );
+
+  vol_geom_decode_job_t job = ( vol_geom_decode_job_t ){ .src_ptr = data_ptr, .src_sz = data_sz, .dst_ptr = dst_ptr, .dst_sz = dst_sz, .stream_hdr = stream_hdr };
+  if ( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE == stream_hdr.codec ) {
+    vol_geom_size_t table_sz = stream_hdr.word_sz * (vol_geom_size_t)sizeof( uint32_t );
+    if ( table_sz > data_sz ) { return false; }
+    vol_geom_size_t plane_offset = table_sz;
+    for ( int p = 0; p < stream_hdr.word_sz; p++ ) {
+      uint32_t plane_sz = 0;
+      memcpy( &plane_sz, &data_ptr[p * sizeof( uint32_t )], sizeof( uint32_t ) );
+      if ( plane_offset + plane_sz > data_sz ) { return false; }
+      job.src_ptr    = &data_ptr[plane_offset];
+      job.src_sz     = plane_sz;
+      job.plane_idx  = p;
+      jobs[n_jobs++] = job;
+      plane_offset += plane_sz;
+    }
+    if ( plane_offset != data_sz ) { return false; }
+  } else {
+    jobs[n_jobs++] = job;
+  }
+
+  _parallel_for_ptr( n_jobs, _decode_job, jobs );
+  for ( int j = 0; j < n_jobs; j++ ) {
+    if ( !jobs[j].succeeded ) { return false; }
+  }
+  return true;
+}
+
+/** Number of arrays stored in a frame's mesh data, which depends on the file header and the frame's keyframe type. */
+static int _frame_stream_count( const vol_geom_file_hdr_t* hdr_ptr, uint8_t keyframe ) {
+  int n_streams = 1; // vertices
+  if ( hdr_ptr->normals && hdr_ptr->version >= 11 ) { n_streams++; }
+  if ( 1 == keyframe || ( hdr_ptr->version >= 12 && 2 == keyframe ) ) { n_streams += 2; } // indices and UVs
+  if ( hdr_ptr->version >= 11 && hdr_ptr->textured ) { n_streams++; }
+  return n_streams;
+}
+
+/** Decode every stream in a compressed frame's mesh data, producing mesh data laid out as in an uncompressed sequence.
+ * The streams' byte planes are decoded in parallel via _parallel_for_ptr.
+ * @param src_ptr    Start of the frame's stored mesh data, after the frame header.
+ * @param src_sz     Stored mesh data size in bytes (the corrected_payload_sz).
+ * @param dst_ptr    Memory of at least dst_max_sz bytes to decode into.
+ * @param dst_sz_ptr Decoded size is written here.
+ * @return           False if any stream is corrupt or does not fit.
+ */
+static bool _decode_frame_streams( const vol_geom_info_t* info_ptr, int frame_idx, const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr,
+  vol_geom_size_t dst_max_sz, vol_geom_size_t* dst_sz_ptr ) {
+  vol_geom_decode_job_t jobs[VOL_GEOM_MAX_DECODE_JOBS];
+  vol_geom_reconstruct_job_t reconstruct_jobs[VOL_GEOM_MAX_RECONSTRUCT_JOBS];
+  int n_jobs = 0, n_reconstruct_jobs = 0;
+  vol_geom_size_t src_offset = 0, dst_offset = 0, scratch_offset = 0;
+  vol_geom_decoder_state_t* state_ptr = info_ptr->_decoder_state_ptr;
+  // Decoded vertices and normals, which become the reference for the next frame.
+  float* slot_ptrs[2]         = { NULL, NULL };
+  vol_geom_size_t slot_szs[2] = { 0, 0 };
+  bool has_normals            = info_ptr->hdr.normals && info_ptr->hdr.version >= 11;
+  if ( state_ptr ) { state_ptr->reference_frame_idx = -1; } // Invalid until this frame decodes successfully.
+
+  int n_streams = _frame_stream_count( &info_ptr->hdr, info_ptr->frame_headers_ptr[frame_idx].keyframe );
+  for ( int s = 0; s < n_streams; s++ ) {
+    int32_t stored_sz                = 0;
+    vol_geom_stream_hdr_t stream_hdr = ( vol_geom_stream_hdr_t ){ .raw_sz = 0 };
+    if ( src_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) > src_sz ) { return false; }
+    memcpy( &stored_sz, &src_ptr[src_offset], sizeof( int32_t ) );
+    src_offset += (vol_geom_size_t)sizeof( int32_t );
+    if ( stored_sz < (int32_t)sizeof( vol_geom_stream_hdr_t ) || src_offset + stored_sz > src_sz ) { return false; }
+    memcpy( &stream_hdr, &src_ptr[src_offset], sizeof( vol_geom_stream_hdr_t ) );
+    const uint8_t* data_ptr = &src_ptr[src_offset + sizeof( vol_geom_stream_hdr_t )];
+    vol_geom_size_t data_sz = stored_sz - (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t );
+    src_offset += stored_sz;
+
+    if ( stream_hdr.raw_sz > INT32_MAX || dst_offset + (vol_geom_size_t)sizeof( int32_t ) + stream_hdr.raw_sz > dst_max_sz ) { return false; }
+    if ( ( stream_hdr.word_sz != 1 && stream_hdr.word_sz != 2 && stream_hdr.word_sz != 4 ) || stream_hdr.channels < 1 ||
+         stream_hdr.raw_sz % stream_hdr.word_sz != 0 ) {
+      return false;
+    }
+    int32_t raw_sz = (int32_t)stream_hdr.raw_sz;
+    memcpy( &dst_ptr[dst_offset], &raw_sz, sizeof( int32_t ) );
+    dst_offset += (vol_geom_size_t)sizeof( int32_t );
+    int slot = ( 0 == s || ( 1 == s && has_normals ) ) ? s : -1;
+    if ( slot >= 0 ) {
+      slot_ptrs[slot] = (float*)&dst_ptr[dst_offset];
+      slot_szs[slot]  = raw_sz;
+    }
+
+    vol_geom_decode_job_t job =
+      ( vol_geom_decode_job_t ){ .src_ptr = data_ptr, .src_sz = data_sz, .dst_ptr = &dst_ptr[dst_offset], .dst_sz = raw_sz, .stream_hdr = stream_hdr };
+    if ( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE == stream_hdr.codec ) {
+      // Split into one job per byte plane, using the plane size table.
+      vol_geom_size_t table_sz = stream_hdr.word_sz * (vol_geom_size_t)sizeof( uint32_t );
+      if ( table_sz > data_sz ) { return false; }
+      vol_geom_size_t plane_offset = table_sz;
+      for ( int p = 0; p < stream_hdr.word_sz; p++ ) {
+        uint32_t plane_sz = 0;
+        memcpy( &plane_sz, &data_ptr[p * sizeof( uint32_t )], sizeof( uint32_t ) );
+        if ( plane_offset + plane_sz > data_sz ) { return false; }
+        job.src_ptr    = &data_ptr[plane_offset];
+        job.src_sz     = plane_sz;
+        job.plane_idx  = p;
+        jobs[n_jobs++] = job;
+        plane_offset += plane_sz;
+      }
+      if ( plane_offset != data_sz ) { return false; }
+    } else if ( stream_hdr.codec >= VOL_GEOM_STREAM_CODEC_DELTA_Q16 && stream_hdr.codec < VOL_GEOM_STREAM_CODEC_MAX ) {
+      // 16-bit words: decode their two byte planes into scratch memory, then expand them to floats once every plane is decoded.
+      vol_geom_size_t n_floats  = raw_sz / (vol_geom_size_t)sizeof( float );
+      vol_geom_size_t n_words   = n_floats;
+      vol_geom_size_t prefix_sz = 0;
+      int word_channels         = stream_hdr.channels;
+      vol_geom_reconstruct_job_t expand_job =
+        ( vol_geom_reconstruct_job_t ){ .codec = stream_hdr.codec, .channels = stream_hdr.channels, .dst_ptr = (float*)&dst_ptr[dst_offset] };
+      if ( !state_ptr || 4 != stream_hdr.word_sz ) { return false; }
+      if ( VOL_GEOM_STREAM_CODEC_DELTA_Q16 == stream_hdr.codec ) {
+        // Predicted from the same stream of the previous frame, which must be what the decoder state holds.
+        if ( slot < 0 || frame_idx < 1 || state_ptr->reference_szs[slot] != raw_sz ) { return false; }
+        prefix_sz = (vol_geom_size_t)sizeof( float );
+        if ( prefix_sz > data_sz ) { return false; }
+        memcpy( &expand_job.step, data_ptr, sizeof( float ) );
+        expand_job.reference_ptr = state_ptr->reference_ptrs[slot];
+      } else if ( VOL_GEOM_STREAM_CODEC_UNORM16 == stream_hdr.codec ) {
+        if ( stream_hdr.channels > 4 ) { return false; }
+        prefix_sz = 2 * stream_hdr.channels * (vol_geom_size_t)sizeof( float );
+        if ( prefix_sz > data_sz ) { return false; }
+        memcpy( expand_job.bounds, data_ptr, (size_t)prefix_sz );
+      } else if ( VOL_GEOM_STREAM_CODEC_OCT16 == stream_hdr.codec ) {
+        if ( 3 != stream_hdr.channels || n_floats % 3 != 0 ) { return false; }
+        n_words       = n_floats / 3 * 2;
+        word_channels = 2;
+      }
+      vol_geom_size_t q_sz     = n_words * (vol_geom_size_t)sizeof( int16_t );
+      vol_geom_size_t table_sz = prefix_sz + 2 * (vol_geom_size_t)sizeof( uint32_t );
+      if ( table_sz > data_sz || scratch_offset + q_sz > state_ptr->scratch_sz ) { return false; }
+      int16_t* q_ptr = (int16_t*)&( (uint8_t*)state_ptr->scratch_ptr )[scratch_offset];
+      scratch_offset += q_sz;
+
+      job.stream_hdr = ( vol_geom_stream_hdr_t ){ .raw_sz = (uint32_t)q_sz, .codec = VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE, .word_sz = 2, .channels = (uint8_t)word_channels };
+      job.dst_ptr    = (uint8_t*)q_ptr;
+      job.dst_sz     = q_sz;
+      vol_geom_size_t plane_offset = table_sz;
+      for ( int p = 0; p < 2; p++ ) {
+        uint32_t plane_sz = 0;
+        memcpy( &plane_sz, &data_ptr[prefix_sz + p * sizeof( uint32_t )], sizeof( uint32_t ) );
+        if ( plane_offset + plane_sz > data_sz ) { return false; }
+        job.src_ptr    = &data_ptr[plane_offset];
+        job.src_sz     = plane_sz;
+        job.plane_idx  = p;
+        jobs[n_jobs++] = job;
+        plane_offset += plane_sz;
+      }
+      if ( plane_offset != data_sz ) { return false; }
+
+      // Queue expansion in ranges of whole vertices.
+      for ( vol_geom_size_t first = 0; first < n_floats; first += VOL_GEOM_RECONSTRUCT_JOB_FLOATS ) {
+        if ( n_reconstruct_jobs >= VOL_GEOM_MAX_RECONSTRUCT_JOBS ) {
+          // Very large arrays: make the last job cover the remainder.
+          reconstruct_jobs[n_reconstruct_jobs - 1].n_floats += n_floats - first;
+          break;
+        }
+        vol_geom_reconstruct_job_t range_job = expand_job;
+        range_job.q_ptr                      = &q_ptr[VOL_GEOM_STREAM_CODEC_OCT16 == stream_hdr.codec ? first / 3 * 2 : first];
+        range_job.dst_ptr                    = &expand_job.dst_ptr[first];
+        range_job.n_floats                   = n_floats - first < VOL_GEOM_RECONSTRUCT_JOB_FLOATS ? n_floats - first : VOL_GEOM_RECONSTRUCT_JOB_FLOATS;
+        if ( range_job.reference_ptr ) { range_job.reference_ptr = &expand_job.reference_ptr[first]; }
+        reconstruct_jobs[n_reconstruct_jobs++] = range_job;
+      }
+    } else {
+      jobs[n_jobs++] = job;
+    }
+    dst_offset += raw_sz;
+  }
+
+  _parallel_for_ptr( n_jobs, _decode_job, jobs );
+  for ( int j = 0; j < n_jobs; j++ ) {
+    if ( !jobs[j].succeeded ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: stream with codec %i in frame %i failed to decode\n", (int)jobs[j].stream_hdr.codec, frame_idx );
+      return false;
+    }
+  }
+  if ( n_reconstruct_jobs > 0 ) { _parallel_for_ptr( n_reconstruct_jobs, _reconstruct_job, reconstruct_jobs ); }
+
+  // Keep this frame's vertices and normals to predict the next frame from.
+  if ( state_ptr && state_ptr->predicted ) {
+    for ( int slot = 0; slot < 2; slot++ ) {
+      if ( slot_szs[slot] > state_ptr->reference_szs[slot] || !state_ptr->reference_ptrs[slot] ) {
+        float* resized_ptr = realloc( state_ptr->reference_ptrs[slot], (size_t)( slot_szs[slot] > 0 ? slot_szs[slot] : 1 ) );
+        if ( !resized_ptr ) { return false; }
+        state_ptr->reference_ptrs[slot] = resized_ptr;
+      }
+      state_ptr->reference_szs[slot] = slot_szs[slot];
+      if ( slot_szs[slot] > 0 ) { memcpy( state_ptr->reference_ptrs[slot], slot_ptrs[slot], (size_t)slot_szs[slot] ); }
+    }
+    state_ptr->reference_frame_idx = frame_idx;
+  }
+
+  *dst_sz_ptr = dst_offset;
+  return true;
+}
+
+/******************************************************************************
+  FILE I/O BACKENDS
+******************************************************************************/
+
+static void* _stdio_open( const char* path, void* user_ptr ) {
+  (void)user_ptr;
+  return fopen( path, "rb" );
+}
+
+static vol_geom_size_t _stdio_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  if ( 0 != vol_geom_fseeko( (FILE*)file_ptr, 0, SEEK_END ) ) { return -1; }
+  return (vol_geom_size_t)vol_geom_ftello( (FILE*)file_ptr );
+}
+
+static bool _stdio_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  if ( 0 != vol_geom_fseeko( (FILE*)file_ptr, offset, SEEK_SET ) ) { return false; }
+  return 0 == sz || 1 == fread( dst_ptr, (size_t)sz, 1, (FILE*)file_ptr );
+}
+
+static void _stdio_close( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  fclose( (FILE*)file_ptr );
+}
+
+vol_geom_io_t vol_geom_io_stdio( void ) {
+  return ( vol_geom_io_t ){ .open_fn = _stdio_open, .size_fn = _stdio_size, .read_at_fn = _stdio_read_at, .close_fn = _stdio_close };
+}
+
+#ifdef _WIN32
+static void* _pread_open( const char* path, void* user_ptr ) {
+  (void)user_ptr;
+  HANDLE handle = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+  return INVALID_HANDLE_VALUE == handle ? NULL : (void*)handle;
+}
+
+static vol_geom_size_t _pread_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  LARGE_INTEGER sz;
+  if ( !GetFileSizeEx( (HANDLE)file_ptr, &sz ) ) { return -1; }
+  return (vol_geom_size_t)sz.QuadPart;
+}
+
+static bool _pread_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  uint8_t* byte_ptr = (uint8_t*)dst_ptr;
+  while ( sz > 0 ) {
+    // With an OVERLAPPED offset, ReadFile() on a synchronous handle reads at that offset without using the handle's file pointer.
+    DWORD chunk_sz  = (DWORD)( sz < ( 1 << 30 ) ? sz : ( 1 << 30 ) );
+    DWORD n_read    = 0;
+    OVERLAPPED ov   = { 0 };
+    ov.Offset       = (DWORD)( (uint64_t)offset & 0xFFFFFFFF );
+    ov.OffsetHigh   = (DWORD)( (uint64_t)offset >> 32 );
+    if ( !ReadFile( (HANDLE)file_ptr, byte_ptr, chunk_sz, &n_read, &ov ) || 0 == n_read ) { return false; }
+    byte_ptr += n_read;
+    offset += n_read;
+    sz -= n_read;
+  }
+  return true;
+}
+
+static void _pread_close( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  CloseHandle( (HANDLE)file_ptr );
+}
+#else
+// File descriptors are stored as fd + 1 so that descriptor 0 isn't mistaken for a NULL handle.
+static void* _pread_open( const char* path, void* user_ptr ) {
+  (void)user_ptr;
+  int fd = open( path, O_RDONLY );
+  return fd < 0 ? NULL : (void*)( (intptr_t)fd + 1 );
+}
+
+static vol_geom_size_t _pread_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  struct stat stbuf;
+  if ( 0 != fstat( (int)( (intptr_t)file_ptr - 1 ), &stbuf ) ) { return -1; }
+  return (vol_geom_size_t)stbuf.st_size;
+}
+
+static bool _pread_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  uint8_t* byte_ptr = (uint8_t*)dst_ptr;
+  while ( sz > 0 ) {
+    ssize_t n_read = pread( (int)( (intptr_t)file_ptr - 1 ), byte_ptr, (size_t)( sz < ( 1 << 30 ) ? sz : ( 1 << 30 ) ), (off_t)offset );
+    if ( n_read < 0 && EINTR == errno ) { continue; }
+    if ( n_read <= 0 ) { return false; }
+    byte_ptr += n_read;
+    offset += n_read;
+    sz -= n_read;
+  }
+  return true;
+}
+
+static void _pread_close( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  close( (int)( (intptr_t)file_ptr - 1 ) );
+}
+#endif
+
+vol_geom_io_t vol_geom_io_pread( void ) {
+  return ( vol_geom_io_t ){ .open_fn = _pread_open, .size_fn = _pread_size, .read_at_fn = _pread_read_at, .close_fn = _pread_close };
+}
+
+static void* _memory_open( const char* path, void* user_ptr ) {
+  for ( const vol_geom_memory_file_t* mf_ptr = (const vol_geom_memory_file_t*)user_ptr; mf_ptr->path; mf_ptr++ ) {
+    if ( 0 == strcmp( mf_ptr->path, path ) ) { return (void*)mf_ptr; }
+  }
+  return NULL;
+}
+
+static vol_geom_size_t _memory_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  return ( (const vol_geom_memory_file_t*)file_ptr )->sz;
+}
+
+static bool _memory_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  const vol_geom_memory_file_t* mf_ptr = (const vol_geom_memory_file_t*)file_ptr;
+  if ( offset < 0 || sz < 0 || offset + sz > mf_ptr->sz ) { return false; }
+  if ( sz > 0 ) { memcpy( dst_ptr, (const uint8_t*)mf_ptr->data_ptr + offset, (size_t)sz ); }
+  return true;
+}
+
+static void _memory_close( void* file_ptr, void* user_ptr ) {
+  (void)file_ptr;
+  (void)user_ptr;
+}
+
+vol_geom_io_t vol_geom_io_memory( const vol_geom_memory_file_t* files_ptr ) {
+  return ( vol_geom_io_t ){
+    .open_fn = _memory_open, .size_fn = _memory_size, .read_at_fn = _memory_read_at, .close_fn = _memory_close, .user_ptr = (void*)files_ptr };
+}
+
+/// A http:// URL, read with HTTP/1.1 range requests over one kept-alive connection.
+typedef struct vol_geom_http_file_t {
+  /// Held for each request, which uses the connection and the receive buffer, so that threads take turns. Not needed for first_block.
+  vol_geom_mutex_t lock;
+  /// Connection to the HTTP server, or VOL_GEOM_INVALID_SOCKET if not connected.
+  vol_geom_socket_t sock;
+  /// Parts of the URL.
+  char host[256], port[8], path[2048];
+  /// Size of the resource in bytes.
+  vol_geom_size_t sz;
+  /// The start of the resource, fetched when it is opened to find its size, and kept so that reading the header doesn't need another request.
+  uint8_t first_block[VOL_GEOM_READ_BLOCK_SZ];
+  vol_geom_size_t first_block_sz;
+  /// Bytes received but not yet read, e.g. the start of a body received with its header, and the next of them to read.
+  uint8_t recv_buf[VOL_GEOM_HTTP_MAX_HDR_SZ];
+  int recv_pos, recv_len;
+} vol_geom_http_file_t;
+
+static bool _is_url( const char* path ) { return 0 == strncmp( path, "http://", 7 ); }
+
+static bool _parse_url( const char* url, vol_geom_http_file_t* http_ptr ) {
+  const char* host_ptr = url + 7; // after "http://"
+  size_t host_len      = strcspn( host_ptr, ":/" );
+  if ( 0 == host_len || host_len >= sizeof( http_ptr->host ) ) { return false; }
+  memcpy( http_ptr->host, host_ptr, host_len );
+  http_ptr->host[host_len] = '\0';
+
+  const char* rest_ptr = host_ptr + host_len;
+  strcpy( http_ptr->port, "80" );
+  if ( ':' == *rest_ptr ) {
+    size_t port_len = strcspn( rest_ptr + 1, "/" );
+    if ( 0 == port_len || port_len >= sizeof( http_ptr->port ) ) { return false; }
+    memcpy( http_ptr->port, rest_ptr + 1, port_len );
+    http_ptr->port[port_len] = '\0';
+    rest_ptr += 1 + port_len;
+  }
+  if ( strlen( rest_ptr ) >= sizeof( http_ptr->path ) ) { return false; }
+  strcpy( http_ptr->path, '/' == *rest_ptr ? rest_ptr : "/" );
+  return true;
+}
+
+static void _http_disconnect( vol_geom_http_file_t* http_ptr ) {
+  if ( VOL_GEOM_INVALID_SOCKET != http_ptr->sock ) { vol_geom_closesocket( http_ptr->sock ); }
+  http_ptr->sock     = VOL_GEOM_INVALID_SOCKET;
+  http_ptr->recv_pos = 0;
+  http_ptr->recv_len = 0;
+}
+
+static bool _http_connect( vol_geom_http_file_t* http_ptr ) {
+  struct addrinfo hints = { 0 }, *addrs_ptr = NULL;
+  hints.ai_family       = AF_UNSPEC;
+  hints.ai_socktype     = SOCK_STREAM;
+  if ( 0 != getaddrinfo( http_ptr->host, http_ptr->port, &hints, &addrs_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not resolve host `%s`\n", http_ptr->host );
+    return false;
+  }
+  for ( struct addrinfo* a_ptr = addrs_ptr; a_ptr; a_ptr = a_ptr->ai_next ) {
+    vol_geom_socket_t sock = socket( a_ptr->ai_family, a_ptr->ai_socktype, a_ptr->ai_protocol );
+    if ( VOL_GEOM_INVALID_SOCKET == sock ) { continue; }
+#ifdef _WIN32
+    DWORD timeout = VOL_GEOM_HTTP_TIMEOUT_S * 1000;
+#else
+    struct timeval timeout = { .tv_sec = VOL_GEOM_HTTP_TIMEOUT_S };
+#endif
+    setsockopt( sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof( timeout ) );
+    setsockopt( sock, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof( timeout ) );
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    setsockopt( sock, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof( no_sigpipe ) );
+#endif
+    if ( 0 == connect( sock, a_ptr->ai_addr, (int)a_ptr->ai_addrlen ) ) {
+      http_ptr->sock = sock;
+      break;
+    }
+    vol_geom_closesocket( sock );
+  }
+  freeaddrinfo( addrs_ptr );
+  if ( VOL_GEOM_INVALID_SOCKET == http_ptr->sock ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not connect to `%s:%s`\n", http_ptr->host, http_ptr->port );
+    return false;
+  }
+  return true;
+}
+
+/** Receives exactly sz bytes, starting with any already received. If dst_ptr is NULL the bytes are discarded. */
+static bool _http_recv_all( vol_geom_http_file_t* http_ptr, uint8_t* dst_ptr, vol_geom_size_t sz ) {
+  uint8_t discard[4096];
+  int n_buffered = http_ptr->recv_len - http_ptr->recv_pos;
+  if ( n_buffered > 0 && sz > 0 ) {
+    int n = sz < n_buffered ? (int)sz : n_buffered;
+    if ( dst_ptr ) {
+      memcpy( dst_ptr, &http_ptr->recv_buf[http_ptr->recv_pos], (size_t)n );
+      dst_ptr += n;
+    }
+    http_ptr->recv_pos += n;
+    sz -= n;
+  }
+  while ( sz > 0 ) {
+    int max_n = (int)( sz < ( 1 << 30 ) ? sz : ( 1 << 30 ) );
+    if ( !dst_ptr && max_n > (int)sizeof( discard ) ) { max_n = (int)sizeof( discard ); }
+    int n = (int)recv( http_ptr->sock, dst_ptr ? (char*)dst_ptr : (char*)discard, max_n, 0 );
+    if ( n <= 0 ) { return false; }
+    if ( dst_ptr ) { dst_ptr += n; }
+    sz -= n;
+  }
+  return true;
+}
+
+/** Receives a line of a chunked body into line_str, without its CRLF. */
+static bool _http_recv_line( vol_geom_http_file_t* http_ptr, char* line_str, int max_len ) {
+  int len = 0;
+  while ( true ) {
+    if ( http_ptr->recv_pos >= http_ptr->recv_len ) {
+      int n = (int)recv( http_ptr->sock, (char*)http_ptr->recv_buf, (int)sizeof( http_ptr->recv_buf ), 0 );
+      if ( n <= 0 ) { return false; }
+      http_ptr->recv_pos = 0;
+      http_ptr->recv_len = n;
+    }
+    char c = (char)http_ptr->recv_buf[http_ptr->recv_pos++];
+    if ( '\n' == c ) { break; }
+    if ( '\r' == c ) { continue; }
+    if ( len + 1 >= max_len ) { return false; }
+    line_str[len++] = c;
+  }
+  line_str[len] = '\0';
+  return true;
+}
+
+/** Receives a body sent with `Transfer-Encoding: chunked`, keeping up to max_sz bytes of it.
+ * @param got_sz_ptr   Number of bytes written to dst_ptr.
+ * @param body_sz_ptr  Size of the whole body.
+ */
+static bool _http_recv_chunked(
+  vol_geom_http_file_t* http_ptr, uint8_t* dst_ptr, vol_geom_size_t max_sz, vol_geom_size_t* got_sz_ptr, vol_geom_size_t* body_sz_ptr ) {
+  char line_str[256];
+  vol_geom_size_t body_sz = 0;
+  while ( true ) {
+    // Each chunk is its size in hex, maybe followed by extensions, then that many bytes and a CRLF. A chunk of size 0 ends the body.
+    if ( !_http_recv_line( http_ptr, line_str, (int)sizeof( line_str ) ) ) { return false; }
+    char* end_ptr      = NULL;
+    long long chunk_sz     = strtoll( line_str, &end_ptr, 16 );
+    if ( end_ptr == line_str || chunk_sz < 0 ) { return false; }
+    if ( 0 == chunk_sz ) { break; }
+    vol_geom_size_t keep_sz = body_sz < max_sz ? ( max_sz - body_sz < chunk_sz ? max_sz - body_sz : chunk_sz ) : 0;
+    if ( !_http_recv_all( http_ptr, keep_sz > 0 ? dst_ptr + body_sz : NULL, keep_sz ) ) { return false; }
+    if ( !_http_recv_all( http_ptr, NULL, chunk_sz - keep_sz ) ) { return false; }
+    if ( !_http_recv_line( http_ptr, line_str, (int)sizeof( line_str ) ) || '\0' != line_str[0] ) { return false; }
+    body_sz += chunk_sz;
+  }
+  // Skip any trailer fields, up to the empty line that ends the reply.
+  do {
+    if ( !_http_recv_line( http_ptr, line_str, (int)sizeof( line_str ) ) ) { return false; }
+  } while ( '\0' != line_str[0] );
+  *got_sz_ptr  = body_sz < max_sz ? body_sz : max_sz;
+  *body_sz_ptr = body_sz;
+  return true;
+}
+
+/** Sends a request for up to max_sz bytes starting at offset and receives the response into dst_ptr.
+ * @param got_sz_ptr   Number of bytes written to dst_ptr.
+ * @param total_sz_ptr If not NULL, set to the size of the whole resource.
+ * @param retry_ptr    Set to true if the request failed because a kept-alive connection had been closed by the server, so it is worth retrying.
+ */
+static bool _http_request( vol_geom_http_file_t* http_ptr, vol_geom_size_t offset, vol_geom_size_t max_sz, uint8_t* dst_ptr, vol_geom_size_t* got_sz_ptr,
+  vol_geom_size_t* total_sz_ptr, bool* retry_ptr ) {
+  char hdr_str[VOL_GEOM_HTTP_MAX_HDR_SZ + 1];
+  bool reused = VOL_GEOM_INVALID_SOCKET != http_ptr->sock;
+  *retry_ptr  = false;
+  if ( !reused && !_http_connect( http_ptr ) ) { return false; }
+
+  int req_len = snprintf( hdr_str, sizeof( hdr_str ), "GET %s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%" PRId64 "-%" PRId64 "\r\nConnection: keep-alive\r\n\r\n",
+    http_ptr->path, http_ptr->host, offset, offset + max_sz - 1 );
+  if ( req_len <= 0 || req_len >= (int)sizeof( hdr_str ) ) { return false; }
+  if ( send( http_ptr->sock, hdr_str, req_len, VOL_GEOM_SEND_FLAGS ) != req_len ) {
+    _http_disconnect( http_ptr );
+    *retry_ptr = reused;
+    return false;
+  }
+
+  // Receive until the end of the response header. Anything after it is the start of the body.
+  int hdr_len = 0, body_start = -1;
+  while ( body_start < 0 ) {
+    int n = (int)recv( http_ptr->sock, hdr_str + hdr_len, VOL_GEOM_HTTP_MAX_HDR_SZ - hdr_len, 0 );
+    if ( n <= 0 ) {
+      _http_disconnect( http_ptr );
+      *retry_ptr = reused && 0 == hdr_len;
+      return false;
+    }
+    hdr_len += n;
+    hdr_str[hdr_len] = '\0';
+    char* end_ptr    = strstr( hdr_str, "\r\n\r\n" );
+    if ( end_ptr ) {
+      body_start = (int)( end_ptr - hdr_str ) + 4;
+    } else if ( hdr_len >= VOL_GEOM_HTTP_MAX_HDR_SZ ) {
+      _http_disconnect( http_ptr );
+      return false;
+    }
+  }
+  int n_body_received  = hdr_len - body_start;
+  char first_body_char = hdr_str[body_start];
+  hdr_str[body_start]  = '\0';
+  for ( int i = 0; i < body_start; i++ ) { hdr_str[i] = (char)tolower( (unsigned char)hdr_str[i] ); } // Header names are case-insensitive.
+
+  int status = 0;
+  if ( 1 != sscanf( hdr_str, "http/%*d.%*d %d", &status ) ) { status = 0; }
+  int64_t content_len  = -1, range_first = -1, range_total = -1;
+  const char* line_ptr = strstr( hdr_str, "\r\ncontent-length:" );
+  if ( line_ptr ) { sscanf( line_ptr, "\r\ncontent-length: %" SCNd64, &content_len ); }
+  line_ptr = strstr( hdr_str, "\r\ncontent-range:" );
+  if ( line_ptr ) { sscanf( line_ptr, "\r\ncontent-range: bytes %" SCNd64 "-%*[0-9]/%" SCNd64, &range_first, &range_total ); }
+  char coding_str[64] = "";
+  line_ptr            = strstr( hdr_str, "\r\ntransfer-encoding:" );
+  if ( line_ptr ) { sscanf( line_ptr, "\r\ntransfer-encoding: %63[^\r]", coding_str ); }
+  bool chunked        = 0 == strcmp( coding_str, "chunked" );
+  bool keep_alive     = !strstr( hdr_str, "\r\nconnection: close" );
+  hdr_str[body_start] = first_body_char;
+
+  if ( line_ptr && !chunked ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: unsupported HTTP Transfer-Encoding `%s` from `%s`\n", coding_str, http_ptr->path );
+    _http_disconnect( http_ptr );
+    return false;
+  }
+  // 206 is the reply to a range request. A server that ignores ranges replies 200 with the whole resource, which is only usable when reading from the start.
+  bool ok = ( content_len >= 0 || chunked ) && ( ( 206 == status && range_first == (int64_t)offset ) || ( 200 == status && 0 == offset ) );
+  if ( !ok ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: HTTP status %i for bytes %" PRId64 "-%" PRId64 " of `%s`. The server must support range requests.\n", status, offset,
+      offset + max_sz - 1, http_ptr->path );
+    _http_disconnect( http_ptr );
+    return false;
+  }
+  // The start of the body may have been received with the header.
+  memcpy( http_ptr->recv_buf, hdr_str + body_start, (size_t)n_body_received );
+  http_ptr->recv_pos = 0;
+  http_ptr->recv_len = n_body_received;
+
+  vol_geom_size_t got_sz = 0, body_sz = content_len;
+  if ( chunked ) {
+    if ( !_http_recv_chunked( http_ptr, dst_ptr, max_sz, &got_sz, &body_sz ) ) {
+      _vol_loggerf(
+        VOL_GEOM_LOG_TYPE_ERROR, "ERROR: invalid chunked HTTP reply for bytes %" PRId64 "-%" PRId64 " of `%s`\n", offset, offset + max_sz - 1, http_ptr->path );
+      _http_disconnect( http_ptr );
+      return false;
+    }
+  } else {
+    got_sz = body_sz < max_sz ? body_sz : max_sz;
+    if ( !_http_recv_all( http_ptr, dst_ptr, got_sz ) ) {
+      _http_disconnect( http_ptr );
+      return false;
+    }
+  }
+  if ( total_sz_ptr ) { *total_sz_ptr = 206 == status && range_total >= 0 ? range_total : body_sz; }
+  // Any bytes beyond max_sz must be consumed before the connection can be reused. That only happens with 200 replies, so don't bother.
+  if ( !keep_alive || body_sz != got_sz ) { _http_disconnect( http_ptr ); }
+  *got_sz_ptr = got_sz;
+  return true;
+}
+
+/** Reads exactly sz bytes at offset from a URL, reconnecting once if the server had closed the kept-alive connection. */
+static bool _http_read( vol_geom_http_file_t* http_ptr, vol_geom_size_t offset, vol_geom_size_t sz, uint8_t* dst_ptr ) {
+  if ( 0 == sz ) { return true; }
+  for ( int attempt = 0; attempt < 2; attempt++ ) {
+    vol_geom_size_t got_sz = 0;
+    bool retry             = false;
+    if ( _http_request( http_ptr, offset, sz, dst_ptr, &got_sz, NULL, &retry ) ) { return got_sz == sz; }
+    if ( !retry ) { break; }
+  }
+  return false;
+}
+
+
+static void _http_close( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  vol_geom_http_file_t* http_ptr = (vol_geom_http_file_t*)file_ptr;
+  _http_disconnect( http_ptr );
+  vol_geom_mutex_destroy( &http_ptr->lock );
+  free( http_ptr );
+#ifdef _WIN32
+  WSACleanup();
+#endif
+}
+
+/** Fetches the first block of the resource, which also finds its size. */
+static void* _http_open( const char* path, void* user_ptr ) {
+  if ( !_is_url( path ) ) { return NULL; }
+#ifdef _WIN32
+  WSADATA wsa_data;
+  if ( 0 != WSAStartup( MAKEWORD( 2, 2 ), &wsa_data ) ) { return NULL; }
+#endif
+  vol_geom_http_file_t* http_ptr = calloc( 1, sizeof( vol_geom_http_file_t ) );
+  if ( !http_ptr ) {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return NULL;
+  }
+  vol_geom_mutex_init( &http_ptr->lock );
+  http_ptr->sock = VOL_GEOM_INVALID_SOCKET;
+  if ( !_parse_url( path, http_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not parse URL `%s`\n", path );
+    _http_close( http_ptr, user_ptr );
+    return NULL;
+  }
+  bool retry = false;
+  if ( !_http_request( http_ptr, 0, VOL_GEOM_READ_BLOCK_SZ, http_ptr->first_block, &http_ptr->first_block_sz, &http_ptr->sz, &retry ) ) {
+    _http_close( http_ptr, user_ptr );
+    return NULL;
+  }
+  return http_ptr;
+}
+
+static vol_geom_size_t _http_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  return ( (vol_geom_http_file_t*)file_ptr )->sz;
+}
+
+static bool _http_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  vol_geom_http_file_t* http_ptr = (vol_geom_http_file_t*)file_ptr;
+  if ( offset + sz <= http_ptr->first_block_sz ) {
+    memcpy( dst_ptr, &http_ptr->first_block[offset], (size_t)sz );
+    return true;
+  }
+  vol_geom_mutex_lock( &http_ptr->lock );
+  bool ok = _http_read( http_ptr, offset, sz, dst_ptr );
+  vol_geom_mutex_unlock( &http_ptr->lock );
+  return ok;
+}
+
+vol_geom_io_t vol_geom_io_http( void ) {
+  return ( vol_geom_io_t ){
+    .open_fn = _http_open, .size_fn = _http_size, .read_at_fn = _http_read_at, .close_fn = _http_close, .scan_read_sz = VOL_GEOM_HTTP_SCAN_READ_SZ };
+}
+
+/// A bundle file, open for as long as any of its chunks are read.
+struct vol_geom_bundle_t {
+  vol_geom_io_t io;
+  /// Handle returned by io.open_fn. Every chunk is read through this one handle.
+  void* file_ptr;
+  vol_geom_size_t sz;
+  vol_geom_bundle_chunk_t* chunks_ptr;
+  int n_chunks;
+  /// Decoded contents of each compressed chunk, in chunk table order. NULL for stored chunks, which are read from the file.
+  uint8_t** decoded_ptrs;
+};
+
+/** Reads and decodes a compressed chunk into decoded_ptrs. */
+static bool _bundle_decode_chunk( vol_geom_bundle_t* bundle_ptr, int chunk_idx ) {
+  const vol_geom_bundle_chunk_t* chunk_ptr = &bundle_ptr->chunks_ptr[chunk_idx];
+  uint8_t* stored_ptr                      = malloc( (size_t)( chunk_ptr->stored_sz > 0 ? chunk_ptr->stored_sz : 1 ) );
+  uint8_t* decoded_ptr                     = malloc( (size_t)( chunk_ptr->raw_sz > 0 ? chunk_ptr->raw_sz : 1 ) );
+  bool decoded = stored_ptr && decoded_ptr &&
+                 bundle_ptr->io.read_at_fn( bundle_ptr->file_ptr, (vol_geom_size_t)chunk_ptr->offset, (vol_geom_size_t)chunk_ptr->stored_sz, stored_ptr,
+                   bundle_ptr->io.user_ptr ) &&
+                 _decode_stream( stored_ptr, (vol_geom_size_t)chunk_ptr->stored_sz, decoded_ptr, (vol_geom_size_t)chunk_ptr->raw_sz );
+  free( stored_ptr );
+  if ( !decoded ) {
+    free( decoded_ptr );
+    return false;
+  }
+  bundle_ptr->decoded_ptrs[chunk_idx] = decoded_ptr;
+  return true;
+}
+
+/** Reads and checks a bundle's chunk table, and decodes its compressed chunks. */
+static bool _bundle_read_chunks( vol_geom_bundle_t* bundle_ptr, const char* path ) {
+  vol_geom_bundle_hdr_t bundle_hdr = ( vol_geom_bundle_hdr_t ){ .version = 0 };
+  if ( bundle_ptr->sz < (vol_geom_size_t)sizeof( vol_geom_bundle_hdr_t ) ||
+       !bundle_ptr->io.read_at_fn( bundle_ptr->file_ptr, 0, sizeof( vol_geom_bundle_hdr_t ), &bundle_hdr, bundle_ptr->io.user_ptr ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not read bundle header of `%s`\n", path );
+    return false;
+  }
+  if ( 0 != memcmp( bundle_hdr.magic, VOL_GEOM_BUNDLE_MAGIC, 4 ) || VOL_GEOM_BUNDLE_VERSION != bundle_hdr.version ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: `%s` is not a version %i vologram bundle\n", path, VOL_GEOM_BUNDLE_VERSION );
+    return false;
+  }
+  vol_geom_size_t table_sz = (vol_geom_size_t)bundle_hdr.chunk_count * (vol_geom_size_t)sizeof( vol_geom_bundle_chunk_t );
+  if ( 0 == bundle_hdr.chunk_count || bundle_hdr.chunk_count > VOL_GEOM_BUNDLE_MAX_CHUNKS ||
+       (vol_geom_size_t)sizeof( vol_geom_bundle_hdr_t ) + table_sz > bundle_ptr->sz ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: bundle `%s` has a corrupt chunk table\n", path );
+    return false;
+  }
+  bundle_ptr->n_chunks     = (int)bundle_hdr.chunk_count;
+  bundle_ptr->chunks_ptr   = calloc( bundle_ptr->n_chunks, sizeof( vol_geom_bundle_chunk_t ) );
+  bundle_ptr->decoded_ptrs = calloc( bundle_ptr->n_chunks, sizeof( uint8_t* ) );
+  if ( !bundle_ptr->chunks_ptr || !bundle_ptr->decoded_ptrs ) { return false; }
+  if ( !bundle_ptr->io.read_at_fn( bundle_ptr->file_ptr, sizeof( vol_geom_bundle_hdr_t ), table_sz, bundle_ptr->chunks_ptr, bundle_ptr->io.user_ptr ) ) {
+    return false;
+  }
+
+  for ( int i = 0; i < bundle_ptr->n_chunks; i++ ) {
+    const vol_geom_bundle_chunk_t* chunk_ptr = &bundle_ptr->chunks_ptr[i];
+    uint64_t file_sz                         = (uint64_t)bundle_ptr->sz;
+    bool valid = chunk_ptr->offset <= file_sz && chunk_ptr->stored_sz <= file_sz - chunk_ptr->offset && chunk_ptr->raw_sz <= INT64_MAX;
+    if ( VOL_GEOM_BUNDLE_CODEC_STORED == chunk_ptr->codec ) {
+      valid = valid && chunk_ptr->raw_sz == chunk_ptr->stored_sz;
+    } else if ( VOL_GEOM_BUNDLE_CODEC_STREAM == chunk_ptr->codec ) {
+      valid = valid && chunk_ptr->raw_sz <= UINT32_MAX;
+    } else {
+      valid = false;
+    }
+    if ( !valid ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: bundle `%s` has a corrupt entry for chunk %.4s\n", path, chunk_ptr->id );
+      return false;
+    }
+    if ( VOL_GEOM_BUNDLE_CODEC_STORED == chunk_ptr->codec ) { continue; }
+    if ( !_bundle_decode_chunk( bundle_ptr, i ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not decode chunk %.4s of bundle `%s`\n", chunk_ptr->id, path );
+      return false;
+    }
+  }
+  return true;
+}
+
+vol_geom_bundle_t* vol_geom_bundle_open( const char* path, const vol_geom_io_t* io_ptr ) {
+  if ( !path ) { return NULL; }
+  if ( io_ptr && ( !io_ptr->open_fn || !io_ptr->size_fn || !io_ptr->read_at_fn || !io_ptr->close_fn || ( io_ptr->async_read_at_fn && !io_ptr->async_wait_fn ) ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: I/O backend is missing callbacks.\n" );
+    return NULL;
+  }
+  vol_geom_bundle_t* bundle_ptr = calloc( 1, sizeof( vol_geom_bundle_t ) );
+  if ( !bundle_ptr ) { return NULL; }
+  bundle_ptr->io = io_ptr ? *io_ptr : ( _is_url( path ) ? vol_geom_io_http() : vol_geom_io_stdio() );
+
+  bundle_ptr->file_ptr = bundle_ptr->io.open_fn( path, bundle_ptr->io.user_ptr );
+  if ( !bundle_ptr->file_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not open bundle `%s`\n", path );
+    goto bundle_open_failed;
+  }
+  bundle_ptr->sz = bundle_ptr->io.size_fn( bundle_ptr->file_ptr, bundle_ptr->io.user_ptr );
+  if ( !_bundle_read_chunks( bundle_ptr, path ) ) { goto bundle_open_failed; }
+  return bundle_ptr;
+
+bundle_open_failed:
+  vol_geom_bundle_close( bundle_ptr );
+  return NULL;
+}
+
+void vol_geom_bundle_close( vol_geom_bundle_t* bundle_ptr ) {
+  if ( !bundle_ptr ) { return; }
+  if ( bundle_ptr->decoded_ptrs ) {
+    for ( int i = 0; i < bundle_ptr->n_chunks; i++ ) { free( bundle_ptr->decoded_ptrs[i] ); }
+  }
+  if ( bundle_ptr->file_ptr ) { bundle_ptr->io.close_fn( bundle_ptr->file_ptr, bundle_ptr->io.user_ptr ); }
+  free( bundle_ptr->decoded_ptrs );
+  free( bundle_ptr->chunks_ptr );
+  free( bundle_ptr );
+}
+
+vol_geom_size_t vol_geom_bundle_memory_used( const vol_geom_bundle_t* bundle_ptr ) {
+  if ( !bundle_ptr ) { return 0; }
+  vol_geom_size_t sz = (vol_geom_size_t)sizeof( vol_geom_bundle_t );
+  sz += bundle_ptr->n_chunks * (vol_geom_size_t)( sizeof( vol_geom_bundle_chunk_t ) + sizeof( uint8_t* ) );
+  for ( int i = 0; i < bundle_ptr->n_chunks; i++ ) {
+    if ( bundle_ptr->decoded_ptrs[i] ) { sz += (vol_geom_size_t)bundle_ptr->chunks_ptr[i].raw_sz; }
+  }
+  return sz;
+}
+
+vol_geom_size_t vol_geom_bundle_release_decoded( vol_geom_bundle_t* bundle_ptr ) {
+  if ( !bundle_ptr ) { return 0; }
+  vol_geom_size_t freed_sz = 0;
+  for ( int i = 0; i < bundle_ptr->n_chunks; i++ ) {
+    if ( !bundle_ptr->decoded_ptrs[i] ) { continue; }
+    free( bundle_ptr->decoded_ptrs[i] );
+    bundle_ptr->decoded_ptrs[i] = NULL;
+    freed_sz += (vol_geom_size_t)bundle_ptr->chunks_ptr[i].raw_sz;
+  }
+  return freed_sz;
+}
+
+const vol_geom_bundle_chunk_t* vol_geom_bundle_find_chunk( const vol_geom_bundle_t* bundle_ptr, const char* id ) {
+  if ( !bundle_ptr || !id || 4 != strlen( id ) ) { return NULL; }
+  for ( int i = 0; i < bundle_ptr->n_chunks; i++ ) {
+    if ( 0 == memcmp( bundle_ptr->chunks_ptr[i].id, id, 4 ) ) { return &bundle_ptr->chunks_ptr[i]; }
+  }
+  return NULL;
+}
+
+bool vol_geom_bundle_read_chunk_at(
+  vol_geom_bundle_t* bundle_ptr, const vol_geom_bundle_chunk_t* chunk_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr ) {
+  if ( !bundle_ptr || !chunk_ptr || offset < 0 || sz < 0 || offset > (vol_geom_size_t)chunk_ptr->raw_sz || sz > (vol_geom_size_t)chunk_ptr->raw_sz - offset ) {
+    return false;
+  }
+  int chunk_idx = (int)( chunk_ptr - bundle_ptr->chunks_ptr );
+  if ( VOL_GEOM_BUNDLE_CODEC_STORED != chunk_ptr->codec ) {
+    // Released by vol_geom_bundle_release_decoded(), so decode it again.
+    if ( !bundle_ptr->decoded_ptrs[chunk_idx] && !_bundle_decode_chunk( bundle_ptr, chunk_idx ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: could not decode bundle chunk %.4s\n", chunk_ptr->id );
+      return false;
+    }
+    if ( sz > 0 ) { memcpy( dst_ptr, &bundle_ptr->decoded_ptrs[chunk_idx][offset], (size_t)sz ); }
+    return true;
+  }
+  return bundle_ptr->io.read_at_fn( bundle_ptr->file_ptr, (vol_geom_size_t)chunk_ptr->offset + offset, sz, dst_ptr, bundle_ptr->io.user_ptr );
+}
+
+// A chunk opened through vol_geom_io_bundle() uses its chunk table entry as the file handle, so opening and closing chunks allocates nothing.
+static void* _bundle_open( const char* path, void* user_ptr ) { return (void*)vol_geom_bundle_find_chunk( (vol_geom_bundle_t*)user_ptr, path ); }
+
+static vol_geom_size_t _bundle_size( void* file_ptr, void* user_ptr ) {
+  (void)user_ptr;
+  return (vol_geom_size_t)( (const vol_geom_bundle_chunk_t*)file_ptr )->raw_sz;
+}
+
+static bool _bundle_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  return vol_geom_bundle_read_chunk_at( (vol_geom_bundle_t*)user_ptr, (const vol_geom_bundle_chunk_t*)file_ptr, offset, sz, dst_ptr );
+}
 
-static void _default_logger( vol_geom_log_type_t log_type, const char* message_str ) {
-  FILE* stream_ptr = ( VOL_GEOM_LOG_TYPE_ERROR == log_type || VOL_GEOM_LOG_TYPE_WARNING == log_type ) ? stderr : stdout;
-  fprintf( stream_ptr, "%s", message_str );
+static void* _bundle_async_read_at( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr ) {
+  vol_geom_bundle_t* bundle_ptr            = (vol_geom_bundle_t*)user_ptr;
+  const vol_geom_bundle_chunk_t* chunk_ptr = (const vol_geom_bundle_chunk_t*)file_ptr;
+  // Compressed chunks are decoded whole into memory, so there is nothing to read ahead.
+  if ( VOL_GEOM_BUNDLE_CODEC_STORED != chunk_ptr->codec ) { return NULL; }
+  if ( offset < 0 || sz < 0 || offset > (vol_geom_size_t)chunk_ptr->raw_sz || sz > (vol_geom_size_t)chunk_ptr->raw_sz - offset ) { return NULL; }
+  return bundle_ptr->io.async_read_at_fn( bundle_ptr->file_ptr, (vol_geom_size_t)chunk_ptr->offset + offset, sz, dst_ptr, bundle_ptr->io.user_ptr );
 }
 
-static void ( *_logger_ptr )( vol_geom_log_type_t log_type, const char* message_str ) = _default_logger;
+static bool _bundle_async_wait( void* request_ptr, void* user_ptr ) {
+  vol_geom_bundle_t* bundle_ptr = (vol_geom_bundle_t*)user_ptr;
+  return bundle_ptr->io.async_wait_fn( request_ptr, bundle_ptr->io.user_ptr );
+}
 
-// This function is used in this file as a printf-style logger. It converts that format to a simple string and passes it to _logger_ptr.
-static void _vol_loggerf( vol_geom_log_type_t log_type, const char* message_str, ... ) {
-  char log_str[VOL_GEOM_LOG_STR_MAX_LEN];
-  log_str[0] = '\0';
-  va_list arg_ptr; // using va_args lets us make sure any printf-style formatting values are properly written into the string.
-  va_start( arg_ptr, message_str );
-  vsnprintf( log_str, VOL_GEOM_LOG_STR_MAX_LEN - 1, message_str, arg_ptr );
-  va_end( arg_ptr );
-  _logger_ptr( log_type, log_str );
+static void _bundle_close( void* file_ptr, void* user_ptr ) {
+  (void)file_ptr;
+  (void)user_ptr;
 }
 
-/// Helper struct to refer to an entire file loaded from disk via `_read_entire_file()`.
-typedef struct vol_geom_file_record_t {
-  /// Pointer to contents of file.
-  uint8_t* byte_ptr;
-  /// Size of file in bytes.
+vol_geom_io_t vol_geom_io_bundle( vol_geom_bundle_t* bundle_ptr ) {
+  vol_geom_io_t io =
+    ( vol_geom_io_t ){ .open_fn = _bundle_open, .size_fn = _bundle_size, .read_at_fn = _bundle_read_at, .close_fn = _bundle_close, .user_ptr = bundle_ptr };
+  if ( bundle_ptr && bundle_ptr->io.async_read_at_fn ) {
+    io.async_read_at_fn = _bundle_async_read_at;
+    io.async_wait_fn    = _bundle_async_wait;
+  }
+  if ( bundle_ptr ) { io.scan_read_sz = bundle_ptr->io.scan_read_sz; }
+  return io;
+}
+
+/// A file opened through a vol_geom_io_t, with a read position, and a read-ahead block so that the many small reads made while scanning the frame
+/// headers don't each become an I/O request.
+struct vol_geom_reader_t {
+  vol_geom_io_t io;
+  /// Handle returned by io.open_fn.
+  void* file_ptr;
+  /// Size of the file in bytes.
   vol_geom_size_t sz;
-} vol_geom_file_record_t;
+  /// Read position.
+  vol_geom_size_t pos;
+  /// Read-ahead block for small reads, its allocated size, and where it starts in the file.
+  uint8_t* block_ptr;
+  vol_geom_size_t block_capacity, block_offset, block_sz;
+  /// Frame read ahead by vol_geom_prefetch_frame() into prefetch_ptr, or -1 if none.
+  int prefetch_frame_idx;
+  /// The asynchronous read of that frame, or NULL once it has finished.
+  void* prefetch_request_ptr;
+  /// Set when the read has finished successfully.
+  bool prefetch_ok;
+  uint8_t* prefetch_ptr;
+};
+
+/** Waits for any asynchronous read ahead to finish. Backends don't have to support other reads while one is in flight. */
+static void _reader_finish_prefetch( vol_geom_reader_t* reader_ptr ) {
+  if ( !reader_ptr->prefetch_request_ptr ) { return; }
+  reader_ptr->prefetch_ok          = reader_ptr->io.async_wait_fn( reader_ptr->prefetch_request_ptr, reader_ptr->io.user_ptr );
+  reader_ptr->prefetch_request_ptr = NULL;
+}
 
-/******************************************************************************
-  BASIC API
-******************************************************************************/
+static void _reader_close( vol_geom_reader_t* reader_ptr ) {
+  if ( !reader_ptr ) { return; }
+  _reader_finish_prefetch( reader_ptr );
+  if ( reader_ptr->file_ptr ) { reader_ptr->io.close_fn( reader_ptr->file_ptr, reader_ptr->io.user_ptr ); }
+  free( reader_ptr->block_ptr );
+  free( reader_ptr->prefetch_ptr );
+  free( reader_ptr );
+}
+
+/** Replaces the read-ahead block with an empty one of `capacity` bytes, e.g. to scan a file in larger reads. */
+static bool _reader_set_block_capacity( vol_geom_reader_t* reader_ptr, vol_geom_size_t capacity ) {
+  free( reader_ptr->block_ptr );
+  reader_ptr->block_ptr      = malloc( (size_t)capacity );
+  reader_ptr->block_capacity = reader_ptr->block_ptr ? capacity : 0;
+  reader_ptr->block_offset   = 0;
+  reader_ptr->block_sz       = 0;
+  return NULL != reader_ptr->block_ptr;
+}
 
-/** Helper function to check the actual size of a file on disk.
- * @param filename Pointer to nul-terminated file path string. Must not be NULL.
- * @param sz_ptr   Size of the file, in bytes, is written to address pointed to by sz_ptr. Must not be NULL. Not written when returning false.
- * @return         False on any error, including bad parameters or file not found. Otherwise true on success, where sz_ptr is set.
+/** Opens a file with an I/O backend.
+ * @param io_ptr Backend to use. If NULL, http:// URLs are read with vol_geom_io_http() and anything else with vol_geom_io_stdio().
+ * @return A reader to close with _reader_close(), or NULL on error.
  */
-static bool _get_file_sz( const char* filename, vol_geom_size_t* sz_ptr ) {
-  struct vol_geom_stat64_t stbuf;
-  if ( 0 != vol_geom_stat64( filename, &stbuf ) ) { return false; }
-  *sz_ptr = stbuf.st_size;
+static vol_geom_reader_t* _reader_open( const vol_geom_io_t* io_ptr, const char* path ) {
+  vol_geom_reader_t* reader_ptr = calloc( 1, sizeof( vol_geom_reader_t ) );
+  if ( !reader_ptr ) { return NULL; }
+  reader_ptr->io                 = io_ptr ? *io_ptr : ( _is_url( path ) ? vol_geom_io_http() : vol_geom_io_stdio() );
+  reader_ptr->prefetch_frame_idx = -1;
+
+  reader_ptr->file_ptr = reader_ptr->io.open_fn( path, reader_ptr->io.user_ptr );
+  if ( !reader_ptr->file_ptr ) { goto reader_open_failed; }
+  reader_ptr->sz = reader_ptr->io.size_fn( reader_ptr->file_ptr, reader_ptr->io.user_ptr );
+  if ( reader_ptr->sz < 0 ) { goto reader_open_failed; }
+  if ( !_reader_set_block_capacity( reader_ptr, VOL_GEOM_READ_BLOCK_SZ ) ) { goto reader_open_failed; }
+  return reader_ptr;
+
+reader_open_failed:
+  _reader_close( reader_ptr );
+  return NULL;
+}
+
+static bool _reader_seek( vol_geom_reader_t* reader_ptr, vol_geom_size_t offset ) {
+  if ( offset < 0 || offset > reader_ptr->sz ) { return false; }
+  reader_ptr->pos = offset;
+  return true;
+}
+
+/** Reads exactly sz bytes from the current position, and advances the position. */
+static bool _reader_read( vol_geom_reader_t* reader_ptr, void* dst_ptr, vol_geom_size_t sz ) {
+  if ( sz < 0 || reader_ptr->pos + sz > reader_ptr->sz ) { return false; }
+  _reader_finish_prefetch( reader_ptr );
+  if ( sz >= reader_ptr->block_capacity ) {
+    if ( !reader_ptr->io.read_at_fn( reader_ptr->file_ptr, reader_ptr->pos, sz, dst_ptr, reader_ptr->io.user_ptr ) ) { return false; }
+  } else {
+    if ( reader_ptr->pos < reader_ptr->block_offset || reader_ptr->pos + sz > reader_ptr->block_offset + reader_ptr->block_sz ) {
+      vol_geom_size_t block_sz = reader_ptr->sz - reader_ptr->pos < reader_ptr->block_capacity ? reader_ptr->sz - reader_ptr->pos : reader_ptr->block_capacity;
+      reader_ptr->block_sz     = 0;
+      if ( !reader_ptr->io.read_at_fn( reader_ptr->file_ptr, reader_ptr->pos, block_sz, reader_ptr->block_ptr, reader_ptr->io.user_ptr ) ) { return false; }
+      reader_ptr->block_offset = reader_ptr->pos;
+      reader_ptr->block_sz     = block_sz;
+    }
+    memcpy( dst_ptr, &reader_ptr->block_ptr[reader_ptr->pos - reader_ptr->block_offset], (size_t)sz );
+  }
+  reader_ptr->pos += sz;
   return true;
 }
 
+/******************************************************************************
+  BASIC API
+******************************************************************************/
+
 /** Helper function to read an entire file into an array of bytes within struct pointed to by `fr_ptr`.
  * @warning        This function allocates memory that the caller must manually free after use.
- * @param filename Pointer to nul-terminated file path string. Must not be NULL.
+ * @param io_ptr   I/O backend to read with, or NULL for the default. See _reader_open().
+ * @param filename Pointer to nul-terminated file path string, or http:// URL. Must not be NULL.
  * @param fr_ptr   File contents and size are written to a structure pointed to by `fr_ptr`. Must not be NULL.
  * @return         False on any error.
  */
-static bool _read_entire_file( const char* filename, vol_geom_file_record_t* fr_ptr ) {
-  FILE* f_ptr = NULL;
+static bool _read_entire_file( const vol_geom_io_t* io_ptr, const char* filename, vol_geom_file_record_t* fr_ptr ) {
+  vol_geom_reader_t* reader_ptr = NULL;
 
   if ( !filename || !fr_ptr ) { goto vol_geom_read_entire_file_failed; }
 
-  if ( !_get_file_sz( filename, &fr_ptr->sz ) ) { goto vol_geom_read_entire_file_failed; }
+  reader_ptr = _reader_open( io_ptr, filename );
+  if ( !reader_ptr ) { goto vol_geom_read_entire_file_failed; }
+  fr_ptr->sz = reader_ptr->sz;
 
   _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for reading file\n", fr_ptr->sz );
   fr_ptr->byte_ptr = malloc( (size_t)fr_ptr->sz );
   if ( !fr_ptr->byte_ptr ) { goto vol_geom_read_entire_file_failed; }
 
-  f_ptr = fopen( filename, "rb" );
-  if ( !f_ptr ) { goto vol_geom_read_entire_file_failed; }
-  vol_geom_size_t nr = fread( fr_ptr->byte_ptr, fr_ptr->sz, 1, f_ptr );
-  if ( 1 != nr ) { goto vol_geom_read_entire_file_failed; }
+  if ( !_reader_read( reader_ptr, fr_ptr->byte_ptr, fr_ptr->sz ) ) { goto vol_geom_read_entire_file_failed; }
 
-  fclose( f_ptr );
+  _reader_close( reader_ptr );
   return true;
 vol_geom_read_entire_file_failed:
-  if ( f_ptr ) { fclose( f_ptr ); }
+  _reader_close( reader_ptr );
   return false;
 }
 
@@ -197,42 +1815,44 @@ static bool _read_vol_file_hdr( const vol_geom_file_record_t* fr, vol_geom_file_
   return true;
 }
 
-static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
-  assert( info_ptr && info_ptr->preallocated_frame_blob_ptr && frame_data_ptr );
-  if ( !info_ptr || !info_ptr->preallocated_frame_blob_ptr || !frame_data_ptr ) { return false; }
+/** Parse the offsets and sizes of each array in a frame's mesh data.
+ * @param block_data_ptr Start of the frame's mesh data, laid out as in an uncompressed sequence.
+ * @param block_data_sz  Size of the mesh data in bytes.
+ */
+static bool _read_vol_frame(
+  const vol_geom_info_t* info_ptr, int frame_idx, uint8_t* block_data_ptr, vol_geom_size_t block_data_sz, vol_geom_frame_data_t* frame_data_ptr ) {
+  assert( info_ptr && block_data_ptr && frame_data_ptr );
+  if ( !info_ptr || !block_data_ptr || !frame_data_ptr ) { return false; }
   if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) { return false; }
 
   *frame_data_ptr = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
 
-  uint8_t* byte_blob_ptr         = (uint8_t*)info_ptr->preallocated_frame_blob_ptr;
-  frame_data_ptr->block_data_ptr = &byte_blob_ptr[info_ptr->frames_directory_ptr[frame_idx].hdr_sz];
-  frame_data_ptr->block_data_sz  = info_ptr->frames_directory_ptr[frame_idx].corrected_payload_sz;
+  frame_data_ptr->block_data_ptr = block_data_ptr;
+  frame_data_ptr->block_data_sz  = block_data_sz;
 
   {
     // start within the frame's memory but after its frame header and at the start of mesh data
     vol_geom_size_t curr_offset = 0;
 
     { // vertices
-      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)frame_data_ptr->vertices_sz ) ) {
-        return false;
-      }
+      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) ) ) { return false; }
 
       memcpy( &frame_data_ptr->vertices_sz, &frame_data_ptr->block_data_ptr[curr_offset], sizeof( int32_t ) );
       if ( frame_data_ptr->vertices_sz < 0 ) { return false; }
       curr_offset += (vol_geom_size_t)sizeof( int32_t );
+      if ( frame_data_ptr->block_data_sz < curr_offset + (vol_geom_size_t)frame_data_ptr->vertices_sz ) { return false; }
       frame_data_ptr->vertices_offset = curr_offset;
       curr_offset += (vol_geom_size_t)frame_data_ptr->vertices_sz;
     }
 
     // normals
     if ( info_ptr->hdr.normals && info_ptr->hdr.version >= 11 ) {
-      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)frame_data_ptr->normals_sz ) ) {
-        return false;
-      }
+      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) ) ) { return false; }
 
       memcpy( &frame_data_ptr->normals_sz, &frame_data_ptr->block_data_ptr[curr_offset], sizeof( int32_t ) );
       if ( frame_data_ptr->normals_sz < 0 ) { return false; }
       curr_offset += (vol_geom_size_t)sizeof( int32_t );
+      if ( frame_data_ptr->block_data_sz < curr_offset + (vol_geom_size_t)frame_data_ptr->normals_sz ) { return false; }
       frame_data_ptr->normals_offset = curr_offset;
       curr_offset += (vol_geom_size_t)frame_data_ptr->normals_sz;
     }
@@ -240,38 +1860,36 @@ static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol
     // indices and UVs
     if ( info_ptr->frame_headers_ptr[frame_idx].keyframe == 1 || ( info_ptr->hdr.version >= 12 && info_ptr->frame_headers_ptr[frame_idx].keyframe == 2 ) ) {
       { // indices
-        if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)frame_data_ptr->indices_sz ) ) {
-          return false;
-        }
+        if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) ) ) { return false; }
 
         memcpy( &frame_data_ptr->indices_sz, &frame_data_ptr->block_data_ptr[curr_offset], sizeof( int32_t ) );
         if ( frame_data_ptr->indices_sz < 0 ) { return false; }
         curr_offset += (vol_geom_size_t)sizeof( int32_t );
+        if ( frame_data_ptr->block_data_sz < curr_offset + (vol_geom_size_t)frame_data_ptr->indices_sz ) { return false; }
         frame_data_ptr->indices_offset = curr_offset;
         curr_offset += (vol_geom_size_t)frame_data_ptr->indices_sz;
       }
 
       { // UVs
-        if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)frame_data_ptr->uvs_sz ) ) { return false; }
+        if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) ) ) { return false; }
 
         memcpy( &frame_data_ptr->uvs_sz, &frame_data_ptr->block_data_ptr[curr_offset], sizeof( int32_t ) );
         if ( frame_data_ptr->uvs_sz < 0 ) { return false; }
         curr_offset += (vol_geom_size_t)sizeof( int32_t );
+        if ( frame_data_ptr->block_data_sz < curr_offset + (vol_geom_size_t)frame_data_ptr->uvs_sz ) { return false; }
         frame_data_ptr->uvs_offset = curr_offset;
         curr_offset += (vol_geom_size_t)frame_data_ptr->uvs_sz;
       }
     } // endif indices & UVs
 
     // texture
-    // NOTE(Anton) not tested since we aren't using embedded textures at the moment.
     if ( info_ptr->hdr.version >= 11 && info_ptr->hdr.textured ) {
-      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) + (vol_geom_size_t)frame_data_ptr->texture_sz ) ) {
-        return false;
-      }
+      if ( frame_data_ptr->block_data_sz < ( curr_offset + (vol_geom_size_t)sizeof( int32_t ) ) ) { return false; }
 
       memcpy( &frame_data_ptr->texture_sz, &frame_data_ptr->block_data_ptr[curr_offset], sizeof( int32_t ) );
       if ( frame_data_ptr->texture_sz < 0 ) { return false; }
       curr_offset += (vol_geom_size_t)sizeof( int32_t );
+      if ( frame_data_ptr->block_data_sz < curr_offset + (vol_geom_size_t)frame_data_ptr->texture_sz ) { return false; }
       frame_data_ptr->texture_offset = curr_offset;
       curr_offset += (vol_geom_size_t)frame_data_ptr->texture_sz;
     }
@@ -280,26 +1898,15 @@ static bool _read_vol_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol
   return true;
 }
 
-bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
-  assert( seq_filename && info_ptr && frame_data_ptr );
-  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
-
-  if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx, info_ptr->hdr.frame_count );
-    return false;
-  }
-
+/** Read, decode, and parse one frame, without regard to what it is predicted from. */
+static bool _read_and_decode_frame( const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
   // Get the offset of that frame and size required to allocate for it.
-  vol_geom_size_t offset_sz = info_ptr->frames_directory_ptr[frame_idx].offset_sz;
-  vol_geom_size_t total_sz  = info_ptr->frames_directory_ptr[frame_idx].total_sz;
+  vol_geom_size_t offset_sz     = info_ptr->frames_directory_ptr[frame_idx].offset_sz;
+  vol_geom_size_t total_sz      = info_ptr->frames_directory_ptr[frame_idx].total_sz;
+  vol_geom_reader_t* reader_ptr = info_ptr->_reader_ptr;
 
-  // Get file size and check for file size issues before allocating memory or reading
-  vol_geom_size_t file_sz = 0;
-  if ( !_get_file_sz( seq_filename, &file_sz ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file `%s` could not be opened.\n", seq_filename );
-    return false;
-  }
-  if ( file_sz < ( offset_sz + total_sz ) ) {
+  // Check for file size issues before reading. A preloaded sequence was read whole by the directory scan, which checked that every frame fits.
+  if ( reader_ptr && reader_ptr->sz < ( offset_sz + total_sz ) ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file is too short to contain frame %i data.\n", frame_idx );
     return false;
   }
@@ -314,43 +1921,138 @@ bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_
   if ( info_ptr->sequence_blob_byte_ptr ) {
     memcpy( info_ptr->preallocated_frame_blob_ptr, &info_ptr->sequence_blob_byte_ptr[offset_sz], total_sz );
 
-    // Read frame blob from file.
-  } else {
-    FILE* f_ptr = fopen( seq_filename, "rb" );
-    if ( !f_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR could not open file `%s` for frame data.\n", seq_filename );
-      return false;
-    }
-    if ( 0 != vol_geom_fseeko( f_ptr, offset_sz, SEEK_SET ) ) {
+    // Read frame blob with the file kept open since vol_geom_create_file_info(), unless vol_geom_prefetch_frame() already read it.
+  } else if ( reader_ptr ) {
+    _reader_finish_prefetch( reader_ptr );
+    if ( reader_ptr->prefetch_ok && reader_ptr->prefetch_frame_idx == frame_idx ) {
+      memcpy( info_ptr->preallocated_frame_blob_ptr, reader_ptr->prefetch_ptr, total_sz );
+    } else if ( !_reader_seek( reader_ptr, offset_sz ) ) {
       _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR seeking frame %i from sequence file - file too small for data\n", frame_idx );
-      fclose( f_ptr );
       return false;
-    }
-    if ( !fread( info_ptr->preallocated_frame_blob_ptr, total_sz, 1, f_ptr ) ) {
+    } else if ( !_reader_read( reader_ptr, info_ptr->preallocated_frame_blob_ptr, total_sz ) ) {
       _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
-      fclose( f_ptr );
       return false;
     }
-    fclose( f_ptr );
+  } else {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: no sequence file is open to read frame %i from\n", frame_idx );
+    return false;
   } // end FILE i/o block
 
-  if ( !_read_vol_frame( info_ptr, frame_idx, frame_data_ptr ) ) {
+  uint8_t* block_data_ptr       = &info_ptr->preallocated_frame_blob_ptr[info_ptr->frames_directory_ptr[frame_idx].hdr_sz];
+  vol_geom_size_t block_data_sz = info_ptr->frames_directory_ptr[frame_idx].corrected_payload_sz;
+  if ( info_ptr->decoded_frame_blob_ptr ) {
+    if ( !_decode_frame_streams( info_ptr, frame_idx, block_data_ptr, block_data_sz, info_ptr->decoded_frame_blob_ptr, info_ptr->biggest_decoded_frame_blob_sz,
+           &block_data_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR decoding compressed frame %i\n", frame_idx );
+      return false;
+    }
+    block_data_ptr = info_ptr->decoded_frame_blob_ptr;
+  }
+
+  if ( !_read_vol_frame( info_ptr, frame_idx, block_data_ptr, block_data_sz, frame_data_ptr ) ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
     return false;
   }
   return true;
 }
 
+bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  assert( seq_filename && info_ptr && frame_data_ptr );
+  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
+
+  if ( frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx, info_ptr->hdr.frame_count );
+    return false;
+  }
+
+  // A tracked frame in a temporally predicted sequence needs the frame before it decoded first. When seeking, that means decoding forward from the keyframe.
+  const vol_geom_decoder_state_t* state_ptr = info_ptr->_decoder_state_ptr;
+  if ( state_ptr && state_ptr->predicted && !vol_geom_is_keyframe( info_ptr, frame_idx ) && state_ptr->reference_frame_idx != frame_idx - 1 ) {
+    int keyframe_idx = vol_geom_find_previous_keyframe( info_ptr, frame_idx );
+    if ( keyframe_idx < 0 ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: no keyframe found before predicted frame %i\n", frame_idx );
+      return false;
+    }
+    // Resume from the reference if it is already part of the way along this keyframe group.
+    int first_idx = ( state_ptr->reference_frame_idx >= keyframe_idx && state_ptr->reference_frame_idx < frame_idx ) ? state_ptr->reference_frame_idx + 1 : keyframe_idx;
+    for ( int i = first_idx; i < frame_idx; i++ ) {
+      if ( !_read_and_decode_frame( info_ptr, i, frame_data_ptr ) ) { return false; }
+    }
+  }
+
+  return _read_and_decode_frame( info_ptr, frame_idx, frame_data_ptr );
+}
+
+bool vol_geom_prefetch_frame( const vol_geom_info_t* info_ptr, int frame_idx ) {
+  if ( !info_ptr || frame_idx < 0 || frame_idx >= info_ptr->hdr.frame_count ) { return false; }
+
+  // Preloaded sequences, and backends without asynchronous reads, have nothing to start.
+  vol_geom_reader_t* reader_ptr = info_ptr->_reader_ptr;
+  if ( !reader_ptr || !reader_ptr->io.async_read_at_fn ) { return true; }
+  if ( reader_ptr->prefetch_frame_idx == frame_idx && ( reader_ptr->prefetch_request_ptr || reader_ptr->prefetch_ok ) ) { return true; }
+
+  _reader_finish_prefetch( reader_ptr );
+  if ( !reader_ptr->prefetch_ptr ) {
+    reader_ptr->prefetch_ptr = malloc( (size_t)info_ptr->biggest_frame_blob_sz );
+    if ( !reader_ptr->prefetch_ptr ) { return false; }
+  }
+  reader_ptr->prefetch_frame_idx   = frame_idx;
+  reader_ptr->prefetch_ok          = false;
+  reader_ptr->prefetch_request_ptr = reader_ptr->io.async_read_at_fn( reader_ptr->file_ptr, info_ptr->frames_directory_ptr[frame_idx].offset_sz,
+    info_ptr->frames_directory_ptr[frame_idx].total_sz, reader_ptr->prefetch_ptr, reader_ptr->io.user_ptr );
+  if ( !reader_ptr->prefetch_request_ptr ) {
+    reader_ptr->prefetch_frame_idx = -1;
+    return false;
+  }
+  return true;
+}
+
+/** Read the stream headers of one compressed frame during the directory scan, to find the frame's decoded size.
+ * @param reader_ptr    File positioned at the start of the frame's mesh data. The position is left somewhere inside the frame.
+ * @param payload_sz    Stored size of the frame's mesh data.
+ * @param predicted_ptr Set to true if any stream is predicted from the previous frame. Otherwise left unchanged.
+ * @param quantized_ptr Set to true if any stream is decoded via 16-bit words, which needs scratch memory. Otherwise left unchanged.
+ */
+static bool _scan_frame_streams( vol_geom_reader_t* reader_ptr, const vol_geom_file_hdr_t* hdr_ptr, uint8_t keyframe, vol_geom_size_t payload_sz, vol_geom_size_t* decoded_sz_ptr,
+  bool* predicted_ptr, bool* quantized_ptr ) {
+  vol_geom_size_t scanned_sz = 0, decoded_sz = 0;
+  int n_streams              = _frame_stream_count( hdr_ptr, keyframe );
+  for ( int s = 0; s < n_streams; s++ ) {
+    int32_t stored_sz                = 0;
+    vol_geom_stream_hdr_t stream_hdr = ( vol_geom_stream_hdr_t ){ .raw_sz = 0 };
+    if ( !_reader_read( reader_ptr, &stored_sz, sizeof( int32_t ) ) ) { return false; }
+    if ( stored_sz < (int32_t)sizeof( vol_geom_stream_hdr_t ) ) { return false; }
+    scanned_sz += (vol_geom_size_t)sizeof( int32_t ) + stored_sz;
+    if ( scanned_sz > payload_sz ) { return false; }
+    if ( !_reader_read( reader_ptr, &stream_hdr, sizeof( vol_geom_stream_hdr_t ) ) ) { return false; }
+    if ( stream_hdr.raw_sz > INT32_MAX ) { return false; }
+    decoded_sz += (vol_geom_size_t)sizeof( int32_t ) + stream_hdr.raw_sz;
+    if ( VOL_GEOM_STREAM_CODEC_DELTA_Q16 == stream_hdr.codec ) { *predicted_ptr = true; }
+    if ( stream_hdr.codec >= VOL_GEOM_STREAM_CODEC_DELTA_Q16 && stream_hdr.codec < VOL_GEOM_STREAM_CODEC_MAX ) { *quantized_ptr = true; }
+    if ( !_reader_seek( reader_ptr, reader_ptr->pos + stored_sz - (vol_geom_size_t)sizeof( vol_geom_stream_hdr_t ) ) ) { return false; }
+  }
+  *decoded_sz_ptr = decoded_sz;
+  return true;
+}
+
 bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  return vol_geom_create_file_info_io( hdr_filename, seq_filename, info_ptr, streaming_mode, NULL );
+}
+
+bool vol_geom_create_file_info_io( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode, const vol_geom_io_t* io_ptr ) {
   if ( !hdr_filename || !seq_filename || !info_ptr ) { return false; }
+  if ( io_ptr && ( !io_ptr->open_fn || !io_ptr->size_fn || !io_ptr->read_at_fn || !io_ptr->close_fn || ( io_ptr->async_read_at_fn && !io_ptr->async_wait_fn ) ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: I/O backend is missing callbacks.\n" );
+    return false;
+  }
 
-  FILE* f_ptr = NULL; // this is checked later so declare & init up top.
+  vol_geom_reader_t* reader_ptr = NULL; // this is checked later so declare & init up top.
   // Read file header.
   vol_geom_file_record_t record = ( vol_geom_file_record_t ){ .sz = 0 };
   vol_geom_size_t hdr_sz        = 0;
   *info_ptr                     = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 }; // zero in case of struct re-use.
   {
-    if ( !_read_entire_file( hdr_filename, &record ) ) { goto failed_to_read_info; }
+    if ( !_read_entire_file( io_ptr, hdr_filename, &record ) ) { goto failed_to_read_info; }
     if ( !_read_vol_file_hdr( &record, &info_ptr->hdr, &hdr_sz ) ) { goto failed_to_read_info; }
 
     // done with file record so tidy-up memory
@@ -382,16 +2084,24 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
 
   info_ptr->biggest_frame_blob_sz = 0;
   int biggest_frame_idx           = -1;
+  bool temporally_predicted       = false;
+  bool quantized                  = false;
 
   // find out the size and offset of every frame
   { // fetch frame from sequence file
-    vol_geom_size_t sequence_file_sz = 0;
-    if ( !_get_file_sz( seq_filename, &sequence_file_sz ) ) { goto failed_to_read_info; }
+    reader_ptr = _reader_open( io_ptr, seq_filename );
+    if ( !reader_ptr ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Could not open file `%s`\n", seq_filename );
+      goto failed_to_read_info;
+    }
+    vol_geom_size_t sequence_file_sz = reader_ptr->sz;
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Sequence file is %" PRId64 " bytes\n", sequence_file_sz );
 
-    f_ptr = fopen( seq_filename, "rb" );
-    if ( !f_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Could not open file `%s`\n", seq_filename );
+    // Scan in large reads where that's cheaper than a read per frame: a file to be held in memory is read whole, and kept as the sequence blob, and a
+    // backend with slow requests, e.g. HTTP, gives the size it wants.
+    vol_geom_size_t scan_block_sz = streaming_mode ? reader_ptr->io.scan_read_sz : sequence_file_sz;
+    if ( scan_block_sz > VOL_GEOM_READ_BLOCK_SZ && !_reader_set_block_capacity( reader_ptr, scan_block_sz ) ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating %" PRId64 " bytes to scan sequence file\n", scan_block_sz );
       goto failed_to_read_info;
     }
 
@@ -399,10 +2109,9 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
     for ( int32_t i = 0; i < info_ptr->hdr.frame_count; i++ ) {
       vol_geom_frame_hdr_t frame_hdr = ( vol_geom_frame_hdr_t ){ .mesh_data_sz = 0 };
 
-      vol_geom_size_t frame_start_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_start_offset ) { goto failed_to_read_info; }
+      vol_geom_size_t frame_start_offset = reader_ptr->pos;
 
-      if ( !fread( &frame_hdr.frame_number, sizeof( int32_t ), 1, f_ptr ) ) {
+      if ( !_reader_read( reader_ptr, &frame_hdr.frame_number, sizeof( int32_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number at frame %i in sequence file was out of file size range\n", i );
         goto failed_to_read_info;
       }
@@ -410,7 +2119,7 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number was %i at frame %i in sequence file\n", frame_hdr.frame_number, i );
         goto failed_to_read_info;
       }
-      if ( !fread( &frame_hdr.mesh_data_sz, sizeof( int32_t ), 1, f_ptr ) ) {
+      if ( !_reader_read( reader_ptr, &frame_hdr.mesh_data_sz, sizeof( int32_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: mesh_data_sz %i was out of file size range in sequence file\n", frame_hdr.mesh_data_sz );
         goto failed_to_read_info;
       }
@@ -419,13 +2128,12 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
           frame_hdr.mesh_data_sz, sequence_file_sz );
         goto failed_to_read_info;
       }
-      if ( !fread( &frame_hdr.keyframe, sizeof( uint8_t ), 1, f_ptr ) ) {
+      if ( !_reader_read( reader_ptr, &frame_hdr.keyframe, sizeof( uint8_t ) ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: keyframe (type) was out of file size range in sequence file\n" );
         goto failed_to_read_info;
       }
 
-      vol_geom_size_t frame_current_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_current_offset ) { goto failed_to_read_info; }
+      vol_geom_size_t frame_current_offset = reader_ptr->pos;
       info_ptr->frames_directory_ptr[i].hdr_sz = (vol_geom_size_t)frame_current_offset - (vol_geom_size_t)frame_start_offset;
 
       // in version 12 mesh_data_sz includes array sizes, but earlier versions need to add that to payload size
@@ -449,13 +2157,25 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         goto failed_to_read_info;
       }
 
+      // compressed sequences record their streams' decoded sizes so that a decoding buffer can be allocated up-front
+      info_ptr->frames_directory_ptr[i].decoded_payload_sz = info_ptr->frames_directory_ptr[i].corrected_payload_sz;
+      if ( VOL_GEOM_COMPRESSION_STREAMS == info_ptr->hdr.compression ) {
+        vol_geom_size_t decoded_sz = 0;
+        if ( !_scan_frame_streams( reader_ptr, &info_ptr->hdr, frame_hdr.keyframe, info_ptr->frames_directory_ptr[i].corrected_payload_sz, &decoded_sz,
+               &temporally_predicted, &quantized ) ) {
+          _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i has invalid compressed streams\n", i );
+          goto failed_to_read_info;
+        }
+        info_ptr->frames_directory_ptr[i].decoded_payload_sz = decoded_sz;
+        if ( decoded_sz > info_ptr->biggest_decoded_frame_blob_sz ) { info_ptr->biggest_decoded_frame_blob_sz = decoded_sz; }
+      }
+
       // seek past mesh data and past the final integer "frame data size". see if file is big enough
-      if ( 0 != vol_geom_fseeko( f_ptr, info_ptr->frames_directory_ptr[i].corrected_payload_sz + 4, SEEK_CUR ) ) {
+      if ( !_reader_seek( reader_ptr, frame_current_offset + info_ptr->frames_directory_ptr[i].corrected_payload_sz + 4 ) ) {
         _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: not enough memory in sequence file for frame %i contents\n", i );
         goto failed_to_read_info;
       }
-      frame_current_offset = vol_geom_ftello( f_ptr );
-      if ( -1LL == frame_current_offset ) { goto failed_to_read_info; }
+      frame_current_offset = reader_ptr->pos;
 
       // update frame directory and store frame header
       info_ptr->frames_directory_ptr[i].offset_sz = (vol_geom_size_t)frame_start_offset;
@@ -472,8 +2192,30 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
         biggest_frame_idx               = i;
       }
     }
-    fclose( f_ptr );
-    f_ptr = NULL; // this is checked later, so make = NULL
+
+    // If not dealing with huge sequence files - preload the whole thing to memory to avoid file i/o problems.
+    // Otherwise keep the file open for reading frames.
+    if ( !streaming_mode ) {
+      if ( sequence_file_sz > 0 && 0 == reader_ptr->block_offset && sequence_file_sz == reader_ptr->block_sz ) {
+        // The scan read the whole file into its block, so keep that rather than reading the file again.
+        info_ptr->sequence_blob_byte_ptr = reader_ptr->block_ptr;
+        reader_ptr->block_ptr            = NULL;
+      } else {
+        _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
+        info_ptr->sequence_blob_byte_ptr = malloc( (size_t)( sequence_file_sz > 0 ? sequence_file_sz : 1 ) );
+        if ( !info_ptr->sequence_blob_byte_ptr ) { goto failed_to_read_info; }
+        if ( !_reader_seek( reader_ptr, 0 ) || !_reader_read( reader_ptr, info_ptr->sequence_blob_byte_ptr, sequence_file_sz ) ) { goto failed_to_read_info; }
+      }
+      info_ptr->sequence_blob_sz = sequence_file_sz;
+      _reader_close( reader_ptr );
+    } else {
+      // Frames are read whole from here on, so the scan's large block is no longer needed.
+      if ( reader_ptr->block_capacity > VOL_GEOM_READ_BLOCK_SZ && !_reader_set_block_capacity( reader_ptr, VOL_GEOM_READ_BLOCK_SZ ) ) {
+        goto failed_to_read_info;
+      }
+      info_ptr->_reader_ptr = reader_ptr;
+    }
+    reader_ptr = NULL; // this is checked later, so make = NULL
   }
 
   _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 " (frame %i)\n", info_ptr->biggest_frame_blob_sz, biggest_frame_idx );
@@ -487,12 +2229,30 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
     goto failed_to_read_info;
   }
 
-  // If not dealing with huge sequence files - preload the whole thing to memory to avoid file i/o problems.
-  if ( !streaming_mode ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
-    vol_geom_file_record_t seq_blob = ( vol_geom_file_record_t ){ .sz = 0 };
-    if ( !_read_entire_file( seq_filename, &seq_blob ) ) { goto failed_to_read_info; }
-    info_ptr->sequence_blob_byte_ptr = (uint8_t*)seq_blob.byte_ptr;
+  if ( VOL_GEOM_COMPRESSION_STREAMS == info_ptr->hdr.compression ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating decoded_frame_blob_ptr bytes %" PRId64 "\n", info_ptr->biggest_decoded_frame_blob_sz );
+    if ( info_ptr->biggest_decoded_frame_blob_sz >= 1024 * 1024 * 1024 ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high decoded frame size %" PRId64 " reported - assuming error.\n", info_ptr->biggest_decoded_frame_blob_sz );
+      goto failed_to_read_info;
+    }
+    info_ptr->decoded_frame_blob_ptr = calloc( 1, info_ptr->biggest_decoded_frame_blob_sz > 0 ? info_ptr->biggest_decoded_frame_blob_sz : 1 );
+    if ( !info_ptr->decoded_frame_blob_ptr ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating decoded frame blob reserve.\n" );
+      goto failed_to_read_info;
+    }
+  }
+  if ( quantized ) {
+    // 16-bit words are at most half the size of the floats they decode to.
+    info_ptr->_decoder_state_ptr = calloc( 1, sizeof( vol_geom_decoder_state_t ) );
+    if ( !info_ptr->_decoder_state_ptr ) { goto failed_to_read_info; }
+    info_ptr->_decoder_state_ptr->predicted           = temporally_predicted;
+    info_ptr->_decoder_state_ptr->reference_frame_idx = -1;
+    info_ptr->_decoder_state_ptr->scratch_sz          = info_ptr->biggest_decoded_frame_blob_sz / 2 + 16;
+    info_ptr->_decoder_state_ptr->scratch_ptr         = calloc( 1, (size_t)info_ptr->_decoder_state_ptr->scratch_sz );
+    if ( !info_ptr->_decoder_state_ptr->scratch_ptr ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating decoder state.\n" );
+      goto failed_to_read_info;
+    }
   }
 
   return true;
@@ -500,7 +2260,7 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
 failed_to_read_info:
 
   _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to parse info from vologram geometry files.\n" );
-  if ( f_ptr ) { fclose( f_ptr ); }
+  _reader_close( reader_ptr );
   if ( record.byte_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
     free( record.byte_ptr );
@@ -510,6 +2270,53 @@ failed_to_read_info:
   return false;
 }
 
+/** Reads a bundle's bounds chunk, if it has one, into info_ptr. A chunk that doesn't match the sequence is ignored, as the bounds are only an optimisation. */
+static void _bundle_read_bounds( vol_geom_bundle_t* bundle_ptr, vol_geom_info_t* info_ptr ) {
+  const vol_geom_bundle_chunk_t* chunk_ptr = vol_geom_bundle_find_chunk( bundle_ptr, VOL_GEOM_BUNDLE_CHUNK_BOUNDS );
+  if ( !chunk_ptr ) { return; }
+  vol_geom_size_t frames_sz = (vol_geom_size_t)info_ptr->hdr.frame_count * 6 * (vol_geom_size_t)sizeof( float );
+  if ( chunk_ptr->raw_sz != (uint64_t)( frames_sz + 6 * sizeof( float ) ) ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_WARNING, "WARNING: bundle bounds chunk is %" PRIu64 " bytes, which doesn't match the sequence's %i frames. Ignoring it.\n",
+      chunk_ptr->raw_sz, info_ptr->hdr.frame_count );
+    return;
+  }
+  info_ptr->frame_aabbs_ptr = malloc( (size_t)( frames_sz > 0 ? frames_sz : 1 ) );
+  if ( !info_ptr->frame_aabbs_ptr || !vol_geom_bundle_read_chunk_at( bundle_ptr, chunk_ptr, 0, 6 * sizeof( float ), info_ptr->sequence_aabb ) ||
+       !vol_geom_bundle_read_chunk_at( bundle_ptr, chunk_ptr, 6 * sizeof( float ), frames_sz, info_ptr->frame_aabbs_ptr ) ) {
+    free( info_ptr->frame_aabbs_ptr );
+    info_ptr->frame_aabbs_ptr = NULL;
+  }
+}
+
+bool vol_geom_create_file_info_bundle( vol_geom_bundle_t* bundle_ptr, vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  if ( !bundle_ptr ) { return false; }
+  vol_geom_io_t io = vol_geom_io_bundle( bundle_ptr );
+  if ( !vol_geom_create_file_info_io( VOL_GEOM_BUNDLE_CHUNK_HEADER, VOL_GEOM_BUNDLE_CHUNK_SEQUENCE, info_ptr, streaming_mode, &io ) ) { return false; }
+  _bundle_read_bounds( bundle_ptr, info_ptr );
+  return true;
+}
+
+vol_geom_size_t vol_geom_memory_used( const vol_geom_info_t* info_ptr ) {
+  if ( !info_ptr ) { return 0; }
+  vol_geom_size_t sz = 0;
+  if ( info_ptr->frame_headers_ptr ) { sz += info_ptr->hdr.frame_count * (vol_geom_size_t)sizeof( vol_geom_frame_hdr_t ); }
+  if ( info_ptr->frames_directory_ptr ) { sz += info_ptr->hdr.frame_count * (vol_geom_size_t)sizeof( vol_geom_frame_directory_entry_t ); }
+  if ( info_ptr->frame_aabbs_ptr ) { sz += info_ptr->hdr.frame_count * 6 * (vol_geom_size_t)sizeof( float ); }
+  if ( info_ptr->preallocated_frame_blob_ptr ) { sz += info_ptr->biggest_frame_blob_sz; }
+  if ( info_ptr->decoded_frame_blob_ptr ) { sz += info_ptr->biggest_decoded_frame_blob_sz; }
+  sz += info_ptr->sequence_blob_sz;
+  const vol_geom_decoder_state_t* state_ptr = info_ptr->_decoder_state_ptr;
+  if ( state_ptr ) {
+    sz += (vol_geom_size_t)sizeof( vol_geom_decoder_state_t ) + state_ptr->reference_szs[0] + state_ptr->reference_szs[1] + state_ptr->scratch_sz;
+  }
+  const vol_geom_reader_t* reader_ptr = info_ptr->_reader_ptr;
+  if ( reader_ptr ) {
+    sz += (vol_geom_size_t)sizeof( vol_geom_reader_t ) + VOL_GEOM_READ_BLOCK_SZ;
+    if ( reader_ptr->prefetch_ptr ) { sz += info_ptr->biggest_frame_blob_sz; }
+  }
+  return sz;
+}
+
 bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
   if ( !info_ptr ) { return false; }
 
@@ -522,6 +2329,21 @@ bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing preallocated_frame_blob_ptr\n" );
     free( info_ptr->preallocated_frame_blob_ptr );
   }
+  if ( info_ptr->decoded_frame_blob_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing decoded_frame_blob_ptr\n" );
+    free( info_ptr->decoded_frame_blob_ptr );
+  }
+  if ( info_ptr->_decoder_state_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing _decoder_state_ptr\n" );
+    free( info_ptr->_decoder_state_ptr->reference_ptrs[0] );
+    free( info_ptr->_decoder_state_ptr->reference_ptrs[1] );
+    free( info_ptr->_decoder_state_ptr->scratch_ptr );
+    free( info_ptr->_decoder_state_ptr );
+  }
+  if ( info_ptr->_reader_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Closing _reader_ptr\n" );
+    _reader_close( info_ptr->_reader_ptr );
+  }
   if ( info_ptr->frame_headers_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing frame_headers_ptr\n" );
     free( info_ptr->frame_headers_ptr );
@@ -530,6 +2352,7 @@ bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
     _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing frames_directory_ptr\n" );
     free( info_ptr->frames_directory_ptr );
   }
+  free( info_ptr->frame_aabbs_ptr );
   *info_ptr = ( vol_geom_info_t ){ .hdr.frame_count = 0 };
 
   return true;
@@ -553,6 +2376,584 @@ int vol_geom_find_previous_keyframe( const vol_geom_info_t* info_ptr, int frame_
   return -1;
 }
 
+bool vol_geom_frames_share_topology( const vol_geom_info_t* info_ptr, int frame_a_idx, int frame_b_idx ) {
+  assert( info_ptr );
+  if ( !info_ptr ) { return false; }
+  int first_idx = frame_a_idx < frame_b_idx ? frame_a_idx : frame_b_idx;
+  int last_idx  = frame_a_idx < frame_b_idx ? frame_b_idx : frame_a_idx;
+  if ( first_idx < 0 || last_idx >= info_ptr->hdr.frame_count ) { return false; }
+  // Type 2 frames repeat the topology of their group for backward traversal, so only type 1 starts a new topology.
+  for ( int i = first_idx + 1; i <= last_idx; i++ ) {
+    if ( 1 == info_ptr->frame_headers_ptr[i].keyframe ) { return false; }
+  }
+  return true;
+}
+
+/// A range of floats for vol_geom_lerp_floats() to interpolate on one worker.
+typedef struct vol_geom_lerp_job_t {
+  const float* a_ptr;
+  const float* b_ptr;
+  float t;
+  float* dst_ptr;
+  vol_geom_size_t n_floats;
+} vol_geom_lerp_job_t;
+
+static void _lerp_floats( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, vol_geom_size_t n_floats ) {
+  vol_geom_size_t i = 0;
+#if defined( VOL_GEOM_SSE2 )
+  const __m128 t4 = _mm_set1_ps( t );
+  for ( ; i + 8 <= n_floats; i += 8 ) {
+    __m128 a0 = _mm_loadu_ps( &a_ptr[i] ), a1 = _mm_loadu_ps( &a_ptr[i + 4] );
+    __m128 b0 = _mm_loadu_ps( &b_ptr[i] ), b1 = _mm_loadu_ps( &b_ptr[i + 4] );
+    _mm_storeu_ps( &dst_ptr[i], _mm_add_ps( a0, _mm_mul_ps( _mm_sub_ps( b0, a0 ), t4 ) ) );
+    _mm_storeu_ps( &dst_ptr[i + 4], _mm_add_ps( a1, _mm_mul_ps( _mm_sub_ps( b1, a1 ), t4 ) ) );
+  }
+#elif defined( VOL_GEOM_NEON )
+  const float32x4_t t4 = vdupq_n_f32( t );
+  for ( ; i + 8 <= n_floats; i += 8 ) {
+    float32x4_t a0 = vld1q_f32( &a_ptr[i] ), a1 = vld1q_f32( &a_ptr[i + 4] );
+    float32x4_t b0 = vld1q_f32( &b_ptr[i] ), b1 = vld1q_f32( &b_ptr[i + 4] );
+    vst1q_f32( &dst_ptr[i], vmlaq_f32( a0, vsubq_f32( b0, a0 ), t4 ) );
+    vst1q_f32( &dst_ptr[i + 4], vmlaq_f32( a1, vsubq_f32( b1, a1 ), t4 ) );
+  }
+#endif
+  for ( ; i < n_floats; i++ ) { dst_ptr[i] = a_ptr[i] + ( b_ptr[i] - a_ptr[i] ) * t; }
+}
+
+static void _lerp_job( void* job_ctx_ptr, int job_idx ) {
+  vol_geom_lerp_job_t* job_ptr = &( (vol_geom_lerp_job_t*)job_ctx_ptr )[job_idx];
+  _lerp_floats( job_ptr->a_ptr, job_ptr->b_ptr, job_ptr->t, job_ptr->dst_ptr, job_ptr->n_floats );
+}
+
+void vol_geom_lerp_floats( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, vol_geom_size_t n_floats ) {
+  assert( a_ptr && b_ptr && dst_ptr );
+  if ( !a_ptr || !b_ptr || !dst_ptr || n_floats <= 0 ) { return; }
+  if ( n_floats < 2 * VOL_GEOM_RECONSTRUCT_JOB_FLOATS ) {
+    _lerp_floats( a_ptr, b_ptr, t, dst_ptr, n_floats );
+    return;
+  }
+  // Big meshes: spread over the workers in the same sized ranges as frame decoding.
+  vol_geom_lerp_job_t jobs[VOL_GEOM_MAX_RECONSTRUCT_JOBS];
+  int n_jobs = 0;
+  for ( vol_geom_size_t first = 0; first < n_floats; first += VOL_GEOM_RECONSTRUCT_JOB_FLOATS ) {
+    if ( n_jobs >= VOL_GEOM_MAX_RECONSTRUCT_JOBS ) {
+      jobs[n_jobs - 1].n_floats += n_floats - first;
+      break;
+    }
+    vol_geom_size_t n = n_floats - first < VOL_GEOM_RECONSTRUCT_JOB_FLOATS ? n_floats - first : VOL_GEOM_RECONSTRUCT_JOB_FLOATS;
+    jobs[n_jobs++]    = ( vol_geom_lerp_job_t ){ .a_ptr = &a_ptr[first], .b_ptr = &b_ptr[first], .t = t, .dst_ptr = &dst_ptr[first], .n_floats = n };
+  }
+  _parallel_for_ptr( n_jobs, _lerp_job, jobs );
+}
+
+#if defined( VOL_GEOM_SSE2 )
+/** Swaps the second and third corners of the 4 triangles in 12 32-bit indices:
+ * a0 b0 c0 a1 | b1 c1 a2 b2 | c2 a3 b3 c3 -> a0 c0 b0 a1 | c1 b1 a2 c2 | b2 a3 c3 b3. */
+static void _flip_4_triangles( __m128i* r0_ptr, __m128i* r1_ptr, __m128i* r2_ptr ) {
+  __m128 r1 = _mm_castsi128_ps( *r1_ptr ), r2 = _mm_castsi128_ps( *r2_ptr );
+  __m128 x  = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 0, 0, 2, 2 ) ); // c1 c1 c2 c2
+  __m128 y  = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 1, 1, 3, 3 ) ); // b2 b2 a3 a3
+  *r0_ptr   = _mm_shuffle_epi32( *r0_ptr, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+  *r1_ptr   = _mm_castps_si128( _mm_shuffle_ps( r1, x, _MM_SHUFFLE( 2, 0, 0, 1 ) ) );
+  *r2_ptr   = _mm_castps_si128( _mm_shuffle_ps( y, r2, _MM_SHUFFLE( 2, 3, 2, 0 ) ) );
+}
+
+/** Stores 12 32-bit indices, flipping their winding if asked, and ORs into out_of_range_ptr any lanes holding an index above max_idx_biased.
+ * Indices are compared with their sign bit flipped, as SSE2 only compares signed integers. */
+static void _store_12_indices( __m128i r0, __m128i r1, __m128i r2, bool flip_winding, __m128i max_idx_biased, __m128i* out_of_range_ptr, uint32_t* dst_ptr ) {
+  const __m128i bias = _mm_set1_epi32( (int)0x80000000u );
+  *out_of_range_ptr  = _mm_or_si128( *out_of_range_ptr, _mm_cmpgt_epi32( _mm_xor_si128( r0, bias ), max_idx_biased ) );
+  *out_of_range_ptr  = _mm_or_si128( *out_of_range_ptr, _mm_cmpgt_epi32( _mm_xor_si128( r1, bias ), max_idx_biased ) );
+  *out_of_range_ptr  = _mm_or_si128( *out_of_range_ptr, _mm_cmpgt_epi32( _mm_xor_si128( r2, bias ), max_idx_biased ) );
+  if ( flip_winding ) { _flip_4_triangles( &r0, &r1, &r2 ); }
+  _mm_storeu_si128( (__m128i*)dst_ptr, r0 );
+  _mm_storeu_si128( (__m128i*)( dst_ptr + 4 ), r1 );
+  _mm_storeu_si128( (__m128i*)( dst_ptr + 8 ), r2 );
+}
+#endif
+
+bool vol_geom_convert_indices( const void* src_ptr, int index_sz, int n_indices, int n_vertices, bool flip_winding, uint32_t* dst_ptr ) {
+  assert( src_ptr && dst_ptr );
+  if ( !src_ptr || !dst_ptr || ( 2 != index_sz && 4 != index_sz ) || n_indices < 0 || n_indices % 3 != 0 || n_vertices <= 0 ) { return false; }
+  const uint8_t* bytes_ptr = (const uint8_t*)src_ptr;
+  int i                    = 0;
+  bool in_range            = true;
+#if defined( VOL_GEOM_SSE2 )
+  const __m128i max_idx_biased = _mm_set1_epi32( (int)( (uint32_t)( n_vertices - 1 ) ^ 0x80000000u ) );
+  __m128i out_of_range         = _mm_setzero_si128();
+  if ( 2 == index_sz ) {
+    // 24 16-bit indices widen to 2 groups of 12, and 12 is a whole number of triangles.
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 24 <= n_indices; i += 24 ) {
+      __m128i a = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 2] );
+      __m128i b = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 2 + 16] );
+      __m128i c = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 2 + 32] );
+      _store_12_indices( _mm_unpacklo_epi16( a, zero ), _mm_unpackhi_epi16( a, zero ), _mm_unpacklo_epi16( b, zero ), flip_winding, max_idx_biased,
+        &out_of_range, &dst_ptr[i] );
+      _store_12_indices( _mm_unpackhi_epi16( b, zero ), _mm_unpacklo_epi16( c, zero ), _mm_unpackhi_epi16( c, zero ), flip_winding, max_idx_biased,
+        &out_of_range, &dst_ptr[i + 12] );
+    }
+  } else {
+    for ( ; i + 12 <= n_indices; i += 12 ) {
+      __m128i r0 = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 4] );
+      __m128i r1 = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 4 + 16] );
+      __m128i r2 = _mm_loadu_si128( (const __m128i*)&bytes_ptr[i * 4 + 32] );
+      _store_12_indices( r0, r1, r2, flip_winding, max_idx_biased, &out_of_range, &dst_ptr[i] );
+    }
+  }
+  in_range = 0 == _mm_movemask_epi8( out_of_range );
+#elif defined( VOL_GEOM_NEON )
+  const uint32x4_t max_idx = vdupq_n_u32( (uint32_t)( n_vertices - 1 ) );
+  uint32x4_t out_of_range  = vdupq_n_u32( 0 );
+  // vld3q splits 4 triangles into their first, second, and third corners, so flipping the winding is storing the last two the other way round.
+  for ( ; i + 12 <= n_indices; i += 12 ) {
+    uint32x4x3_t t;
+    if ( 2 == index_sz ) {
+      uint16x4x3_t t16 = vld3_u16( (const uint16_t*)&bytes_ptr[i * 2] );
+      for ( int c = 0; c < 3; c++ ) { t.val[c] = vmovl_u16( t16.val[c] ); }
+    } else {
+      t = vld3q_u32( (const uint32_t*)&bytes_ptr[i * 4] );
+    }
+    for ( int c = 0; c < 3; c++ ) { out_of_range = vorrq_u32( out_of_range, vcgtq_u32( t.val[c], max_idx ) ); }
+    if ( flip_winding ) {
+      uint32x4_t b = t.val[1];
+      t.val[1]     = t.val[2];
+      t.val[2]     = b;
+    }
+    vst3q_u32( &dst_ptr[i], t );
+  }
+  uint32x2_t out_of_range_2 = vorr_u32( vget_low_u32( out_of_range ), vget_high_u32( out_of_range ) );
+  in_range                  = 0 == ( vget_lane_u32( out_of_range_2, 0 ) | vget_lane_u32( out_of_range_2, 1 ) );
+#endif
+  // Triangles left over, or every triangle without SIMD. memcpy, as indices in a frame are not always aligned.
+  for ( ; i < n_indices; i += 3 ) {
+    uint32_t tri[3];
+    for ( int c = 0; c < 3; c++ ) {
+      if ( 2 == index_sz ) {
+        uint16_t idx16 = 0;
+        memcpy( &idx16, &bytes_ptr[( i + c ) * 2], sizeof( uint16_t ) );
+        tri[c] = idx16;
+      } else {
+        memcpy( &tri[c], &bytes_ptr[( i + c ) * 4], sizeof( uint32_t ) );
+      }
+      in_range = in_range && tri[c] < (uint32_t)n_vertices;
+    }
+    dst_ptr[i]     = tri[0];
+    dst_ptr[i + 1] = tri[flip_winding ? 2 : 1];
+    dst_ptr[i + 2] = tri[flip_winding ? 1 : 2];
+  }
+  if ( !in_range ) { _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame has an index outside its %i vertices\n", n_vertices ); }
+  return in_range;
+}
+
+/// A range of vertices for vol_geom_compute_aabb() to find the bounds of on one worker.
+typedef struct vol_geom_aabb_job_t {
+  const float* positions_ptr;
+  int n_vertices;
+  float aabb[6];
+} vol_geom_aabb_job_t;
+
+static void _aabb( const float* p_ptr, int n_vertices, float* aabb_ptr ) {
+  float mn[3] = { p_ptr[0], p_ptr[1], p_ptr[2] }, mx[3] = { p_ptr[0], p_ptr[1], p_ptr[2] };
+  int i = 0;
+#if defined( VOL_GEOM_SSE2 )
+  if ( n_vertices >= 4 ) {
+    // 4 vertices are x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3, so each register's lanes always hold the same channels, and can be reduced at the end.
+    __m128 a0 = _mm_loadu_ps( p_ptr ), a1 = _mm_loadu_ps( p_ptr + 4 ), a2 = _mm_loadu_ps( p_ptr + 8 );
+    __m128 mn0 = a0, mn1 = a1, mn2 = a2, mx0 = a0, mx1 = a1, mx2 = a2;
+    for ( i = 4; i + 4 <= n_vertices; i += 4 ) {
+      a0  = _mm_loadu_ps( &p_ptr[i * 3] );
+      a1  = _mm_loadu_ps( &p_ptr[i * 3 + 4] );
+      a2  = _mm_loadu_ps( &p_ptr[i * 3 + 8] );
+      mn0 = _mm_min_ps( mn0, a0 );
+      mn1 = _mm_min_ps( mn1, a1 );
+      mn2 = _mm_min_ps( mn2, a2 );
+      mx0 = _mm_max_ps( mx0, a0 );
+      mx1 = _mm_max_ps( mx1, a1 );
+      mx2 = _mm_max_ps( mx2, a2 );
+    }
+    float lanes[2][12];
+    _mm_storeu_ps( &lanes[0][0], mn0 );
+    _mm_storeu_ps( &lanes[0][4], mn1 );
+    _mm_storeu_ps( &lanes[0][8], mn2 );
+    _mm_storeu_ps( &lanes[1][0], mx0 );
+    _mm_storeu_ps( &lanes[1][4], mx1 );
+    _mm_storeu_ps( &lanes[1][8], mx2 );
+    for ( int l = 0; l < 12; l++ ) {
+      mn[l % 3] = lanes[0][l] < mn[l % 3] ? lanes[0][l] : mn[l % 3];
+      mx[l % 3] = lanes[1][l] > mx[l % 3] ? lanes[1][l] : mx[l % 3];
+    }
+  }
+#elif defined( VOL_GEOM_NEON )
+  if ( n_vertices >= 4 ) {
+    float32x4x3_t v  = vld3q_f32( p_ptr );
+    float32x4x3_t lo = v, hi = v;
+    for ( i = 4; i + 4 <= n_vertices; i += 4 ) {
+      v = vld3q_f32( &p_ptr[i * 3] );
+      for ( int c = 0; c < 3; c++ ) {
+        lo.val[c] = vminq_f32( lo.val[c], v.val[c] );
+        hi.val[c] = vmaxq_f32( hi.val[c], v.val[c] );
+      }
+    }
+    float lanes[2][12];
+    vst3q_f32( lanes[0], lo );
+    vst3q_f32( lanes[1], hi );
+    for ( int l = 0; l < 12; l++ ) {
+      mn[l % 3] = lanes[0][l] < mn[l % 3] ? lanes[0][l] : mn[l % 3];
+      mx[l % 3] = lanes[1][l] > mx[l % 3] ? lanes[1][l] : mx[l % 3];
+    }
+  }
+#endif
+  for ( ; i < n_vertices; i++ ) {
+    for ( int c = 0; c < 3; c++ ) {
+      float f = p_ptr[i * 3 + c];
+      mn[c]   = f < mn[c] ? f : mn[c];
+      mx[c]   = f > mx[c] ? f : mx[c];
+    }
+  }
+  for ( int c = 0; c < 3; c++ ) {
+    aabb_ptr[c]     = mn[c];
+    aabb_ptr[3 + c] = mx[c];
+  }
+}
+
+static void _aabb_job( void* job_ctx_ptr, int job_idx ) {
+  vol_geom_aabb_job_t* job_ptr = &( (vol_geom_aabb_job_t*)job_ctx_ptr )[job_idx];
+  _aabb( job_ptr->positions_ptr, job_ptr->n_vertices, job_ptr->aabb );
+}
+
+bool vol_geom_compute_aabb( const float* positions_ptr, int n_vertices, float* aabb_ptr ) {
+  assert( positions_ptr && aabb_ptr );
+  if ( !positions_ptr || !aabb_ptr ) { return false; }
+  if ( n_vertices <= 0 ) {
+    for ( int c = 0; c < 6; c++ ) { aabb_ptr[c] = 0.0f; }
+    return true;
+  }
+  const int job_vertices = VOL_GEOM_RECONSTRUCT_JOB_FLOATS / 3;
+  if ( n_vertices < 2 * job_vertices ) {
+    _aabb( positions_ptr, n_vertices, aabb_ptr );
+    return true;
+  }
+  // Big meshes: each worker reduces a range to its own bounds, then the few per-range bounds are reduced here.
+  vol_geom_aabb_job_t jobs[VOL_GEOM_MAX_RECONSTRUCT_JOBS];
+  int n_jobs = 0;
+  for ( int first = 0; first < n_vertices; first += job_vertices ) {
+    if ( n_jobs >= VOL_GEOM_MAX_RECONSTRUCT_JOBS ) {
+      jobs[n_jobs - 1].n_vertices += n_vertices - first;
+      break;
+    }
+    int n          = n_vertices - first < job_vertices ? n_vertices - first : job_vertices;
+    jobs[n_jobs++] = ( vol_geom_aabb_job_t ){ .positions_ptr = &positions_ptr[first * 3], .n_vertices = n };
+  }
+  _parallel_for_ptr( n_jobs, _aabb_job, jobs );
+  memcpy( aabb_ptr, jobs[0].aabb, 6 * sizeof( float ) );
+  for ( int j = 1; j < n_jobs; j++ ) {
+    for ( int c = 0; c < 3; c++ ) {
+      aabb_ptr[c]     = jobs[j].aabb[c] < aabb_ptr[c] ? jobs[j].aabb[c] : aabb_ptr[c];
+      aabb_ptr[3 + c] = jobs[j].aabb[3 + c] > aabb_ptr[3 + c] ? jobs[j].aabb[3 + c] : aabb_ptr[3 + c];
+    }
+  }
+  return true;
+}
+
+struct vol_geom_normals_topology_t {
+  int n_vertices;
+  int n_triangles;
+  /// 3 corners per triangle, in clockwise order from the front as in .vols files.
+  uint32_t* corners_ptr;
+  /// n_vertices + 1 offsets into triangle_ids_ptr.
+  /// Vertex v is a corner of triangles triangle_ids_ptr[first_ptr[v]] to triangle_ids_ptr[first_ptr[v + 1] - 1].
+  uint32_t* first_ptr;
+  uint32_t* triangle_ids_ptr;
+  /// Set by vol_geom_set_normals_topology_uvs(), or NULL. 2 floats per triangle: a face tangent is the first times the triangle's first edge
+  /// plus the second times its second edge.
+  float* tangent_coefs_ptr;
+  /// 3 floats per triangle, written by each vol_geom_compute_normals() or vol_geom_compute_tangents() call.
+  float* face_vectors_ptr;
+};
+
+vol_geom_normals_topology_t* vol_geom_create_normals_topology( const uint32_t* indices_ptr, int n_indices, int n_vertices, bool flip_winding ) {
+  assert( indices_ptr );
+  if ( !indices_ptr || n_indices < 3 || n_indices % 3 != 0 || n_vertices <= 0 ) { return NULL; }
+  for ( int i = 0; i < n_indices; i++ ) {
+    if ( indices_ptr[i] >= (uint32_t)n_vertices ) {
+      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: index %i is %" PRIu32 ", but the mesh has %i vertices\n", i, indices_ptr[i], n_vertices );
+      return NULL;
+    }
+  }
+  vol_geom_normals_topology_t* topology_ptr = calloc( 1, sizeof( vol_geom_normals_topology_t ) );
+  if ( !topology_ptr ) { return NULL; }
+  topology_ptr->n_vertices       = n_vertices;
+  topology_ptr->n_triangles      = n_indices / 3;
+  topology_ptr->corners_ptr      = malloc( (size_t)n_indices * sizeof( uint32_t ) );
+  topology_ptr->first_ptr        = calloc( (size_t)n_vertices + 1, sizeof( uint32_t ) );
+  topology_ptr->triangle_ids_ptr = malloc( (size_t)n_indices * sizeof( uint32_t ) );
+  topology_ptr->face_vectors_ptr = malloc( (size_t)n_indices * sizeof( float ) );
+  if ( !topology_ptr->corners_ptr || !topology_ptr->first_ptr || !topology_ptr->triangle_ids_ptr || !topology_ptr->face_vectors_ptr ) {
+    vol_geom_free_normals_topology( topology_ptr );
+    return NULL;
+  }
+
+  for ( int i = 0; i < n_indices; i += 3 ) {
+    topology_ptr->corners_ptr[i]     = indices_ptr[i];
+    topology_ptr->corners_ptr[i + 1] = indices_ptr[flip_winding ? i + 2 : i + 1];
+    topology_ptr->corners_ptr[i + 2] = indices_ptr[flip_winding ? i + 1 : i + 2];
+  }
+  // Count each vertex's triangles, turn the counts into offsets, then fill each vertex's list, using first_ptr[v + 1] as its write cursor.
+  for ( int i = 0; i < n_indices; i++ ) { topology_ptr->first_ptr[indices_ptr[i] + 1]++; }
+  for ( int v = 0; v < n_vertices; v++ ) { topology_ptr->first_ptr[v + 1] += topology_ptr->first_ptr[v]; }
+  for ( int i = 0; i < n_indices; i++ ) { topology_ptr->triangle_ids_ptr[topology_ptr->first_ptr[indices_ptr[i]]++] = (uint32_t)( i / 3 ); }
+  // Every cursor has moved to the start of the next vertex's list, so shift them back by one vertex.
+  for ( int v = n_vertices; v > 0; v-- ) { topology_ptr->first_ptr[v] = topology_ptr->first_ptr[v - 1]; }
+  topology_ptr->first_ptr[0] = 0;
+  return topology_ptr;
+}
+
+void vol_geom_free_normals_topology( vol_geom_normals_topology_t* topology_ptr ) {
+  if ( !topology_ptr ) { return; }
+  free( topology_ptr->corners_ptr );
+  free( topology_ptr->first_ptr );
+  free( topology_ptr->triangle_ids_ptr );
+  free( topology_ptr->tangent_coefs_ptr );
+  free( topology_ptr->face_vectors_ptr );
+  free( topology_ptr );
+}
+
+bool vol_geom_set_normals_topology_uvs(
+  vol_geom_normals_topology_t* topology_ptr, const float* uvs_ptr, int n_vertices, int8_t* handedness_ptr ) {
+  assert( topology_ptr && uvs_ptr && handedness_ptr );
+  if ( !topology_ptr || !uvs_ptr || !handedness_ptr || n_vertices != topology_ptr->n_vertices ) { return false; }
+  if ( !topology_ptr->tangent_coefs_ptr ) {
+    topology_ptr->tangent_coefs_ptr = malloc( (size_t)topology_ptr->n_triangles * 2 * sizeof( float ) );
+    if ( !topology_ptr->tangent_coefs_ptr ) { return false; }
+  }
+  // A triangle's edges are e1 = du1 * T + dv1 * B and e2 = du2 * T + dv2 * B. Solving for the tangent T gives ( dv2 * e1 - dv1 * e2 ) / det.
+  // Dividing by |det| is left out, so that each face tangent is weighted by the triangle's area in UV space, and UV slivers don't blow up.
+  // The sign of det also says whether the UVs are mirrored relative to the winding, which is the handedness of the tangent frame.
+  float* det_sums_ptr = calloc( (size_t)n_vertices, sizeof( float ) );
+  if ( !det_sums_ptr ) { return false; }
+  for ( int t = 0; t < topology_ptr->n_triangles; t++ ) {
+    const uint32_t* c_ptr = &topology_ptr->corners_ptr[t * 3];
+    float du1  = uvs_ptr[c_ptr[1] * 2] - uvs_ptr[c_ptr[0] * 2], dv1 = uvs_ptr[c_ptr[1] * 2 + 1] - uvs_ptr[c_ptr[0] * 2 + 1];
+    float du2  = uvs_ptr[c_ptr[2] * 2] - uvs_ptr[c_ptr[0] * 2], dv2 = uvs_ptr[c_ptr[2] * 2 + 1] - uvs_ptr[c_ptr[0] * 2 + 1];
+    float det  = du1 * dv2 - du2 * dv1;
+    float sign = det > 0.0f ? 1.0f : ( det < 0.0f ? -1.0f : 0.0f );
+
+    topology_ptr->tangent_coefs_ptr[t * 2]     = dv2 * sign;
+    topology_ptr->tangent_coefs_ptr[t * 2 + 1] = -dv1 * sign;
+    for ( int i = 0; i < 3; i++ ) { det_sums_ptr[c_ptr[i]] += det; }
+  }
+  // Vertices on a seam between mirrored UV islands take the handedness of the larger UV area around them.
+  for ( int v = 0; v < n_vertices; v++ ) { handedness_ptr[v] = det_sums_ptr[v] < 0.0f ? -1 : 1; }
+  free( det_sums_ptr );
+  return true;
+}
+
+/// A range of triangles or vertices for vol_geom_compute_normals() or vol_geom_compute_tangents() to process on one worker.
+typedef struct vol_geom_normals_job_t {
+  vol_geom_normals_topology_t* topology_ptr;
+  const float* positions_ptr;
+  /// Vertex normals: read when computing tangents.
+  const float* normals_ptr;
+  /// Vertex normals or tangents to write.
+  float* dst_ptr;
+  int first;
+  int count;
+} vol_geom_normals_job_t;
+
+/** Face normals of a range of triangles. They are not normalised.
+ * A cross product's length is twice the triangle's area, so summing them weights vertex normals by area. */
+static void _face_normals_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_geom_normals_job_t* job_ptr = &( (vol_geom_normals_job_t*)job_ctx_ptr )[job_idx];
+  const uint32_t* corners_ptr           = job_ptr->topology_ptr->corners_ptr;
+  const float* p_ptr                    = job_ptr->positions_ptr;
+  float* n_ptr                          = job_ptr->topology_ptr->face_vectors_ptr;
+  for ( int t = job_ptr->first; t < job_ptr->first + job_ptr->count; t++ ) {
+    const float* a_ptr = &p_ptr[corners_ptr[t * 3] * 3];
+    const float* b_ptr = &p_ptr[corners_ptr[t * 3 + 1] * 3];
+    const float* c_ptr = &p_ptr[corners_ptr[t * 3 + 2] * 3];
+    float ab[3]        = { b_ptr[0] - a_ptr[0], b_ptr[1] - a_ptr[1], b_ptr[2] - a_ptr[2] };
+    float ac[3]        = { c_ptr[0] - a_ptr[0], c_ptr[1] - a_ptr[1], c_ptr[2] - a_ptr[2] };
+    n_ptr[t * 3]       = ab[1] * ac[2] - ab[2] * ac[1];
+    n_ptr[t * 3 + 1]   = ab[2] * ac[0] - ab[0] * ac[2];
+    n_ptr[t * 3 + 2]   = ab[0] * ac[1] - ab[1] * ac[0];
+  }
+}
+
+/** Face tangents of a range of triangles, from the coefficients set up by vol_geom_set_normals_topology_uvs(). Not normalised, to weight by UV area. */
+static void _face_tangents_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_geom_normals_job_t* job_ptr = &( (vol_geom_normals_job_t*)job_ctx_ptr )[job_idx];
+  const uint32_t* corners_ptr           = job_ptr->topology_ptr->corners_ptr;
+  const float* coefs_ptr                = job_ptr->topology_ptr->tangent_coefs_ptr;
+  const float* p_ptr                    = job_ptr->positions_ptr;
+  float* t_ptr                          = job_ptr->topology_ptr->face_vectors_ptr;
+  for ( int t = job_ptr->first; t < job_ptr->first + job_ptr->count; t++ ) {
+    const float* a_ptr = &p_ptr[corners_ptr[t * 3] * 3];
+    const float* b_ptr = &p_ptr[corners_ptr[t * 3 + 1] * 3];
+    const float* c_ptr = &p_ptr[corners_ptr[t * 3 + 2] * 3];
+    float k1 = coefs_ptr[t * 2], k2 = coefs_ptr[t * 2 + 1];
+    for ( int i = 0; i < 3; i++ ) { t_ptr[t * 3 + i] = k1 * ( b_ptr[i] - a_ptr[i] ) + k2 * ( c_ptr[i] - a_ptr[i] ); }
+  }
+}
+
+/** Normalises an array of xyz vectors in place. Zero-length vectors, such as those of vertices used by no triangle, stay zero. */
+static void _normalize_vec3s( float* v_ptr, int n_vecs ) {
+  int i = 0;
+#if defined( VOL_GEOM_SSE2 )
+  const __m128 one = _mm_set1_ps( 1.0f );
+  for ( ; i + 4 <= n_vecs; i += 4 ) {
+    float* p_ptr = &v_ptr[i * 3];
+    // 4 vectors are x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3. Gather the squares of each component into the lane of its vector, and sum them.
+    __m128 a0 = _mm_loadu_ps( p_ptr ), a1 = _mm_loadu_ps( p_ptr + 4 ), a2 = _mm_loadu_ps( p_ptr + 8 );
+    __m128 s0 = _mm_mul_ps( a0, a0 ), s1 = _mm_mul_ps( a1, a1 ), s2 = _mm_mul_ps( a2, a2 );
+    __m128 xx = _mm_shuffle_ps( _mm_shuffle_ps( s0, s0, _MM_SHUFFLE( 3, 3, 0, 0 ) ), _mm_shuffle_ps( s1, s2, _MM_SHUFFLE( 1, 1, 2, 2 ) ),
+      _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 yy = _mm_shuffle_ps( _mm_shuffle_ps( s0, s1, _MM_SHUFFLE( 0, 0, 1, 1 ) ), _mm_shuffle_ps( s1, s2, _MM_SHUFFLE( 2, 2, 3, 3 ) ),
+      _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 zz = _mm_shuffle_ps( _mm_shuffle_ps( s0, s1, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _mm_shuffle_ps( s2, s2, _MM_SHUFFLE( 3, 3, 0, 0 ) ),
+      _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 len_sq = _mm_add_ps( _mm_add_ps( xx, yy ), zz );
+    __m128 inv    = _mm_and_ps( _mm_cmpgt_ps( len_sq, _mm_setzero_ps() ), _mm_div_ps( one, _mm_sqrt_ps( len_sq ) ) );
+    // Spread each vector's scale back over its 3 components.
+    _mm_storeu_ps( p_ptr, _mm_mul_ps( a0, _mm_shuffle_ps( inv, inv, _MM_SHUFFLE( 1, 0, 0, 0 ) ) ) );
+    _mm_storeu_ps( p_ptr + 4, _mm_mul_ps( a1, _mm_shuffle_ps( inv, inv, _MM_SHUFFLE( 2, 2, 1, 1 ) ) ) );
+    _mm_storeu_ps( p_ptr + 8, _mm_mul_ps( a2, _mm_shuffle_ps( inv, inv, _MM_SHUFFLE( 3, 3, 3, 2 ) ) ) );
+  }
+#elif defined( VOL_GEOM_NEON )
+  for ( ; i + 4 <= n_vecs; i += 4 ) {
+    // vld3q splits 4 vectors into x, y, and z registers.
+    float32x4x3_t v    = vld3q_f32( &v_ptr[i * 3] );
+    float32x4_t len_sq = vmlaq_f32( vmlaq_f32( vmulq_f32( v.val[0], v.val[0] ), v.val[1], v.val[1] ), v.val[2], v.val[2] );
+    // The reciprocal square root estimate, refined by two Newton-Raphson steps to close to float precision.
+    float32x4_t inv = vrsqrteq_f32( len_sq );
+    inv             = vmulq_f32( inv, vrsqrtsq_f32( vmulq_f32( len_sq, inv ), inv ) );
+    inv             = vmulq_f32( inv, vrsqrtsq_f32( vmulq_f32( len_sq, inv ), inv ) );
+    inv             = vreinterpretq_f32_u32( vandq_u32( vcgtq_f32( len_sq, vdupq_n_f32( 0.0f ) ), vreinterpretq_u32_f32( inv ) ) );
+    v.val[0]        = vmulq_f32( v.val[0], inv );
+    v.val[1]        = vmulq_f32( v.val[1], inv );
+    v.val[2]        = vmulq_f32( v.val[2], inv );
+    vst3q_f32( &v_ptr[i * 3], v );
+  }
+#endif
+  for ( ; i < n_vecs; i++ ) {
+    float* p_ptr = &v_ptr[i * 3];
+    float len_sq = p_ptr[0] * p_ptr[0] + p_ptr[1] * p_ptr[1] + p_ptr[2] * p_ptr[2];
+    if ( len_sq <= 0.0f ) { continue; }
+    float inv = 1.0f / sqrtf( len_sq );
+    p_ptr[0] *= inv;
+    p_ptr[1] *= inv;
+    p_ptr[2] *= inv;
+  }
+}
+
+/** Sums the face vectors of the triangles around a vertex.
+ * Each vertex gathers from its own triangle list, so workers never write to the same vertex and need no atomics or per-worker accumulators. */
+static void _sum_face_vectors( const vol_geom_normals_topology_t* topology_ptr, int v, float* sum_ptr ) {
+  sum_ptr[0] = sum_ptr[1] = sum_ptr[2] = 0.0f;
+  for ( uint32_t i = topology_ptr->first_ptr[v]; i < topology_ptr->first_ptr[v + 1]; i++ ) {
+    const float* f_ptr = &topology_ptr->face_vectors_ptr[topology_ptr->triangle_ids_ptr[i] * 3];
+    sum_ptr[0] += f_ptr[0];
+    sum_ptr[1] += f_ptr[1];
+    sum_ptr[2] += f_ptr[2];
+  }
+}
+
+/** Sums the face normals around each vertex in a range, then normalises them. */
+static void _vertex_normals_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_geom_normals_job_t* job_ptr = &( (vol_geom_normals_job_t*)job_ctx_ptr )[job_idx];
+  for ( int v = job_ptr->first; v < job_ptr->first + job_ptr->count; v++ ) { _sum_face_vectors( job_ptr->topology_ptr, v, &job_ptr->dst_ptr[v * 3] ); }
+  _normalize_vec3s( &job_ptr->dst_ptr[job_ptr->first * 3], job_ptr->count );
+}
+
+/** Sums the face tangents around each vertex in a range, makes them perpendicular to the vertex normals, then normalises them. */
+static void _vertex_tangents_job( void* job_ctx_ptr, int job_idx ) {
+  const vol_geom_normals_job_t* job_ptr = &( (vol_geom_normals_job_t*)job_ctx_ptr )[job_idx];
+  for ( int v = job_ptr->first; v < job_ptr->first + job_ptr->count; v++ ) {
+    const float* n_ptr = &job_ptr->normals_ptr[v * 3];
+    float* t_ptr       = &job_ptr->dst_ptr[v * 3];
+    _sum_face_vectors( job_ptr->topology_ptr, v, t_ptr );
+    float len_sq = t_ptr[0] * t_ptr[0] + t_ptr[1] * t_ptr[1] + t_ptr[2] * t_ptr[2];
+    float n_dot  = n_ptr[0] * t_ptr[0] + n_ptr[1] * t_ptr[1] + n_ptr[2] * t_ptr[2];
+    for ( int i = 0; i < 3; i++ ) { t_ptr[i] -= n_ptr[i] * n_dot; }
+    // No UV gradient, or one along the normal: any tangent perpendicular to the normal will do.
+    if ( !( t_ptr[0] * t_ptr[0] + t_ptr[1] * t_ptr[1] + t_ptr[2] * t_ptr[2] > len_sq * 1e-6f ) ) {
+      bool use_x = fabsf( n_ptr[0] ) < 0.9f; // Cross with the x axis, unless the normal is close to it, then the y axis.
+      t_ptr[0]   = use_x ? 0.0f : -n_ptr[2];
+      t_ptr[1]   = use_x ? n_ptr[2] : 0.0f;
+      t_ptr[2]   = use_x ? -n_ptr[1] : n_ptr[0];
+      if ( 0.0f == t_ptr[0] && 0.0f == t_ptr[1] && 0.0f == t_ptr[2] ) { t_ptr[0] = 1.0f; }
+    }
+  }
+  _normalize_vec3s( &job_ptr->dst_ptr[job_ptr->first * 3], job_ptr->count );
+}
+
+/** Splits `n` triangles or vertices into job ranges. The last job takes any remainder past VOL_GEOM_MAX_RECONSTRUCT_JOBS.
+ * @returns The number of jobs written to `jobs`. */
+static int _normals_jobs(
+  vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, const float* normals_ptr, float* dst_ptr, int n, vol_geom_normals_job_t* jobs ) {
+  int n_jobs = 0;
+  for ( int first = 0; first < n; first += VOL_GEOM_NORMALS_JOB_ELEMENTS ) {
+    if ( n_jobs >= VOL_GEOM_MAX_RECONSTRUCT_JOBS ) {
+      jobs[n_jobs - 1].count += n - first;
+      break;
+    }
+    int count      = n - first < VOL_GEOM_NORMALS_JOB_ELEMENTS ? n - first : VOL_GEOM_NORMALS_JOB_ELEMENTS;
+    jobs[n_jobs++] = ( vol_geom_normals_job_t ){
+      .topology_ptr = topology_ptr, .positions_ptr = positions_ptr, .normals_ptr = normals_ptr, .dst_ptr = dst_ptr, .first = first, .count = count };
+  }
+  return n_jobs;
+}
+
+/** Runs a face pass over all triangles, then a vertex pass over all vertices. Small meshes run on the calling thread, as the jobs would cost more to
+ * schedule than to run. */
+static void _run_normals_jobs( vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, const float* normals_ptr, float* dst_ptr,
+  void ( *face_job_fn )( void* job_ctx_ptr, int job_idx ), void ( *vertex_job_fn )( void* job_ctx_ptr, int job_idx ) ) {
+  vol_geom_normals_job_t jobs[VOL_GEOM_MAX_RECONSTRUCT_JOBS];
+  int n_jobs = _normals_jobs( topology_ptr, positions_ptr, normals_ptr, dst_ptr, topology_ptr->n_triangles, jobs );
+  if ( n_jobs > 1 ) {
+    _parallel_for_ptr( n_jobs, face_job_fn, jobs );
+  } else {
+    face_job_fn( jobs, 0 );
+  }
+  n_jobs = _normals_jobs( topology_ptr, positions_ptr, normals_ptr, dst_ptr, topology_ptr->n_vertices, jobs );
+  if ( n_jobs > 1 ) {
+    _parallel_for_ptr( n_jobs, vertex_job_fn, jobs );
+  } else {
+    vertex_job_fn( jobs, 0 );
+  }
+}
+
+bool vol_geom_compute_normals( vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, int n_vertices, float* normals_ptr ) {
+  assert( topology_ptr && positions_ptr && normals_ptr );
+  if ( !topology_ptr || !positions_ptr || !normals_ptr ) { return false; }
+  if ( n_vertices != topology_ptr->n_vertices ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame has %i vertices, but its keyframe's topology has %i\n", n_vertices, topology_ptr->n_vertices );
+    return false;
+  }
+  _run_normals_jobs( topology_ptr, positions_ptr, NULL, normals_ptr, _face_normals_job, _vertex_normals_job );
+  return true;
+}
+
+bool vol_geom_compute_tangents(
+  vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, const float* normals_ptr, int n_vertices, float* tangents_ptr ) {
+  assert( topology_ptr && positions_ptr && normals_ptr && tangents_ptr );
+  if ( !topology_ptr || !positions_ptr || !normals_ptr || !tangents_ptr ) { return false; }
+  if ( !topology_ptr->tangent_coefs_ptr ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: tangents need the keyframe's UVs set with vol_geom_set_normals_topology_uvs()\n" );
+    return false;
+  }
+  if ( n_vertices != topology_ptr->n_vertices ) {
+    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame has %i vertices, but its keyframe's topology has %i\n", n_vertices, topology_ptr->n_vertices );
+    return false;
+  }
+  _run_normals_jobs( topology_ptr, positions_ptr, normals_ptr, tangents_ptr, _face_tangents_job, _vertex_tangents_job );
+  return true;
+}
+
 void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t log_type, const char* message_str ) ) { _logger_ptr = user_function_ptr; }
 
 void vol_geom_reset_log_callback( void ) { _logger_ptr = _default_logger; }
+
+void vol_geom_set_parallel_for_callback( vol_geom_parallel_for_fn_t user_function_ptr ) { _parallel_for_ptr = user_function_ptr ? user_function_ptr : _default_parallel_for; }
+
+void vol_geom_reset_parallel_for_callback( void ) { _parallel_for_ptr = _default_parallel_for; }
@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.10
+ * Version   | 0.22.3
  * Authors   | Anton Gerdelan     <anton@volograms.com>
  *           | Patrick Geoghegan  <patrick@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
@@ -21,6 +21,26 @@
  *
  * History
  * -------
+ * - 0.22.3 (2026/10/19) - vol_geom_io_http() reads are safe to call from several threads, e.g. to read a bundle's video and geometry over HTTP.
+ * - 0.22.2 (2026/10/19) - VOL_GEOM_STREAM_CODEC_UNORM16 quantizes to the nearest step and documents the float rounding of decoding in its error bound.
+ * - 0.22.1 (2026/10/19) - The frame headers of a sequence are scanned in large reads, so opening a URL takes a few requests instead of one per frame,
+ *                        and a sequence played with streaming mode off is read once, not scanned then read again. HTTP replies may be chunked.
+ * - 0.22.0 (2026/10/19) - vol_geom_memory_used() and vol_geom_bundle_memory_used() to account for memory, and vol_geom_bundle_release_decoded() to
+ *                        free decoded chunks until they are next read.
+ * - 0.21.0 (2026/10/19) - vol_geom_convert_indices(): 16 or 32-bit indices to 32-bit, with optional winding flip and range check, in one SIMD pass.
+ * - 0.20.0 (2026/10/19) - Per-frame and sequence bounding boxes, from an optional bundle chunk, and vol_geom_compute_aabb() to make them.
+ * - 0.19.0 (2026/10/19) - Vertex tangents from UVs, with the per-keyframe part of the work done once in the normals topology.
+ * - 0.18.0 (2026/10/19) - Area-weighted vertex normals for sequences stored without normals, using a topology built once per keyframe.
+ * - 0.17.1 (2026/10/19) - Patched frame parsing to check that a frame's embedded texture fits in the frame.
+ * - 0.17.0 (2026/10/19) - Vologram bundles: header, sequence, and video in one file of 4 KiB-aligned chunks, read through one file handle.
+ * - 0.16.0 (2026/10/19) - Pluggable file I/O with vol_geom_io_t and vol_geom_create_file_info_io(): stdio, pread, memory, and http backends.
+ *                        In streaming mode the sequence file stays open between frames. vol_geom_prefetch_frame() for asynchronous backends.
+ * - 0.15.0 (2026/10/19) - Header and sequence files can be http:// URLs, read with HTTP range requests. Frames are fetched as they are played.
+ * - 0.14.0 (2026/10/19) - vol_geom_frames_share_topology() and vol_geom_lerp_floats() for interpolating between tracked frames at display rate.
+ * - 0.13.0 (2026/10/19) - Quantized attribute codecs: 16-bit positions over the sequence bounds, octahedral normals, half-float UVs.
+ *                        Packed 16-byte vertex layout for renderers.
+ * - 0.12.0 (2026/10/19) - Tracked-frame positions can be stored as quantized differences from the previous frame.
+ * - 0.11.0 (2026/10/19) - Optional compressed sequence encoding (per-stream codecs), decoded in parallel through a user-supplied parallel-for callback.
  * - 0.10.0 (2022/03/22) - Support added for reading >2GB volograms.
  * - 0.9.0  (2022/03/22) - Version bump for parity with vol_av.
  * - 0.7.1  (2021/01/24) - New option streaming_mode paramter to vol_geom_create_file_info().
@@ -63,6 +83,72 @@ VOL_GEOM_EXPORT typedef struct vol_geom_short_str_t {
   uint8_t sz;
 } vol_geom_short_str_t;
 
+/** Values of vol_geom_file_hdr_t.compression.
+ * Values other than these are treated as uncompressed, as earlier versions of this library did.
+ */
+typedef enum vol_geom_compression_t {
+  /// Every array in the sequence file is stored as raw bytes.
+  VOL_GEOM_COMPRESSION_NONE = 0,
+  /// Every array in the sequence file is stored as a stream: an 8-byte vol_geom_stream_hdr_t followed by codec-specific data.
+  /// Frame sizes in the sequence file refer to the stored (encoded) sizes. Produced by the vol_geom_pack tool.
+  VOL_GEOM_COMPRESSION_STREAMS = 16
+} vol_geom_compression_t;
+
+/** Codec used by a single stream in a VOL_GEOM_COMPRESSION_STREAMS sequence. */
+typedef enum vol_geom_stream_codec_t {
+  /// Raw bytes, as in an uncompressed sequence.
+  VOL_GEOM_STREAM_CODEC_RAW = 0,
+  /// Words split into byte planes, each plane delta-coded against the same component of the previous vertex, then zero-run-length coded.
+  /// Lossless. Planes decode independently so they are spread over worker threads.
+  VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE,
+  /// 16 or 32-bit indices stored as zigzag-encoded differences from the previous index, as LEB128 varints. Lossless.
+  VOL_GEOM_STREAM_CODEC_INDEX_DELTA,
+  /// Tracked-frame vertices or normals stored as 16-bit multiples of a quantization step, added to the same array of the previous frame once decoded.
+  /// Data is a float step, then the int16 array coded as in VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE.
+  /// Lossy: each component is within step/2 of the original, and errors do not accumulate along a keyframe group because the encoder
+  /// predicts from its own reconstruction. Reading a frame out of order first decodes the frames before it, back to its keyframe.
+  VOL_GEOM_STREAM_CODEC_DELTA_Q16,
+  /// Floats stored as 16-bit UNORM over a range per channel, usually the bounds of the whole sequence so every frame shares one quantization grid.
+  /// Data is the minimum of each channel, then the maximum of each channel, as floats, then the uint16 array coded as in VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE.
+  /// Lossy: each component within the range is within ( max - min ) / 131070 of the original, half a step, plus float rounding of at most
+  /// max( |min|, |max| ) / 2^21 when decoding, e.g. 0.03 mm over a 4 m capture volume.
+  VOL_GEOM_STREAM_CODEC_UNORM16,
+  /// Normals stored as two 16-bit SNORM octahedral coordinates, coded as in VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE. Decoded normals are unit length.
+  /// Lossy: directions are within about 0.005 degrees of the original.
+  VOL_GEOM_STREAM_CODEC_OCT16,
+  /// Floats stored as IEEE 754 half floats, coded as in VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE. Intended for UVs.
+  /// Lossy: 11 significant bits, so UVs in 0 to 1 are within 1/4096 of the original, or 1/8 of a texel of a 2048 texture.
+  VOL_GEOM_STREAM_CODEC_HALF,
+  VOL_GEOM_STREAM_CODEC_MAX // Not a codec, just used to count the codecs.
+} vol_geom_stream_codec_t;
+
+/** Header at the start of every stream in a VOL_GEOM_COMPRESSION_STREAMS sequence, after the stream's int32 stored size. 8 bytes, little-endian. */
+VOL_GEOM_EXPORT typedef struct vol_geom_stream_hdr_t {
+  /// Size, in bytes, of the array once decoded.
+  uint32_t raw_sz;
+  /// A vol_geom_stream_codec_t value.
+  uint8_t codec;
+  /// Size of one word (float or index) in bytes: 1, 2 or 4.
+  uint8_t word_sz;
+  /// Words per vertex, e.g. 3 for positions, 2 for UVs. Codecs that predict from the previous vertex use this as their stride.
+  uint8_t channels;
+  uint8_t reserved;
+} vol_geom_stream_hdr_t;
+
+/** A quantized vertex for renderers that can read normalised vertex formats directly, at 16 bytes instead of the 32 bytes of float attributes.
+ * Matching vertex formats are R16G16B16A16_UNORM, R16G16_SNORM, and R16G16_FLOAT.
+ * Fill an array of these with `vol_geom_pack_vertices()`.
+ */
+VOL_GEOM_EXPORT typedef struct vol_geom_packed_vertex_t {
+  /// Position normalised to the bounds given to vol_geom_pack_vertices(): bounds_min + position / 65535 * ( bounds_max - bounds_min ). w is 0.
+  uint16_t position[4];
+  /// Octahedral-encoded normal. Decode with u = normal[0] / 32767, v = normal[1] / 32767, n = ( u, v, 1 - |u| - |v| ),
+  /// and if n.z < 0 then n.xy = ( 1 - |n.yx| ) * sign( n.xy ). Then normalise n.
+  int16_t normal[2];
+  /// Texture coordinates as half floats.
+  uint16_t uv[2];
+} vol_geom_packed_vertex_t;
+
 /** V12 header
  * @note If the ints etc were all in the top and the var mem like strings at the end that would hugely simplify the parsing with a struct ptr cast
  */
@@ -71,6 +157,7 @@ VOL_GEOM_EXPORT typedef struct vol_geom_file_hdr_t {
   vol_geom_short_str_t format;
   /// 10,11,12.
   int32_t version;
+  /// A vol_geom_compression_t value.
   int32_t compression;
   vol_geom_short_str_t mesh_name;
   vol_geom_short_str_t material;
@@ -116,8 +203,101 @@ VOL_GEOM_EXPORT typedef struct vol_geom_frame_directory_entry_t {
   vol_geom_size_t hdr_sz;
   /// mesh_data_sz + everything not accounted for by mesh_data_sz in older versions of spec.
   vol_geom_size_t corrected_payload_sz;
+  /// Size of the mesh data once all its streams are decoded. Equal to corrected_payload_sz unless the sequence is compressed.
+  vol_geom_size_t decoded_payload_sz;
 } vol_geom_frame_directory_entry_t;
 
+/** Forward-declaration of internal state kept between frame reads of a sequence that uses VOL_GEOM_STREAM_CODEC_DELTA_Q16. */
+VOL_GEOM_EXPORT typedef struct vol_geom_decoder_state_t vol_geom_decoder_state_t;
+
+/** Forward-declaration of an internal file or URL reader. */
+VOL_GEOM_EXPORT typedef struct vol_geom_reader_t vol_geom_reader_t;
+
+/** File I/O callbacks, so that volograms can be read from e.g. engine archives, async file handles, or memory.
+ * Every callback is given the backend's `user_ptr`. Offsets and sizes are in bytes.
+ */
+VOL_GEOM_EXPORT typedef struct vol_geom_io_t {
+  /// Opens a file for reading. Returns a handle that is passed to the other callbacks, or NULL on error.
+  void* ( *open_fn )( const char* path, void* user_ptr );
+  /// Returns the size of an open file, or -1 on error.
+  vol_geom_size_t ( *size_fn )( void* file_ptr, void* user_ptr );
+  /// Reads exactly `sz` bytes starting at `offset` into `dst_ptr`. Returns false on any error.
+  bool ( *read_at_fn )( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr );
+  /// Optional. Starts reading exactly `sz` bytes starting at `offset` into `dst_ptr`, and returns without waiting.
+  /// Returns a request handle for `async_wait_fn`, or NULL if the read couldn't be started. Used by `vol_geom_prefetch_frame()`.
+  void* ( *async_read_at_fn )( void* file_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr, void* user_ptr );
+  /// Required if `async_read_at_fn` is set. Waits for a request to finish and frees it. Returns false if the read failed.
+  bool ( *async_wait_fn )( void* request_ptr, void* user_ptr );
+  /// Closes a file opened by `open_fn`. Any asynchronous requests on it have already been waited for.
+  void ( *close_fn )( void* file_ptr, void* user_ptr );
+  /// Passed to every callback.
+  void* user_ptr;
+  /// Optional. Bytes read at a time while scanning the frame headers of a sequence in streaming mode, or 0 for 16 kB. Backends where each request is slow,
+  /// such as HTTP, set this larger so that one request covers the headers of many frames, at the cost of also reading their data.
+  vol_geom_size_t scan_read_sz;
+} vol_geom_io_t;
+
+/** A file held in memory, for `vol_geom_io_memory()`. */
+VOL_GEOM_EXPORT typedef struct vol_geom_memory_file_t {
+  /// Name the file is opened by. NULL marks the end of an array of files.
+  const char* path;
+  /// File contents. Must stay valid until the vologram is freed.
+  const void* data_ptr;
+  vol_geom_size_t sz;
+} vol_geom_memory_file_t;
+
+/** First 4 bytes of a vologram bundle: a single file holding a vologram's header, sequence, and video as chunks. */
+#define VOL_GEOM_BUNDLE_MAGIC "VOLB"
+#define VOL_GEOM_BUNDLE_VERSION 1
+/** Every chunk starts on a multiple of this many bytes, so a chunk can be read with page-aligned or unbuffered I/O, or mapped on its own. */
+#define VOL_GEOM_BUNDLE_ALIGNMENT 4096
+/** Chunk IDs. A bundle has a header and a sequence chunk, and may have a video chunk and a bounds chunk. */
+#define VOL_GEOM_BUNDLE_CHUNK_HEADER "VHDR"
+#define VOL_GEOM_BUNDLE_CHUNK_SEQUENCE "VSEQ"
+#define VOL_GEOM_BUNDLE_CHUNK_VIDEO "VVID"
+/** 6 floats for the bounds of the whole sequence, then 6 for each frame, each as minimum x, y, z then maximum x, y, z, in the axes of the .vols file. */
+#define VOL_GEOM_BUNDLE_CHUNK_BOUNDS "VBND"
+
+/** How a bundle chunk is stored. */
+typedef enum vol_geom_bundle_codec_t {
+  /// Stored as-is, and read from the bundle as it is used, so a stored sequence chunk can be played in streaming mode.
+  VOL_GEOM_BUNDLE_CODEC_STORED = 0,
+  /// One stream written by `vol_geom_encode_stream()` with VOL_GEOM_STREAM_CODEC_RAW, _SHUFFLE_RLE or _INDEX_DELTA.
+  /// The whole chunk is decoded into memory when the bundle is opened, so this suits the header, or a sequence played with streaming mode off.
+  VOL_GEOM_BUNDLE_CODEC_STREAM,
+  VOL_GEOM_BUNDLE_CODEC_MAX // Not a codec, just used to count the codecs.
+} vol_geom_bundle_codec_t;
+
+/** Header at the start of a bundle, followed by its chunk table of `chunk_count` vol_geom_bundle_chunk_t entries. 16 bytes, little-endian. */
+VOL_GEOM_EXPORT typedef struct vol_geom_bundle_hdr_t {
+  /// VOL_GEOM_BUNDLE_MAGIC. Not nul-terminated.
+  char magic[4];
+  /// VOL_GEOM_BUNDLE_VERSION.
+  uint32_t version;
+  uint32_t chunk_count;
+  uint32_t reserved;
+} vol_geom_bundle_hdr_t;
+
+/** An entry in a bundle's chunk table. 32 bytes, little-endian. */
+VOL_GEOM_EXPORT typedef struct vol_geom_bundle_chunk_t {
+  /// Chunk ID, e.g. VOL_GEOM_BUNDLE_CHUNK_SEQUENCE. Not nul-terminated.
+  char id[4];
+  /// A vol_geom_bundle_codec_t value.
+  uint32_t codec;
+  /// Start of the chunk's stored bytes from the start of the bundle. A multiple of VOL_GEOM_BUNDLE_ALIGNMENT.
+  uint64_t offset;
+  /// Size of the chunk's stored bytes.
+  uint64_t stored_sz;
+  /// Size of the chunk once decoded. Equal to stored_sz for VOL_GEOM_BUNDLE_CODEC_STORED.
+  uint64_t raw_sz;
+} vol_geom_bundle_chunk_t;
+
+/** Forward-declaration of an open bundle. */
+VOL_GEOM_EXPORT typedef struct vol_geom_bundle_t vol_geom_bundle_t;
+
+/** Forward-declaration of a mesh's triangle adjacency, for generating normals. */
+VOL_GEOM_EXPORT typedef struct vol_geom_normals_topology_t vol_geom_normals_topology_t;
+
 /** Meta-data about the whole Vologram sequence. Load this once with `vol_geom_create_file_info()` before using the Vologram. */
 VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
   vol_geom_file_hdr_t hdr;
@@ -136,13 +316,34 @@ VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
 
   /// If streaming_mode was not set then sequence file is read to a blob pointed to by this pointer. Otherwise it is NULL and file I/O occurs on every frame read.
   uint8_t* sequence_blob_byte_ptr;
+  /// Size of the buffer pointed to by sequence_blob_byte_ptr, or 0 if it is NULL.
+  vol_geom_size_t sequence_blob_sz;
+
+  /// Only used by compressed sequences: a pre-allocated block that frames are decoded into. NULL otherwise. Do not manually allocate or free this memory!
+  uint8_t* decoded_frame_blob_ptr;
+  /// This is the maximum size of the buffer pointed to by decoded_frame_blob_ptr.
+  vol_geom_size_t biggest_decoded_frame_blob_sz;
+
+  /// Only used by sequences with temporally predicted streams: the previously decoded frame that the next tracked frame is predicted from. NULL otherwise.
+  /// Should not need to be accessed by the application.
+  vol_geom_decoder_state_t* _decoder_state_ptr;
+
+  /// Only used in streaming mode: the sequence file, kept open for reading frames. NULL otherwise. Should not need to be accessed by the application.
+  vol_geom_reader_t* _reader_ptr;
+
+  /// Bounds of each frame's vertices, 6 floats per frame: minimum x, y, z then maximum x, y, z. Known before any frame is read, so they can be used
+  /// for culling. NULL unless the vologram was read from a bundle with a VOL_GEOM_BUNDLE_CHUNK_BOUNDS chunk. Do not manually allocate or free this memory!
+  float* frame_aabbs_ptr;
+  /// Bounds of every frame in the sequence, as above. Only set if frame_aabbs_ptr is not NULL.
+  float sequence_aabb[6];
 
 } vol_geom_info_t;
 
 /** Meta-data for each from of the Vologram sequence. */
 VOL_GEOM_EXPORT typedef struct vol_geom_frame_data_t {
   /// Points into the data offset of vol_geom_info_t->preallocated_frame_blob_ptr.
-  /// After calling vol_geom_read_frame() this pointer points into that frame's data section inside vol_geom_info_t->preallocated_frame_blob_ptr.
+  /// After calling vol_geom_read_frame() this pointer points into that frame's data section inside vol_geom_info_t->preallocated_frame_blob_ptr,
+  /// or into vol_geom_info_t->decoded_frame_blob_ptr for compressed sequences.
   /// Do not manually allocate or free this memory!
   uint8_t* block_data_ptr;
 
@@ -186,6 +387,17 @@ typedef enum vol_geom_log_type_t {
 VOL_GEOM_EXPORT void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t log_type, const char* message_str ) );
 VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
 
+/** A function that calls `job_fn( job_ctx_ptr, job_idx )` once for every job_idx from 0 to job_count-1, in any order and on any threads,
+ * and only returns once every job has completed. Jobs never write to the same memory, so they need no locking.
+ */
+typedef void ( *vol_geom_parallel_for_fn_t )( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr );
+
+/** Set the function used to spread work, such as decoding the streams of a compressed frame, over worker threads.
+ * Engines should point this at their own job system. The default runs each job in turn on the calling thread.
+ */
+VOL_GEOM_EXPORT void vol_geom_set_parallel_for_callback( vol_geom_parallel_for_fn_t user_function_ptr );
+VOL_GEOM_EXPORT void vol_geom_reset_parallel_for_callback( void );
+
 /** Call this function before playing a vologram sequence.
  * It will build a directory of file and frame information about the VOL sequence, and pre-allocate memory.
  * You only need to call this function once per Vologram - you can keep the vol_geom_info_t struct in memory and re-use it during playback.
@@ -193,8 +405,11 @@ VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
  * This is also true when changing volograms - call `vol_geom_free_file_info()` first before opening a new vologram.
  * @param hdr_filename   Pointer to a char array containing the file path to the Vologram header file. Must not be NULL.
  * @param seq_filename   Pointer to a char array containing the file path to the Vologram sequence file. Must not be NULL.
+ *                       Either path may be a http:// URL on a server that supports range requests. https:// is not supported.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application that will be populated by this function. Must not be NULL.
- * @param streaming_mode If set then sequence file is not pre-loaded to memory.
+ * @param streaming_mode If set then sequence file is not pre-loaded to memory, and is kept open until `vol_geom_free_file_info()`.
+ *                       For a URL, the frame headers are read now, in a few large requests over a kept-alive connection, and each frame's data is fetched
+ *                       when it is read, so playback can start without downloading the whole file.
  *                       This allows support of very large or streamed files, but may introduce file I/O performance issues.
  * @returns              Returns false on any error such as not finding the files specified, or failing to read from a file.
  * On failure, any allocated memory will be cleaned up by this function first,
@@ -202,6 +417,78 @@ VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
  */
 VOL_GEOM_EXPORT bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode );
 
+/** As `vol_geom_create_file_info()`, but reads both files through an I/O backend.
+ * @param io_ptr         Backend to read the files with. The struct is copied. If NULL, http:// URLs are read with `vol_geom_io_http()` and other paths with
+ *                       `vol_geom_io_stdio()`, as `vol_geom_create_file_info()` does.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_io(
+  const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode, const vol_geom_io_t* io_ptr );
+
+/** Backend that reads files with fopen() and fread(). */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_io_stdio( void );
+
+/** Backend that reads files with positional reads: pread() on POSIX, or ReadFile() with an offset on Windows. Doesn't share a file position between reads. */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_io_pread( void );
+
+/** Backend that reads http:// URLs with HTTP/1.1 range requests over a kept-alive connection. The server must support range requests.
+ * Replies may give their length with Content-Length or be sent with `Transfer-Encoding: chunked`. Other transfer codings, e.g. gzip, are not supported.
+ * Reads are safe to call from several threads. They take turns on the one connection.
+ */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_io_http( void );
+
+/** Backend that reads files already in memory, e.g. downloaded or unpacked by the application.
+ * @param files_ptr      Array of files, ended by an entry with a NULL path. Opening a path not in the array fails. The array must stay valid as long as
+ *                       the backend is used, including until `vol_geom_free_file_info()` in streaming mode.
+ */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_io_memory( const vol_geom_memory_file_t* files_ptr );
+
+/** Opens a vologram bundle and reads its chunk table. Compressed chunks are decoded into memory now; stored chunks are read from the bundle as they
+ * are used, through the one file handle opened here.
+ * @param path           Path or http:// URL of the bundle, as given to the backend.
+ * @param io_ptr         Backend to read the bundle with. The struct is copied. If NULL, http:// URLs are read with `vol_geom_io_http()` and other paths
+ *                       with `vol_geom_io_stdio()`. Give a backend whose reads are safe to call from several threads, e.g. `vol_geom_io_pread()`
+ *                       or `vol_geom_io_http()`, if the video chunk is read on a different thread to the geometry.
+ * @returns              A bundle to close with `vol_geom_bundle_close()`, or NULL on any error such as a missing file or a corrupt chunk table.
+ */
+VOL_GEOM_EXPORT vol_geom_bundle_t* vol_geom_bundle_open( const char* path, const vol_geom_io_t* io_ptr );
+
+/** Closes a bundle and frees its memory. Call after `vol_geom_free_file_info()` for any vologram read from the bundle, and after closing the video. */
+VOL_GEOM_EXPORT void vol_geom_bundle_close( vol_geom_bundle_t* bundle_ptr );
+
+/** @returns The entry for a chunk, or NULL if the bundle has no chunk with that ID. Valid until the bundle is closed.
+ * A stored chunk's `offset` and `raw_sz` give its place in the bundle, e.g. to hand a memory-mapped bundle's video to `vol_av_open_memory()`.
+ */
+VOL_GEOM_EXPORT const vol_geom_bundle_chunk_t* vol_geom_bundle_find_chunk( const vol_geom_bundle_t* bundle_ptr, const char* id );
+
+/** Reads exactly `sz` bytes from `offset` within a chunk's decoded contents, e.g. from a `vol_av_io_t` callback to play the video chunk.
+ * @returns              False if the range is outside the chunk, or the read fails.
+ */
+VOL_GEOM_EXPORT bool vol_geom_bundle_read_chunk_at(
+  vol_geom_bundle_t* bundle_ptr, const vol_geom_bundle_chunk_t* chunk_ptr, vol_geom_size_t offset, vol_geom_size_t sz, void* dst_ptr );
+
+/** Backend that reads the chunks of an open bundle. Files are opened by chunk ID, e.g. VOL_GEOM_BUNDLE_CHUNK_SEQUENCE. Supports asynchronous reads if
+ * the bundle's own backend does. The bundle must stay open as long as the backend is used, including until `vol_geom_free_file_info()` in streaming mode.
+ */
+VOL_GEOM_EXPORT vol_geom_io_t vol_geom_io_bundle( vol_geom_bundle_t* bundle_ptr );
+
+/** @returns The bytes of memory held by a bundle: its chunk table and the decoded contents of any compressed chunks. */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_bundle_memory_used( const vol_geom_bundle_t* bundle_ptr );
+
+/** Frees the decoded contents of a bundle's compressed chunks, e.g. to stay within a memory budget. Each chunk is read and decoded again, whole, the
+ * next time any of it is read. Must not be called while another thread is reading from the bundle.
+ * @returns              The bytes of memory freed.
+ */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_bundle_release_decoded( vol_geom_bundle_t* bundle_ptr );
+
+/** As `vol_geom_create_file_info()`, but reads the header and sequence chunks of an open bundle. */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_bundle( vol_geom_bundle_t* bundle_ptr, vol_geom_info_t* info_ptr, bool streaming_mode );
+
+/** @returns The bytes of memory allocated for a vologram by `vol_geom_create_file_info()` and the frames read since: the frame directory and
+ * headers, the frame blobs, the sequence blob if not streaming, the streaming reader's buffers and the decoder's state. Excludes any bundle read from,
+ * see `vol_geom_bundle_memory_used()`.
+ */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_memory_used( const vol_geom_info_t* info_ptr );
+
 /** Call this function to free memory allocated by a call to `vol_geom_create_file_info()` and reset struct to defaults.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application that will be populated by this function. Must not be NULL.
  * @returns              False error such as NULL pointers where allocated memory was expected.
@@ -210,6 +497,7 @@ VOL_GEOM_EXPORT bool vol_geom_free_file_info( vol_geom_info_t* info_ptr );
 
 /** Read a single frame from a Vologram sequence file.
  * @param seq_filename   Pointer to a char array containing the file path to the Vologram sequence file. Must not be NULL.
+ *                       Unused: frames are read from the file opened by `vol_geom_create_file_info()`, or from memory if it was pre-loaded.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application as populated by a previous call `vol_geom_create_file_info()`.
  * @param frame_idx      Index of the frame you wish to read. Frames start at index 0.
  * @param frame_data_ptr Pointer to a `vol_geom_frame_data_t` struct in your application that this function will populate with data.
@@ -218,6 +506,14 @@ VOL_GEOM_EXPORT bool vol_geom_free_file_info( vol_geom_info_t* info_ptr );
  */
 VOL_GEOM_EXPORT bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, int frame_idx, vol_geom_frame_data_t* frame_data_ptr );
 
+/** Start reading a frame's data in the background, so that a later `vol_geom_read_frame()` of that frame doesn't wait for I/O.
+ * Only has an effect in streaming mode with a backend that has `async_read_at_fn`. Only one frame is read ahead at a time.
+ * @param info_ptr       Pointer to vologram meta-data loaded by a call to vol_geom_create_file_info().
+ * @param frame_idx      Index of the frame that will be read next.
+ * @returns              False if the read couldn't be started, or `frame_idx` is out of range.
+ */
+VOL_GEOM_EXPORT bool vol_geom_prefetch_frame( const vol_geom_info_t* info_ptr, int frame_idx );
+
 /** This function can be used to determine if a frame can be skipped or has essential keyframe data.
  * @param info_ptr       Collected VOL sequence information created by `vol_geom_create_file_info()`. Must not be NULL.
  * @param frame_idx      Index number of the frame to query within the sequence, starting at 0.
@@ -233,6 +529,154 @@ VOL_GEOM_EXPORT bool vol_geom_is_keyframe( const vol_geom_info_t* info_ptr, int
  */
 VOL_GEOM_EXPORT int vol_geom_find_previous_keyframe( const vol_geom_info_t* info_ptr, int frame_idx );
 
+/** Check if two frames can be blended vertex-for-vertex, because no keyframe with new topology lies between them.
+ * @param info_ptr       Pointer to vologram meta-data loaded by a call to vol_geom_create_file_info().
+ * @param frame_a_idx    Index of one frame.
+ * @param frame_b_idx    Index of the other frame, before or after frame_a_idx.
+ * @returns              True if every frame after the earlier one, up to and including the later one, is a tracked frame (keyframe value 0 or 2).
+ *                       False if either index is out of range.
+ */
+VOL_GEOM_EXPORT bool vol_geom_frames_share_topology( const vol_geom_info_t* info_ptr, int frame_a_idx, int frame_b_idx );
+
+/** Linear interpolation between two float arrays: dst = a + ( b - a ) * t. Uses SSE2 or NEON where available, and the parallel-for callback for large arrays.
+ * Use it to blend the vertices and normals of two frames that share topology, e.g. to play 30 FPS volograms smoothly on 90 Hz displays.
+ * Blended normals are not re-normalised.
+ * @param a_ptr          Floats at t = 0. Must not be NULL.
+ * @param b_ptr          Floats at t = 1. Must not be NULL.
+ * @param t              Blend factor, usually from 0 to 1.
+ * @param dst_ptr        Array of `n_floats` to write. May be the same as `a_ptr` or `b_ptr`. Must not be NULL.
+ * @param n_floats       Number of floats in each array.
+ */
+VOL_GEOM_EXPORT void vol_geom_lerp_floats( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, vol_geom_size_t n_floats );
+
+/** Build the adjacency that `vol_geom_compute_normals()` needs, from a keyframe's indices.
+ * Tracked frames share their keyframe's indices, so build this once per keyframe and reuse it for every frame until the next one.
+ * @param indices_ptr    3 vertex indices per triangle. Widen 16-bit indices first, e.g. with `vol_geom_convert_indices()`. Must not be NULL.
+ * @param n_indices      Number of indices. A multiple of 3.
+ * @param n_vertices     Number of vertices in the keyframe. Every index must be less than this.
+ * @param flip_winding   False for indices as stored in .vols files, where a triangle's corners are clockwise seen from its front.
+ *                       True if the second and third corners of each triangle have been swapped, as engines with anticlockwise front faces do.
+ * @returns              A topology to free with `vol_geom_free_normals_topology()`, or NULL on error such as an index out of range.
+ */
+VOL_GEOM_EXPORT vol_geom_normals_topology_t* vol_geom_create_normals_topology( const uint32_t* indices_ptr, int n_indices, int n_vertices, bool flip_winding );
+
+/** Free memory allocated by `vol_geom_create_normals_topology()`. Does nothing if `topology_ptr` is NULL. */
+VOL_GEOM_EXPORT void vol_geom_free_normals_topology( vol_geom_normals_topology_t* topology_ptr );
+
+/** Set up a topology for `vol_geom_compute_tangents()`, from its keyframe's UVs. Tracked frames share these too, so this is also done once per keyframe.
+ * @param topology_ptr   Topology from `vol_geom_create_normals_topology()`. Must not be NULL.
+ * @param uvs_ptr        2 floats per vertex, in the UV convention the tangents are for, e.g. with V flipped for engines with V down. Must not be NULL.
+ * @param n_vertices     Number of vertices in the keyframe. Must match the topology.
+ * @param handedness_ptr Array of `n_vertices` to write: 1, or -1 where the UVs are mirrored, and the bitangent is the tangent frame's negated.
+ *                       The same for all the keyframe's tracked frames. Must not be NULL.
+ * @returns              False on error such as a vertex count that does not match the topology.
+ */
+VOL_GEOM_EXPORT bool vol_geom_set_normals_topology_uvs(
+  vol_geom_normals_topology_t* topology_ptr, const float* uvs_ptr, int n_vertices, int8_t* handedness_ptr );
+
+/** Compute area-weighted vertex normals for one frame, for sequences stored without normals.
+ * Face normals and then vertex normals are computed in parallel through the parallel-for callback, and normalised with SSE2 or NEON where available.
+ * Vertices used by no triangle get a zero normal.
+ * The topology holds scratch memory for the face normals, so do not use one topology on two threads at once.
+ * @param topology_ptr   Adjacency of the frame's keyframe, from `vol_geom_create_normals_topology()`. Must not be NULL.
+ * @param positions_ptr  3 floats per vertex, in the same axes as the .vols file. Must not be NULL.
+ * @param n_vertices     Number of vertices in the frame. Must match the keyframe the topology was built for.
+ * @param normals_ptr    Array of 3 floats per vertex to write. Must not be NULL.
+ * @returns              False if a pointer is NULL or `n_vertices` does not match the topology.
+ */
+VOL_GEOM_EXPORT bool vol_geom_compute_normals( vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, int n_vertices, float* normals_ptr );
+
+/** Compute vertex tangents for one frame, pointing along +U and perpendicular to the normals, for normal-mapped or anisotropic materials.
+ * Face tangents are weighted by UV area and summed in parallel like `vol_geom_compute_normals()`, which has the same threading restrictions.
+ * The bitangent is cross( normal, tangent ) times the vertex's handedness from `vol_geom_set_normals_topology_uvs()`.
+ * @param topology_ptr   Adjacency of the frame's keyframe, with its UVs set by `vol_geom_set_normals_topology_uvs()`. Must not be NULL.
+ * @param positions_ptr  3 floats per vertex, in the same axes as the .vols file. Must not be NULL.
+ * @param normals_ptr    3 floats per vertex: the frame's unit-length normals, from the file or `vol_geom_compute_normals()`. Must not be NULL.
+ * @param n_vertices     Number of vertices in the frame. Must match the keyframe the topology was built for.
+ * @param tangents_ptr   Array of 3 floats per vertex to write. Must not be NULL.
+ * @returns              False if a pointer is NULL, the topology has no UVs, or `n_vertices` does not match the topology.
+ */
+VOL_GEOM_EXPORT bool vol_geom_compute_tangents(
+  vol_geom_normals_topology_t* topology_ptr, const float* positions_ptr, const float* normals_ptr, int n_vertices, float* tangents_ptr );
+
+/** Convert a keyframe's indices to 32-bit, e.g. for an engine's index buffer, in one pass using SSE2 or NEON where available.
+ * @param src_ptr        Indices as stored in the frame, at `block_data_ptr + indices_offset`. They need not be aligned. Must not be NULL.
+ * @param index_sz       2 for 16-bit indices, which .vols files use for meshes of fewer than 65535 vertices, or 4 for 32-bit indices.
+ * @param n_indices      Number of indices: the frame's `indices_sz` divided by `index_sz`. A multiple of 3.
+ * @param n_vertices     Number of vertices in the frame. Every index must be less than this.
+ * @param flip_winding   Swap the second and third corners of each triangle, for engines whose front faces are anticlockwise.
+ * @param dst_ptr        Array of `n_indices` to write. Must not overlap `src_ptr`. Must not be NULL.
+ * @returns              False if an argument is invalid, or an index is out of range. All indices are still written in the latter case.
+ */
+VOL_GEOM_EXPORT bool vol_geom_convert_indices( const void* src_ptr, int index_sz, int n_indices, int n_vertices, bool flip_winding, uint32_t* dst_ptr );
+
+/** Find the axis-aligned bounding box of an array of positions, e.g. to write a VOL_GEOM_BUNDLE_CHUNK_BOUNDS chunk.
+ * Uses SSE2 or NEON where available, and the parallel-for callback for large arrays.
+ * @param positions_ptr  3 floats per vertex. Must not be NULL.
+ * @param n_vertices     Number of vertices. If 0, the bounds are all 0.
+ * @param aabb_ptr       6 floats to write: minimum x, y, z then maximum x, y, z. Must not be NULL.
+ * @returns              False if a pointer is NULL.
+ */
+VOL_GEOM_EXPORT bool vol_geom_compute_aabb( const float* positions_ptr, int n_vertices, float* aabb_ptr );
+
+/** Upper bound on the bytes `vol_geom_encode_stream()` writes for an array of `src_sz` bytes. Use this to size the destination buffer. */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_encode_stream_bound( vol_geom_size_t src_sz, int word_sz );
+
+/** Encode one array of a frame as a stream for a VOL_GEOM_COMPRESSION_STREAMS sequence. Used by tools, not at run-time.
+ * @param codec          A vol_geom_stream_codec_t value.
+ * @param word_sz        Size of one word in bytes. 4 for floats or 32-bit indices, 2 for 16-bit indices. `src_sz` must be a multiple of it.
+ * @param channels       Words per vertex e.g. 3 for positions and normals, 2 for UVs, 1 otherwise.
+ * @param src_ptr        Raw array, as stored in an uncompressed sequence. Must not be NULL unless `src_sz` is 0.
+ * @param src_sz         Size of the raw array in bytes.
+ * @param dst_ptr        Memory to write the stream header and encoded data to. Must not be NULL.
+ * @param dst_max_sz     Size of memory at `dst_ptr`. `vol_geom_encode_stream_bound()` is always enough.
+ * @returns              Number of bytes written to `dst_ptr`, or -1 on error.
+ */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_encode_stream(
+  int codec, int word_sz, int channels, const uint8_t* src_ptr, vol_geom_size_t src_sz, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz );
+
+/** Encode the vertices or normals of a tracked frame as a VOL_GEOM_STREAM_CODEC_DELTA_Q16 stream. Used by tools, not at run-time.
+ * @param reference_ptr  On input, the same array of the previous frame as a player will have decoded it.
+ *                       On output, this frame as a player will decode it, ready to be the reference for the next frame. Must not be NULL.
+ * @param src_ptr        This frame's original floats. Must not be NULL.
+ * @param src_sz         Size of the array in bytes. Both arrays must be this size.
+ * @param channels       Floats per vertex, usually 3.
+ * @param min_step       Quantization step, in the same units as the array. Larger steps compress better.
+ *                       The step used is raised automatically if a difference would not fit in 16 bits.
+ * @param dst_ptr        Memory to write the stream to. Must not be NULL.
+ * @param dst_max_sz     Size of memory at `dst_ptr`. `vol_geom_encode_stream_bound()` is always enough.
+ * @param max_error_ptr  If not NULL, the largest absolute error of any component after decoding is written here.
+ * @returns              Number of bytes written to `dst_ptr`, or -1 on error.
+ */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_encode_delta_stream( float* reference_ptr, const float* src_ptr, vol_geom_size_t src_sz, int channels, float min_step,
+  uint8_t* dst_ptr, vol_geom_size_t dst_max_sz, float* max_error_ptr );
+
+/** Encode a float array with a quantizing codec. Used by tools, not at run-time.
+ * @param codec          VOL_GEOM_STREAM_CODEC_UNORM16, VOL_GEOM_STREAM_CODEC_OCT16, or VOL_GEOM_STREAM_CODEC_HALF.
+ * @param src_ptr        Original floats. Must not be NULL.
+ * @param src_sz         Size of the array in bytes.
+ * @param channels       Floats per vertex, from 1 to 4. Must be 3 for VOL_GEOM_STREAM_CODEC_OCT16.
+ * @param bounds_ptr     VOL_GEOM_STREAM_CODEC_UNORM16 only: minimum of each channel, then maximum of each channel. Otherwise ignored.
+ * @param decoded_ptr    If not NULL, `src_sz` bytes where the array is written as a player will decode it.
+ * @param dst_ptr        Memory to write the stream to. Must not be NULL.
+ * @param dst_max_sz     Size of memory at `dst_ptr`. `vol_geom_encode_stream_bound()` is always enough.
+ * @param max_error_ptr  If not NULL, the largest absolute error of any component after decoding is written here.
+ * @returns              Number of bytes written to `dst_ptr`, or -1 on error.
+ */
+VOL_GEOM_EXPORT vol_geom_size_t vol_geom_encode_quantized_stream( int codec, const float* src_ptr, vol_geom_size_t src_sz, int channels, const float* bounds_ptr,
+  float* decoded_ptr, uint8_t* dst_ptr, vol_geom_size_t dst_max_sz, float* max_error_ptr );
+
+/** Convert a frame's float attributes to the packed vertex layout.
+ * @param positions_ptr  3 floats per vertex. Must not be NULL.
+ * @param normals_ptr    3 floats per vertex, or NULL to leave normals zeroed.
+ * @param uvs_ptr        2 floats per vertex, or NULL to leave UVs zeroed. Tracked frames share the UVs of their keyframe.
+ * @param n_vertices     Number of vertices.
+ * @param bounds_ptr     Minimum x, y, z then maximum x, y, z that positions are normalised to. Use the same bounds for every frame of a sequence.
+ * @param dst_ptr        Array of `n_vertices` packed vertices to write. Must not be NULL.
+ */
+VOL_GEOM_EXPORT void vol_geom_pack_vertices( const float* positions_ptr, const float* normals_ptr, const float* uvs_ptr, int n_vertices, const float* bounds_ptr,
+  vol_geom_packed_vertex_t* dst_ptr );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
@@ -1,16 +1,28 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "volograms.h"
+#include "Async/ParallelFor.h"
+#include "vol_av.h"
+#include "vol_geom.h"
 
 #define LOCTEXT_NAMESPACE "FvologramsModule"
 
+/** Runs vol_geom's decoding jobs and vol_av's colour conversion jobs on the engine's task graph worker threads. */
+static void _parallel_for( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr ) {
+  ParallelFor( job_count, [job_fn, job_ctx_ptr]( int32 job_idx ) { job_fn( job_ctx_ptr, job_idx ); } );
+}
+
 void FvologramsModule::StartupModule() {
   // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+  vol_geom_set_parallel_for_callback( _parallel_for );
+  vol_av_set_parallel_for_callback( _parallel_for );
 }
 
 void FvologramsModule::ShutdownModule() {
   // This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
   // we call this function before unloading the module.
+  vol_geom_reset_parallel_for_callback();
+  vol_av_reset_parallel_for_callback();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -16,11 +16,32 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "ProceduralMeshComponent.h" // NOTE(Anton) manually added here _before_ the generated.h, which must go last.
 #include "vol_geom.h"                // vologram geometry
 #include "vol_av.h"                  // libav wrapper
+#include "VologramFrameCache.h"      // recently shown frames
+#include "VologramEditorCache.h"     // first frames previewed in the editor
+#include "VologramMemory.h"          // memory accounting and the global budget
+#include "VologramMeshComponent.h"   // proc mesh with precomputed bounds
 #include "VologramActor.generated.h" // NOTE(Anton) must be included last
 
+class UBoxComponent;
+class UVologramAsset;
+
+/** Direction of vologram playback. */
+UENUM( BlueprintType )
+enum class EVologramPlaybackMode : uint8 {
+  Forward,
+  Reverse,
+  PingPong UMETA( DisplayName = "Ping-Pong" ) ///< Forwards to the last frame then backwards to the first.
+};
+
+/** Fired once a vologram's first frame of geometry and video is shown, and playback can start. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam( FVologramReadyDelegate, AVologramActor*, Vologram );
+
 // NOTE(Anton) API macro here has the _module_ name, not the class name.
 UCLASS()
 class VOLOGRAMS_API AVologramActor : public AActor {
@@ -36,16 +57,25 @@ class VOLOGRAMS_API AVologramActor : public AActor {
   // * When any single setting in an actor's panel is changed. e.g. When the VOL header file path is changed, but without waiting for the sequence file path
   // change.
   // * Whenever the actor is moved in the editor scene.
-  // TODO(Anton) create a stand-in cube or bounding box here so it's easy to visualise/click in the editor.
+  // In the editor it only resets the actor if a path, or a file at one, has changed, then previews the first frame once the changes have settled.
   virtual void OnConstruction( const FTransform& Transform ) override;
 
+  /** Ticks in the editor while a preview is waiting to load. */
+  virtual bool ShouldTickIfViewportsOnly() const override;
+
   protected:
   // Called when the game starts or when spawned
   virtual void BeginPlay() override;
 
+  // Stops the video preroll worker before the actor goes away.
+  virtual void EndPlay( const EEndPlayReason::Type EndPlayReason ) override;
+
   // NOTE(Anton) First components manually added for the proc mesh.
   // UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-  UProceduralMeshComponent* proc_mesh_ptr;
+  UVologramMeshComponent* proc_mesh_ptr;
+  /** Wireframe box shown in place of the vologram while it loads asynchronously. Also a stand-in to see and click in the editor. */
+  UPROPERTY()
+  UBoxComponent* placeholder_ptr = NULL;
   TArray<FVector> vertices, normals;
   TArray<FVector2D> uvs;
   TArray<FLinearColor> vertex_colours;
@@ -54,11 +84,129 @@ class VOLOGRAMS_API AVologramActor : public AActor {
   void ClearMeshData();
   void ClearIntermediateMeshData();
 
+  /** Double-buffered positions and normals, in .vols axes, of the displayed frame and the next frame, for interpolation. */
+  TArray<float> interp_positions[2], interp_normals[2];
+  /** Frame held in each interpolation buffer, or -1 if none. */
+  int interp_frame_idx[2] = { -1, -1 };
+  /** Index of the interpolation buffer holding the displayed frame. */
+  int interp_current = 0;
+  /** Positions and normals blended between the two interpolation buffers. */
+  TArray<float> blend_positions, blend_normals;
+
+  /** Converts positions and normals from .vols axes to vertices, normals, and vertex_colours.
+   * @param normals_ptr      - May be NULL if the vologram has no normals.
+   */
+  void set_vertices_and_normals( const float* points_ptr, const float* normals_ptr, int n_vertices );
+
+  /** Builds normals_topology_ptr, and tangent_handedness, for the keyframe in triangles and uvs, unless already built for it.
+   * It is built once per keyframe and reused for its tracked frames.
+   * @returns                - False if it couldn't be built.
+   */
+  bool ensure_normals_topology( int n_vertices );
+
+  /** Computes area-weighted normals, in .vols axes, for volograms stored without normals. Call once triangles hold the frame's keyframe.
+   * @param normals_out      - Resized to 3 floats per vertex.
+   * @returns                - normals_out's data, or NULL if generate_normals is off or the normals couldn't be computed.
+   */
+  const float* generate_vertex_normals( const float* points_ptr, int n_vertices, TArray<float>& normals_out );
+
+  /** Fills tangents from UVs for a frame's positions and normals, in .vols axes. Call once triangles and uvs hold the frame's keyframe.
+   * Falls back to one default tangent, which the mesh section ignores, if generate_tangents is off or there are no normals.
+   */
+  void set_tangents( const float* points_ptr, const float* normals_ptr, int n_vertices );
+
+  /** Frees normals_topology_ptr, e.g. when another vologram is loaded. */
+  void free_normals_topology();
+
+  /** Gives proc_mesh_ptr the precomputed bounds of a frame, or of the two frames being blended, so they don't depend on the vertices.
+   * Does nothing if the vologram has no precomputed bounds.
+   * @param other_frame_idx  - Frame being blended towards, or -1.
+   */
+  void set_mesh_bounds( int frame_idx, int other_frame_idx );
+
+  /** Reads the frame after frame_idx, in the direction of playback, into the spare interpolation buffer, if the two frames share topology.
+   * Otherwise marks the buffer empty.
+   */
+  void prefetch_next_interpolation_frame( int frame_idx );
+
+  /** Fills an interpolation buffer from a cached frame, converting back to .vols axes. */
+  void set_interpolation_buffer( int buffer, int frame_idx, const FVologramFrameCache::FFrame& frame );
+
+  /** Blends the mesh between the displayed frame and the next, when both are in the interpolation buffers.
+   * @param t                - Fraction of the way to the next frame, from 0 to 1.
+   */
+  void update_mesh_with_interpolation( float t );
+
   /** Loads metadata about a vologram. Should be called once per vologram before playback.
    * @returns                - False if the vologram couldn't be loaded.
    */
   bool load_vologram_meta();
 
+  /** Closes the vologram being played, if any, and resets playback state, ready to load another. */
+  void close_vologram();
+
+  /** Opens vol_bundle_ptr if vol_header_path is a .volb bundle. Safe to call from a worker thread.
+   * @returns                - False if it is a bundle that couldn't be opened.
+   */
+  bool open_vologram_bundle();
+
+  /** Reads the header and frame directory into vol_geom_info, and chooses embedded_pixel_format. Call after open_vologram_bundle(). Safe to call
+   * from a worker thread.
+   * @returns                - False if the geometry couldn't be loaded.
+   */
+  bool open_vologram_geometry();
+
+  /** Opens the video, finds its renditions, and decodes its first frame, ready for finish_vologram_meta() to upload. Call after
+   * open_vologram_bundle(). Safe to call from a worker thread.
+   * @returns                - False if the video couldn't be opened.
+   */
+  bool open_vologram_video();
+
+  /** The game thread's part of loading, once the geometry and any video are open: sets the sequence bounds, the material, the frame rate, and
+   * uploads the first video frame.
+   */
+  void finish_vologram_meta();
+
+  /** @returns                - The transform in the vologram's header, followed by the scale from metres to centimetres. */
+  FTransform vologram_transform() const;
+
+  /** Moves and scales the actor by vologram_transform(). */
+  void apply_vologram_transform();
+
+  /** Starts loading the vologram on worker threads: the bundle, if there is one, then the geometry and the video in parallel. Tick() calls
+   * update_async_load() until the first frame is shown.
+   */
+  void start_async_load();
+
+  /** Starts geometry_load_future and video_load_future, once the bundle they both read from is open. Call on the game thread. */
+  void start_async_geometry_and_video();
+
+  /** Starts the geometry and the video once the bundle is open, shows the placeholder once the geometry is loaded, and the first frame once the
+   * video is too, then fires OnVologramReady. Call every tick
+   * while is_async_loading().
+   */
+  void update_async_load();
+
+  /** Waits for any asynchronous load to finish, e.g. before closing the vologram. The vologram is left half-loaded, so close it afterwards. */
+  void wait_for_async_load();
+
+  /** @returns                - True while an asynchronous load is running, when the game thread mustn't touch the geometry or the video. */
+  bool is_async_loading() const {
+    return this->bundle_load_future.IsValid() || this->geometry_load_future.IsValid() || this->video_load_future.IsValid();
+  }
+
+  /** Sizes the placeholder to a box in the mesh's axes and shows it, if show_loading_placeholder is set. */
+  void show_placeholder( const FBox& local_box );
+
+  /** A frame whose geometry is to be read, as found by start_frame_update(), and the result of reading it. */
+  struct FFrameRead {
+    int frame_idx                    = -1; // -1 if there is nothing to read.
+    bool is_keyframe                 = false;
+    bool topology_changed            = false;
+    bool ok                          = false;
+    vol_geom_frame_data_t frame_data = {};
+  };
+
   /** Play a particular frame number for a vologram.
    * @param frame_idx        - Note frames start at 0.
    * @param only_if_keyframe - Ignore loading if not a keyframe. Allows frameskip except over keyframes.
@@ -66,30 +214,334 @@ class VOLOGRAMS_API AVologramActor : public AActor {
    */
   bool update_mesh_with_frame( int frame_idx, bool only_if_keyframe );
 
+  /** The part of update_mesh_with_frame() before the frame is read. Shows the frame if it is cached, or already read for interpolation, and loads its
+   * keyframe first if its topology isn't known.
+   * @param read             - Set to the frame to read with read_frame_mesh_data() then show with show_frame_mesh_data(), or left with frame_idx -1
+   *                           if the frame has been shown or skipped.
+   * @returns                - False if the vologram or the frame couldn't be loaded.
+   */
+  bool start_frame_update( int frame_idx, bool only_if_keyframe, FFrameRead& read );
+
+  /** Reads a frame into vertices, normals, tangents, and, for a keyframe, triangles and uvs, without touching the mesh section or textures.
+   * The mesh arrays must have been cleared for the frame, as update_mesh_with_frame() does. Safe to call from a worker thread while loading.
+   * @param frame_data       - Filled with the frame read, for show_frame_mesh_data(). Valid until the next frame is read.
+   * @returns                - False if the frame couldn't be read.
+   */
+  bool read_frame_mesh_data( int frame_idx, bool is_keyframe, vol_geom_frame_data_t& frame_data );
+
+  /** Gives a frame read by read_frame_mesh_data() to the mesh section, uploads its embedded texture if used, and reads ahead.
+   * @param topology_changed - Replace the mesh section's indices and UVs too.
+   */
+  void show_frame_mesh_data( int frame_idx, bool topology_changed, const vol_geom_frame_data_t& frame_data );
+
+  /** Shows a frame from frame_cache, replacing the mesh section's indices and UVs if the frame uses a different topology. */
+  void update_mesh_with_cached_frame( int frame_idx, const FVologramFrameCache::FFrame& frame );
+
+  /** Starts an asynchronous read of the frame that will be read after frame_idx, so its file I/O overlaps with the rest of the tick. */
+  void read_ahead_geometry( int frame_idx );
+
+  /** Copies the displayed frame's vertices, normals, and colours into frame_cache, sharing mesh_topology. */
+  void add_frame_to_cache( int frame_idx );
+
+  /** Opens the video into vol_video_info, which must be closed, and sets its output format.
+   * @param use_bundle       - Read the bundle's video chunk instead of mp4_path, if it has one.
+   */
+  bool open_video( const char* mp4_path, bool use_bundle );
+
+  /** Opens the video file into vol_video_info. Reads the bundle's video chunk instead of mp4_path if use_bundle is set and it has one. */
+  bool open_video_file( const char* mp4_path, bool use_bundle );
+
+  /** Closes vol_video_info and opens one of video_renditions in its place, with the video cache budget. Stops the preroll worker first.
+   * @returns                - False if the rendition couldn't be opened, leaving vol_video_info closed.
+   */
+  bool open_video_rendition( int rendition );
+
+  /** Fills video_renditions with the main video, already open in vol_video_info, and each of vol_mp4_rendition_paths that opens, largest first. */
+  void find_video_renditions();
+
+  /** @returns                - The rendition in video_renditions to decode at the vologram's current size on screen. */
+  int choose_video_rendition() const;
+
+  /** @returns                - Width in pixels of the vologram's bounding sphere in the largest view of it, or -1 if there is no player view. */
+  float screen_size_px() const;
+
+  /** Chooses how many of the largest mips of a w by h video frame to leave out of the video texture at the vologram's size on screen, and
+   * remembers it in video_first_mip.
+   * @returns                - 0 to upload every mip, 1 to start at half size, and so on.
+   */
+  int choose_video_first_mip( int w, int h );
+
   /** Reads the next video frame as an image and copy into texture_ptr to update the texture. */
   void read_next_av_frame_to_texture();
 
+  /** Reads any video frame, in any order, and copies it into texture_ptr. Frames are cached so that playing backwards decodes each GOP once. */
+  void read_av_frame_to_texture( int frame_idx );
+
+  /** Copies the video frame last read into texture_ptr, or into texture_ptr and chroma_texture_ptr if the video gives YUV planes.
+   * With video_mips, builds each texture's mip chain too, leaving out mips larger than the vologram's size on screen needs.
+   */
+  void upload_av_frame_to_texture();
+
+  /** Copies the Y plane of the video frame last read into texture_ptr, and its U and V planes into chroma_texture_ptr, and sets them as the
+   * "luma" and "chroma" parameters of the mesh's material, with "full_range" and "bt709" saying how to convert them to RGB.
+   */
+  void upload_av_planes_to_textures();
+
+  /** Reads a frame from the sequence only for its embedded texture, and uploads that into texture_ptr. */
+  void read_embedded_texture( int frame_idx );
+
+  /** Uploads a frame's embedded texture data into texture_ptr as-is, in embedded_pixel_format. */
+  void upload_embedded_texture( int frame_idx, const vol_geom_frame_data_t& frame_data );
+
+  /** Sets texture_ptr as the "colour" parameter of the mesh's material. */
+  void bind_texture_to_material();
+
+  /** Shows current_frame in the video texture if it isn't already, from the sequence's embedded textures if they are used.
+   * Does nothing if the preroll worker holds the video, so call this every tick.
+   */
+  void update_video_texture();
+
+  /** Decodes current_frame's video into vol_video_info, without uploading it, and sets video_frame_decoded. Call with video_lock held.
+   * @returns                - False if the frame couldn't be decoded.
+   */
+  bool decode_video_frame();
+
+  /** Moves current_frame on by the time passed, in the playback mode's direction, and sets frame_work_t if blending between frames. Reopens the
+   * video when looping back to the start. The frame itself is shown by the frame work.
+   */
+  void advance_playback( float delta_s );
+
+  /** @returns                - True if current_frame's geometry or video isn't shown yet, or the mesh is to be blended towards the next frame. */
+  bool has_frame_work() const;
+
+  /** Asks UVologramSubsystem to show current_frame once every actor has ticked, within the budget shared by all volograms. Without the subsystem,
+   * shows it now.
+   */
+  void request_frame_work();
+
+  /** @returns                - This tick's priority for the frame budget, highest first: the vologram's size on screen, multiplied by the number
+   *                             of ticks its frame work has waited.
+   */
+  float frame_work_priority() const;
+
+  /** Frame work, split so the frames of every vologram shown in a tick can be read and decoded in parallel. begin_frame_work() and
+   * end_frame_work() run on the game thread, before and after run_frame_work_job(), which may run on any thread. The job only touches this actor.
+   */
+  void begin_frame_work();
+  void run_frame_work_job();
+  void end_frame_work();
+
+  friend class UVologramSubsystem;
+
+  /** Frame to be read by this tick's frame work. */
+  FFrameRead frame_read;
+  /** Fraction of the way to blend towards the next frame this tick, or -1 to show current_frame as it is. */
+  float frame_work_t = -1.0f;
+  /** current_frame as of the last frame work, so a frame that fails to read isn't read again every tick. */
+  int frame_work_frame = -1;
+  /** Ticks in a row this vologram's frame work has been put off to keep within the frame budget. */
+  int frame_work_wait_ticks = 0;
+  /** Time taken by this tick's frame work so far, on any thread. */
+  double frame_work_s = 0.0;
+  /** Smoothed time, in milliseconds, taken by this vologram's frame work, to plan each tick's budget with. */
+  float frame_work_ms = 0.0f;
+  /** Frame decoded into vol_video_info by decode_video_frame(), not yet uploaded, or -1. */
+  int video_frame_decoded = -1;
+
+  friend class FVologramMemory;
+
+  /** Works out the memory this vologram holds, by category, and reports it to FVologramMemory. The video and decoded sequences are left as last
+   * reported if the preroll worker holds the video.
+   */
+  void update_memory_usage();
+
+  /** Lowers frame_cache's budget to free about `bytes` of cached frames.
+   * @returns                - The bytes freed.
+   */
+  int64 shrink_geometry_cache( int64 bytes );
+
+  /** Lowers the video frame cache's budget to free about `bytes`, evicting its least recently used frames.
+   * @returns                - The bytes freed, or 0 if the preroll worker holds the video.
+   */
+  int64 shrink_video_cache( int64 bytes );
+
+  /** Frees the bundle's decoded compressed chunks if the vologram is paused. They are decoded again, whole, when next read.
+   * @returns                - The bytes freed.
+   */
+  int64 release_decoded_sequence();
+
+  /** Raises cache budgets lowered by shrink_geometry_cache() or shrink_video_cache() back towards geometry_cache_mb and video_cache_mb, keeping
+   * the frames cached.
+   * @param headroom_bytes   - Most memory the raised budgets may add.
+   * @returns                - The bytes added to the budgets.
+   */
+  int64 restore_cache_budgets( int64 headroom_bytes );
+
+  /** Budgets of frame_cache and the video frame cache: geometry_cache_mb and video_cache_mb, unless lowered to keep within vol.MemoryBudgetMB. */
+  int64 geometry_cache_budget_bytes = 0, video_cache_budget_bytes = 0;
+  /** Bytes of frames in the video frame cache, as last reported by update_memory_usage(). */
+  int64 video_cache_used_bytes = 0;
+  /** Last reported by update_memory_usage(). */
+  FVologramMemory::FUsage memory_usage;
+
+  /** Asks the preroll worker to decode the frames around frame_idx into the video cache, starting the worker if it isn't running. */
+  void request_video_preroll( int frame_idx );
+
+  /** Preroll worker body. Decodes the window around the latest requested frame, one frame at a time, until no new request is pending. */
+  void run_video_preroll();
+
+  /** Cancels any preroll request and waits for the worker to finish. Call before closing or reopening the video. */
+  void stop_video_preroll();
+
   /** Meta-data about vologram being played. */
   vol_geom_info_t vol_geom_info;
+  /** Bundle the vologram is read from, if vol_header_path is a .volb bundle, or NULL. Closed after the geometry and video that read from it. */
+  vol_geom_bundle_t* vol_bundle_ptr = NULL;
   /** Meta-data about video being played. */
   vol_av_video_t vol_video_info;
+  /** Held by whichever thread is using vol_video_info, once the preroll worker has been started. */
+  FCriticalSection video_lock;
+  /** Frame at the centre of the preroll window the worker should decode, or -1 to stop. */
+  FThreadSafeCounter preroll_target_frame;
+  TFuture<void> preroll_future;
+
+  /** Load the vologram on worker threads, opening the geometry and the video in parallel, instead of on the game thread in BeginPlay(). The
+   * placeholder is shown until the first frame of both is ready, then OnVologramReady fires and playback starts.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Load asynchronously" )
+  bool async_loading = true;
+  /** Show a wireframe box of the vologram's bounds while it loads asynchronously. */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Show loading placeholder" )
+  bool show_loading_placeholder = true;
+  /** First step of an asynchronous load. Opens the bundle, if the vologram is one, which the geometry and the video are then read from. */
+  TFuture<bool> bundle_load_future;
+  /** Geometry half of an asynchronous load, started once bundle_load_future is ready. Reads the geometry and frame 0. */
+  TFuture<bool> geometry_load_future;
+  /** Video half of an asynchronous load, started with geometry_load_future. Opens the video and decodes its first frame. */
+  TFuture<bool> video_load_future;
+  /** Frame 0 as read by geometry_load_future, for show_frame_mesh_data(). */
+  vol_geom_frame_data_t loaded_frame_data = {};
+
+#if WITH_EDITOR
+  /** @returns                - The key of this vologram's preview in FVologramEditorCache: its paths, their files' modification times, and the options
+   *                             that change how the first frame looks.
+   */
+  FString editor_preview_key() const;
+
+  /** Counts down to loading the preview, and loads it from FVologramEditorCache, or from the files if it isn't cached. */
+  void update_editor_preview( float delta_s );
+
+  /** Loads the vologram, reads its first frame and texture into a preview, then closes it again, so the editor keeps no files open.
+   * @returns                - NULL if the vologram couldn't be loaded.
+   */
+  TSharedPtr<const FVologramEditorCache::FPreview> load_editor_preview();
+
+  /** Gives a preview to the mesh section and the material. */
+  void show_editor_preview( const FVologramEditorCache::FPreview& preview );
+
+  /** Sets the material the preview needs, unless it is already set, e.g. after another setting changed, and gives it the preview's textures. */
+  void set_editor_preview_material( const FVologramEditorCache::FPreview& preview );
+
+  /** editor_preview_key() of the vologram previewed, or waiting to be. Empty if none. */
+  FString editor_preview_key_shown;
+  /** Seconds left until the preview loads, restarted by each change to a path. Negative if no preview is waiting. */
+  float editor_preview_timer_s = -1.0f;
+#endif
+
+  /** Recently shown frames, ready to give to proc_mesh_ptr, so that scrubbing back and forth doesn't read frames again. */
+  FVologramFrameCache frame_cache;
+  /** Indices and UVs in the mesh section. Shared with frame_cache. NULL if the cache is off. */
+  TSharedPtr<const FVologramFrameCache::FTopology> mesh_topology;
+
+  /** Compute normals for volograms stored without them, such as version 10 captures, instead of leaving them unlit or to the engine. */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Generate normals" )
+  bool generate_normals = true;
+  /** Compute tangents from the UVs, for normal-mapped or anisotropic materials. Costs a pass over the mesh for every frame and interpolated tick. */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Generate tangents" )
+  bool generate_tangents = true;
+  /** Triangle adjacency and UV setup of keyframe normals_topology_keyframe, for generated normals and tangents. NULL if not built yet. */
+  vol_geom_normals_topology_t* normals_topology_ptr = NULL;
+  int normals_topology_keyframe = -1;
+  /** -1 for each vertex of normals_topology_keyframe whose UVs are mirrored, otherwise 1. Empty if the UVs couldn't be set up. */
+  TArray<int8> tangent_handedness;
+  /** Normals and tangents generated for the frame being shown. */
+  TArray<float> generated_normals, generated_tangents;
 
   // TODO(Anton) check if it works if i remove this material - not using it any more as we have dynamic material.
   UPROPERTY( EditAnywhere, Category = "Volograms" )
   UMaterialInterface* Material;
 
   UPROPERTY( EditAnywhere, Category = "Volograms" )
-  /** Pointer to custom vologram texture updated from the video. */
+  /** Pointer to custom vologram texture updated from the video. Holds the Y plane with GPU colour conversion. */
   UTexture2D* texture_ptr = NULL;
 
+  /** Interleaved U and V planes of the video, with GPU colour conversion. */
+  UPROPERTY()
+  UTexture2D* chroma_texture_ptr = NULL;
+
+  /** Upload the video as YUV planes, 1.5 bytes per pixel, and convert them to RGB in yuv_material, instead of converting on the CPU. */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "GPU colour conversion" )
+  bool gpu_colour_conversion = false;
+
+  /** Material used with GPU colour conversion. It must convert the "luma" and "chroma" texture parameters to RGB, as described in the README. */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "YUV material" )
+  UMaterialInterface* yuv_material = NULL;
+
+  /** True if the video gives YUV planes, converted by yuv_material. */
+  bool video_planes = false;
+
+  /** Build a mip chain for the video texture from each frame, so that distant volograms sample smaller mips instead of aliasing. Mips larger than
+   * the vologram's size on screen needs are left out, so distant volograms also upload less.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Video mips" )
+  bool video_mips = true;
+  /** Number of the video frame's largest mips left out of the video textures. */
+  int video_first_mip = 0;
+  /** Mips halved on the way to the video texture's first mip. */
+  TArray<uint8> mip_scratch;
+  /** I420 chroma planes interleaved for chroma_texture_ptr. */
+  TArray<uint8> chroma_scratch;
+
+  /** A vologram imported into the content browser, cooked and streamed like other assets. When set, the header, sequence, and video paths below are
+   * ignored. The video renditions are still used.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Vologram asset" )
+  UVologramAsset* vologram_asset = NULL;
+
   // NOTE(Anton) path helpers in FPaths class: https://docs.unrealengine.com/en-US/API/Runtime/Core/Misc/FPaths/index.html
   // NOTE(Anton) directory path also exists: FDirectoryPath
+  /** The .vols header, or a .volb bundle from `vol_geom_pack bundle`. A bundle holds the sequence, and usually the video, so those paths are then
+   * ignored, except the video path if the bundle has no video.
+   */
   UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "VOL header file" )
   FFilePath vol_header_path;
   UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "VOL sequence file" )
   FFilePath vol_sequence_path;
   UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "VOL video file" )
   FFilePath vol_mp4_path;
+  /** Smaller copies of the video, e.g. 1024x1024 and 512x512 copies of a 2048x2048 video, with the same frame rate and keyframes.
+   * The smallest that covers the vologram's size on screen is decoded, switching at keyframes, so distant volograms cost less to decode and upload.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "VOL video renditions" )
+  TArray<FFilePath> vol_mp4_rendition_paths;
+  /** Video pixels wanted across the vologram per pixel it covers on screen. The video is an atlas of the whole surface, so the side facing the
+   * camera gets only part of its width. Lower values switch to smaller renditions, and leave out video mips, sooner.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Rendition texels per pixel", meta = ( ClampMin = "0.1" ) )
+  float rendition_texels_per_pixel = 2.0f;
+
+  /** A video that can be shown: the main video, or one of vol_mp4_rendition_paths. */
+  struct FVideoRendition {
+    FString path;
+    /** Larger of the video's width and height. */
+    int size = 0;
+    /** True for the main video, which is read from the bundle if it has a video chunk. */
+    bool is_main = false;
+  };
+  /** Videos that opened when the vologram was loaded, largest first. */
+  TArray<FVideoRendition> video_renditions;
+  /** Index in video_renditions of the video open in vol_video_info. */
+  int video_rendition = 0;
   // UPROPERTY( EditAnywhere, Category = "Volograms" )
   bool vol_meta_info_loaded = false;
   // UPROPERTY( EditAnywhere, Category = "Volograms" )
@@ -103,6 +555,7 @@ class VOLOGRAMS_API AVologramActor : public AActor {
   // UPROPERTY( EditAnywhere, Category = "Volograms" )
   int current_frame = 0;
   // UPROPERTY( EditAnywhere, Category = "Volograms" )
+  /** Last keyframe loaded, whose indices and UVs are in the mesh section. */
   int previous_keyframe_loaded = -1;
   // UPROPERTY( EditAnywhere, Category = "Volograms" )
   int previous_frame_loaded = -1;
@@ -110,8 +563,57 @@ class VOLOGRAMS_API AVologramActor : public AActor {
   bool playing = true;
   UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Loop playback" )
   bool loop_vologram = true;
+  /** Play forwards, backwards, or back and forth. With looping off, ping-pong playback stops after one round trip. */
+  UPROPERTY( EditAnywhere, BlueprintReadWrite, Category = "Volograms", DisplayName = "Playback mode" )
+  EVologramPlaybackMode playback_mode = EVologramPlaybackMode::Forward;
+  /** Current direction of playback: 1 or -1. */
+  int playback_step = 1;
+  /** Frame shown in the video texture, or -1 if none. */
+  int video_frame_loaded = -1;
+  /** Show the textures stored in the sequence, if it has them in a format the platform's GPU can sample, instead of decoding the video.
+   * Mesh UVs then aren't flipped, as embedded textures are in Unity's layout.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Use embedded textures" )
+  bool use_embedded_textures = true;
+  /** Format of the embedded textures being shown, or PF_Unknown if the video is used. */
+  EPixelFormat embedded_pixel_format = PF_Unknown;
+  /** Memory for decoded video frames kept for reverse playback. Playing backwards without decoding a GOP more than once needs a GOP's worth of
+   * frames: about 16MB per frame of 2048x2048 video, or 6MB with GPU colour conversion.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Video frame cache (MB)", meta = ( ClampMin = "0" ) )
+  int video_cache_mb = 256;
+  /** Number of video frames before and after the playhead to decode ahead of time on a worker thread, so that scrubbing and short jumps show the
+   * texture without decoding on the game thread. The video frame cache must hold twice this many frames, plus one. 0 turns preroll off.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Video preroll frames", meta = ( ClampMin = "0" ) )
+  int video_preroll_frames = 0;
+  /** Memory for recently shown mesh frames, so that jumping or scrubbing back to them is free. A frame of a 60k vertex vologram takes 2-4MB.
+   * 0 turns the cache off.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Geometry frame cache (MB)", meta = ( ClampMin = "0" ) )
+  int geometry_cache_mb = 256;
+  /** Blend vertices and normals towards the next frame on every tick, so e.g. 30 FPS volograms move smoothly on 90 Hz headsets.
+   * Frames are never blended across a keyframe, where topology changes.
+   */
+  UPROPERTY( EditAnywhere, Category = "Volograms", DisplayName = "Interpolate between frames" )
+  bool interpolate_frames = false;
 
   public:
   // Called every frame
   virtual void Tick( float DeltaTime ) override;
+
+  /** Fired once the first frame of geometry and video is shown after loading, when playback starts. */
+  UPROPERTY( BlueprintAssignable, Category = "Volograms" )
+  FVologramReadyDelegate OnVologramReady;
+
+  /** @returns                - True once the vologram is loaded and its first frame shown. */
+  UFUNCTION( BlueprintPure, Category = "Volograms" )
+  bool is_vologram_ready() const { return this->vol_meta_info_loaded && this->loaded_first_frame && !is_async_loading(); }
+
+  /** Jumps to a frame, e.g. from a timeline or scrubbing tool. The mesh updates immediately; the video texture updates as soon as the frame is
+   * decoded, which is immediate if it is in the preroll window.
+   * @param frame_idx        - Note frames start at 0.
+   */
+  UFUNCTION( BlueprintCallable, Category = "Volograms" )
+  void seek_to_frame( int32 frame_idx );
 };
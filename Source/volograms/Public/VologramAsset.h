@@ -0,0 +1,71 @@
+/**
+ * Vologram asset, imported into the content browser.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * The asset holds the vologram as a bundle (see vol_geom_bundle_open()) in bulk data that is never inline in the package, so it cooks into the
+ * package's bulk data file or IoStore container and is left on disk when the asset loads. The actor opens the bundle through
+ * FVologramFileIO::asset_io(), which reads chunk ranges as bulk data streaming requests, scheduled by the engine alongside its other async I/O.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Serialization/BulkData.h"
+#include "VologramAsset.generated.h" // NOTE(Anton) must be included last
+
+UCLASS( BlueprintType, hidecategories = Object )
+class VOLOGRAMS_API UVologramAsset : public UObject {
+  GENERATED_BODY()
+
+  public:
+  UVologramAsset();
+
+  virtual void Serialize( FArchive& Ar ) override;
+
+  /** The vologram as a bundle: header, sequence, video if it has one, and the bounds of each frame. */
+  FByteBulkData bundle_data;
+
+  UPROPERTY( VisibleAnywhere, Category = "Volograms", DisplayName = "Frame count" )
+  int32 frame_count = 0;
+  UPROPERTY( VisibleAnywhere, Category = "Volograms", DisplayName = "Has video" )
+  bool has_video = false;
+  UPROPERTY( VisibleAnywhere, Category = "Volograms", DisplayName = "Has embedded textures" )
+  bool has_embedded_textures = false;
+
+  /** New on every import, so previews of the previous import are not reused. */
+  UPROPERTY()
+  FGuid import_guid;
+
+#if WITH_EDITORONLY_DATA
+  /** Files the vologram was imported from. */
+  UPROPERTY( VisibleAnywhere, Category = "Volograms", DisplayName = "Source files" )
+  TArray<FString> source_paths;
+
+  /** The bundle as imported. Bulk data can only be streamed from a saved package, so until the editor is restarted the bundle is read from here. */
+  TArray<uint8> imported_bundle;
+#endif
+
+#if WITH_EDITOR
+  /** Imports a bundle written by `vol_geom_pack bundle`.
+   * @returns                - False if the file couldn't be read or isn't a bundle of a valid vologram. The asset is unchanged.
+   */
+  bool import_bundle( const FString& bundle_path );
+
+  /** Imports a vologram's separate files, bundling them with the bounds of each frame.
+   * @param video_path       - May be empty, for volograms with embedded textures or no texture.
+   * @returns                - False if a file couldn't be read or the vologram isn't valid. The asset is unchanged.
+   */
+  bool import_files( const FString& hdr_path, const FString& seq_path, const FString& video_path );
+
+  private:
+  /** Replaces the bundle with bundle_bytes, if it opens, and updates the details shown for the asset. */
+  bool set_bundle( TArray<uint8>& bundle_bytes, const TArray<FString>& paths );
+#endif
+};
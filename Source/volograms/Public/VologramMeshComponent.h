@@ -0,0 +1,31 @@
+/**
+ * Procedural mesh component for volograms, with bounds known before any frame is loaded.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "VologramMeshComponent.generated.h" // NOTE(Anton) must be included last
+
+/** A UProceduralMeshComponent whose bounds can be given, from a vologram's precomputed bounding boxes, instead of found from its mesh sections.
+ * The component then has bounds before the first frame is loaded, so the engine can cull it before anything is decoded.
+ */
+UCLASS()
+class VOLOGRAMS_API UVologramMeshComponent : public UProceduralMeshComponent {
+  GENERATED_BODY()
+
+  public:
+  /** Use local_box, in component space, as the bounds. An invalid box, e.g. FBox( ForceInit ), goes back to the bounds of the mesh sections. */
+  void set_local_bounds( const FBox& local_box );
+
+  virtual FBoxSphereBounds CalcBounds( const FTransform& LocalToWorld ) const override;
+
+  private:
+  FBox local_bounds = FBox( ForceInit );
+};
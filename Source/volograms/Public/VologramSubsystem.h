@@ -0,0 +1,52 @@
+/**
+ * Schedules the frame work of every vologram in a world.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * Each AVologramActor works out which frame to show in its own Tick(), then asks for it here. The subsystem ticks after every actor, and shows the
+ * frames in order of priority, up to a budget of milliseconds per tick set by `vol.FrameBudgetMs`: each vologram's geometry is read and its video
+ * decoded in parallel, on the task graph, and the mesh sections and textures are updated on the game thread. A vologram over budget keeps its last
+ * frame, and jumps straight to its current one when its turn comes, skipping the frames in between, so the tick isn't made any longer. No vologram
+ * is put off for more than `vol.MaxFrameSkip` ticks in a row. Once the frames are shown, the volograms are kept within `vol.MemoryBudgetMB`, see
+ * FVologramMemory.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "VologramSubsystem.generated.h" // NOTE(Anton) must be included last
+
+class AVologramActor;
+
+UCLASS()
+class VOLOGRAMS_API UVologramSubsystem : public UWorldSubsystem, public FTickableGameObject {
+  GENERATED_BODY()
+
+  public:
+  /** Asks for the actor's frame work to run this tick, after every actor has ticked. Call from the actor's Tick(). */
+  void request_frame_work( AVologramActor* actor_ptr );
+
+  /** @returns                - Milliseconds of frame work done last tick, and the number of volograms put off to keep within the budget. */
+  float last_frame_work_ms() const { return this->frame_work_ms; }
+  int last_deferred_count() const { return this->deferred_count; }
+
+  // FTickableGameObject
+  virtual void Tick( float DeltaTime ) override;
+  virtual TStatId GetStatId() const override;
+  virtual ETickableTickType GetTickableTickType() const override;
+  virtual bool IsTickable() const override;
+  virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+  private:
+  /** Actors asking for frame work this tick. */
+  TArray<TWeakObjectPtr<AVologramActor>> requests;
+  float frame_work_ms = 0.0f;
+  int deferred_count  = 0;
+};
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+
+/** Stats for profiling vologram playback. View in-game with `stat Volograms`. */
+DECLARE_STATS_GROUP( TEXT( "Volograms" ), STATGROUP_Volograms, STATCAT_Advanced );
 
 class FvologramsModule : public IModuleInterface {
   public:
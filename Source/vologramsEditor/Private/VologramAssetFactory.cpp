@@ -0,0 +1,132 @@
+/**
+ * Imports volograms as UVologramAsset.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+#include "VologramAssetFactory.h"
+#include "HAL/FileManager.h"
+#include "Misc/FeedbackContext.h"
+#include "Misc/Paths.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Templates/UniquePtr.h"
+#include "VologramAsset.h"
+
+/** @returns True if the file starts as a .vols header does, with the short string "VOLS". */
+static bool _is_vols_header( const FString& path ) {
+  TUniquePtr<FArchive> reader( IFileManager::Get().CreateFileReader( *path ) );
+  uint8 format[5] = {};
+  if ( !reader || reader->TotalSize() < 5 ) { return false; }
+  reader->Serialize( format, 5 );
+  return 4 == format[0] && 0 == memcmp( &format[1], "VOLS", 4 );
+}
+
+/** @returns                - The start of a header's file name that the files exported with it share: "foo_" for "foo_header.vols", "" for "header.vols",
+ * or the whole name, without the extension, if it doesn't end in "header".
+ */
+static FString _export_stem( const FString& hdr_path ) {
+  FString name = FPaths::GetBaseFilename( hdr_path );
+  return name.EndsWith( TEXT( "header" ) ) ? name.LeftChop( 6 ) : name;
+}
+
+/** Finds the sequence and video exported with a .vols header, in its folder. They are the files whose names start with the header's stem, and not with
+ * the longer stem of another header there, so that several volograms can share a folder. The sequence is the one such .vols file that isn't a header,
+ * or, if there are several, the one named as a sequence, e.g. "foo_sequence.vols". The video is the biggest such .mp4 file, as the others are usually
+ * smaller renditions of it.
+ * @param warn_ptr         - Where to report a missing or ambiguous sequence.
+ * @returns                - False if there isn't exactly one sequence.
+ */
+static bool _find_exported_files( const FString& hdr_path, FString& seq_path, FString& video_path, FFeedbackContext* warn_ptr ) {
+  FString dir  = FPaths::GetPath( hdr_path );
+  FString stem = _export_stem( hdr_path );
+  TArray<FString> vols_names, mp4_names, other_stems, seq_names;
+  IFileManager::Get().FindFiles( vols_names, *( dir / TEXT( "*.vols" ) ), true, false );
+  IFileManager::Get().FindFiles( mp4_names, *( dir / TEXT( "*.mp4" ) ), true, false );
+  vols_names.Sort();
+  for ( const FString& name : vols_names ) {
+    if ( !_is_vols_header( dir / name ) ) {
+      seq_names.Add( name );
+    } else if ( name != FPaths::GetCleanFilename( hdr_path ) ) {
+      other_stems.Add( _export_stem( name ) );
+    }
+  }
+  auto is_exported_with_header = [&]( const FString& name ) {
+    if ( !name.StartsWith( stem ) ) { return false; }
+    for ( const FString& other_stem : other_stems ) {
+      if ( other_stem.Len() > stem.Len() && name.StartsWith( other_stem ) ) { return false; }
+    }
+    return true;
+  };
+  seq_names.RemoveAll( [&]( const FString& name ) { return !is_exported_with_header( name ); } );
+  mp4_names.RemoveAll( [&]( const FString& name ) { return !is_exported_with_header( name ); } );
+
+  if ( seq_names.Num() > 1 ) {
+    TArray<FString> named_seq_names =
+      seq_names.FilterByPredicate( [&]( const FString& name ) { return name.RightChop( stem.Len() ).StartsWith( TEXT( "sequence" ) ); } );
+    if ( named_seq_names.Num() > 0 ) { seq_names = named_seq_names; }
+  }
+  if ( 0 == seq_names.Num() ) {
+    warn_ptr->Logf( ELogVerbosity::Error, TEXT( "[VOL] ERROR: no sequence .vols file next to header `%s`." ), *hdr_path );
+    return false;
+  }
+  if ( seq_names.Num() > 1 ) {
+    warn_ptr->Logf( ELogVerbosity::Error, TEXT( "[VOL] ERROR: can't tell which of %s goes with header `%s`. Name it as the header, e.g. foo_sequence.vols for "
+                                                "foo_header.vols, or import it from its own folder." ),
+      *FString::Join( seq_names, TEXT( ", " ) ), *hdr_path );
+    return false;
+  }
+  seq_path = dir / seq_names[0];
+
+  int64 video_sz = -1;
+  for ( const FString& name : mp4_names ) {
+    FString path = dir / name;
+    int64 sz     = IFileManager::Get().FileSize( *path );
+    if ( sz > video_sz ) {
+      video_path = path;
+      video_sz   = sz;
+    }
+  }
+  if ( mp4_names.Num() > 1 ) {
+    UE_LOG( LogClass, Log, TEXT( "[VOL] Importing the biggest video, `%s`. Set the others as the actor's video renditions." ), *video_path );
+  }
+  return true;
+}
+
+UVologramAssetFactory::UVologramAssetFactory() {
+  SupportedClass = UVologramAsset::StaticClass();
+  bCreateNew     = false;
+  bEditorImport  = true;
+  Formats.Add( TEXT( "volb;Vologram bundle" ) );
+  Formats.Add( TEXT( "vols;Vologram header" ) );
+}
+
+bool UVologramAssetFactory::FactoryCanImport( const FString& Filename ) {
+  FString extension = FPaths::GetExtension( Filename );
+  if ( extension == TEXT( "volb" ) ) { return true; }
+  return extension == TEXT( "vols" ) && _is_vols_header( Filename );
+}
+
+UObject* UVologramAssetFactory::FactoryCreateFile( UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename,
+  const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled ) {
+  bool is_bundle = FPaths::GetExtension( Filename ) == TEXT( "volb" );
+  FString seq_path, video_path;
+  if ( !is_bundle && !_find_exported_files( Filename, seq_path, video_path, Warn ) ) { return NULL; }
+
+  UVologramAsset* asset_ptr = NewObject<UVologramAsset>( InParent, InClass, InName, Flags );
+  bool ok                   = is_bundle ? asset_ptr->import_bundle( Filename ) : asset_ptr->import_files( Filename, seq_path, video_path );
+  if ( !ok ) {
+    Warn->Logf( ELogVerbosity::Error, TEXT( "[VOL] ERROR: importing vologram `%s`. See the log for details." ), *Filename );
+    // Don't leave an asset without a vologram in the package, to be saved or found by name.
+    asset_ptr->ClearFlags( RF_Public | RF_Standalone );
+#if ENGINE_MAJOR_VERSION == 4
+    asset_ptr->MarkPendingKill();
+#else
+    asset_ptr->MarkAsGarbage();
+#endif
+    return NULL;
+  }
+  return asset_ptr;
+}
@@ -0,0 +1,32 @@
+/**
+ * Imports volograms as UVologramAsset.
+ *
+ * Authors:   Anton Gerdelan <anton@volograms.com> \n
+ * Copyright: 2022, Volograms (http://volograms.com/) \n
+ * Language:  C++ \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ */
+
+/* NOTES
+ * A bundle is imported as it is. A .vols header is imported with the sequence and video exported next to it, bundled with the bounds of each frame.
+ * Only the header can be imported from a vologram's separate files: its first bytes are a short string, "VOLS", where a sequence starts with its
+ * first frame's number, so the importer can tell them apart whatever they are named.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Factories/Factory.h"
+#include "VologramAssetFactory.generated.h" // NOTE(Anton) must be included last
+
+UCLASS()
+class UVologramAssetFactory : public UFactory {
+  GENERATED_BODY()
+
+  public:
+  UVologramAssetFactory();
+
+  virtual bool FactoryCanImport( const FString& Filename ) override;
+  virtual UObject* FactoryCreateFile( UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms,
+    FFeedbackContext* Warn, bool& bOutOperationCanceled ) override;
+};
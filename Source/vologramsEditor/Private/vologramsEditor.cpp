@@ -0,0 +1,7 @@
+// Copyright 2021 Volograms, Ltd.
+// http://volograms.com/
+
+#include "Modules/ModuleManager.h"
+
+// The module only holds the vologram import factory, which the editor finds by its class.
+IMPLEMENT_MODULE( FDefaultModuleImpl, vologramsEditor )
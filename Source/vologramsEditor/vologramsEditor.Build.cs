@@ -0,0 +1,29 @@
+// Copyright 2021 Volograms, Ltd.
+// http://volograms.com/
+
+using UnrealBuildTool;
+
+public class vologramsEditor : ModuleRules
+{
+  public vologramsEditor(ReadOnlyTargetRules Target) : base(Target)
+  {
+    PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+    PublicDependencyModuleNames.AddRange(
+      new string[]
+      {
+        "Core"
+      }
+      );
+
+    PrivateDependencyModuleNames.AddRange(
+      new string[]
+      {
+        "CoreUObject",
+        "Engine",
+        "UnrealEd",
+        "volograms"
+      }
+      );
+  }
+}
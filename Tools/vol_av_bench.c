@@ -0,0 +1,177 @@
+/** @file vol_av_bench.c
+ * Volograms Colour Conversion Benchmark
+ *
+ * Version:   0.1 \n
+ * Copyright: 2026, Volograms (http://volograms.com/) \n
+ * Language:  C11 \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ *
+ * Command-line tool that times vol_av_yuv420_to_rgba() against swscale, converting synthetic 4:2:0 frames at 1080p, 2048x2048, and 4K,
+ * and reports the largest difference between their RGBA images. swscale to RGB24 is what vol_av did before it had RGBA output.
+ *
+ * With `--threads N`, vol_av's conversion is spread over N threads. Build with `-march=native`, or another target with AVX2, to use the AVX2 kernel.
+ *
+ * Build (from this directory):
+ *   cc -std=gnu11 -O2 -march=native -I../Source/volograms/Private vol_av_bench.c ../Source/volograms/Private/vol_av.c -o vol_av_bench \
+ *     -lavformat -lavcodec -lswscale -lavutil -lpthread
+ *
+ * Usage:
+ *   vol_av_bench [REPEATS] [--threads N]
+ */
+
+#include "vol_av.h"
+#include <libswscale/swscale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+static double _time_s( void ) {
+  struct timespec ts;
+  timespec_get( &ts, TIME_UTC );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#ifndef _WIN32
+#define MAX_THREADS 64
+
+static int _n_threads = 1;
+
+typedef struct thread_job_t {
+  void ( *job_fn )( void* job_ctx_ptr, int job_idx );
+  void* job_ctx_ptr;
+  int first_job_idx, job_count;
+} thread_job_t;
+
+static void* _thread_main( void* arg_ptr ) {
+  thread_job_t* job_ptr = (thread_job_t*)arg_ptr;
+  for ( int i = job_ptr->first_job_idx; i < job_ptr->job_count; i += _n_threads ) { job_ptr->job_fn( job_ptr->job_ctx_ptr, i ); }
+  return NULL;
+}
+
+/** Stand-in for an engine's job system: _n_threads threads, each taking every _n_threads'th job. */
+static void _thread_parallel_for( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr ) {
+  pthread_t threads[MAX_THREADS];
+  thread_job_t jobs[MAX_THREADS];
+  for ( int i = 0; i < _n_threads; i++ ) {
+    jobs[i] = ( thread_job_t ){ .job_fn = job_fn, .job_ctx_ptr = job_ctx_ptr, .first_job_idx = i, .job_count = job_count };
+    if ( i > 0 && 0 != pthread_create( &threads[i], NULL, _thread_main, &jobs[i] ) ) { threads[i] = 0; }
+  }
+  _thread_main( &jobs[0] ); // The calling thread takes a share too, as engine job systems usually do.
+  for ( int i = 1; i < _n_threads; i++ ) {
+    if ( threads[i] ) {
+      pthread_join( threads[i], NULL );
+    } else {
+      _thread_main( &jobs[i] );
+    }
+  }
+}
+#endif
+
+/** Fills a 4:2:0 frame with gradients and noise, so every Y, U, and V value, and most combinations, are converted. */
+static void _fill_frame( uint8_t* y_ptr, uint8_t* u_ptr, uint8_t* v_ptr, int w, int h ) {
+  uint32_t seed = 12345;
+  for ( int i = 0; i < w * h; i++ ) {
+    seed     = seed * 1664525u + 1013904223u;
+    y_ptr[i] = (uint8_t)( ( i % w ) * 255 / w + ( seed >> 28 ) );
+  }
+  int chroma_w = ( w + 1 ) / 2, chroma_h = ( h + 1 ) / 2;
+  for ( int i = 0; i < chroma_w * chroma_h; i++ ) {
+    seed     = seed * 1664525u + 1013904223u;
+    u_ptr[i] = (uint8_t)( ( i / chroma_w ) * 255 / chroma_h );
+    v_ptr[i] = (uint8_t)( seed >> 24 );
+  }
+}
+
+/** @return Milliseconds per conversion of a frame by swscale, into dst_ptr. */
+static double _bench_swscale( const uint8_t* const planes_ptrs[3], const int plane_strides[3], int w, int h, enum AVPixelFormat dst_format, uint8_t* dst_ptr,
+  int repeats ) {
+  // SWS_BILINEAR as vol_av used, though it makes no difference to an unscaled conversion.
+  struct SwsContext* sws_ctx_ptr = sws_getContext( w, h, AV_PIX_FMT_YUV420P, w, h, dst_format, SWS_BILINEAR, NULL, NULL, NULL );
+  if ( !sws_ctx_ptr ) { return -1.0; }
+  uint8_t* dst_ptrs[4] = { dst_ptr, NULL, NULL, NULL };
+  int dst_strides[4]   = { w * ( AV_PIX_FMT_RGBA == dst_format ? 4 : 3 ), 0, 0, 0 };
+  double start_s       = _time_s();
+  for ( int r = 0; r < repeats; r++ ) { sws_scale( sws_ctx_ptr, planes_ptrs, plane_strides, 0, h, dst_ptrs, dst_strides ); }
+  double elapsed_s = _time_s() - start_s;
+  sws_freeContext( sws_ctx_ptr );
+  return elapsed_s * 1000.0 / repeats;
+}
+
+/** @return Milliseconds per conversion of a frame by vol_av, into dst_ptr. */
+static double _bench_vol_av( const uint8_t* const planes_ptrs[3], const int plane_strides[3], int w, int h, uint8_t* dst_ptr, int repeats ) {
+  double start_s = _time_s();
+  for ( int r = 0; r < repeats; r++ ) {
+    if ( !vol_av_yuv420_to_rgba( planes_ptrs, plane_strides, VOL_AV_PLANES_I420, w, h, false, false, dst_ptr, w * 4 ) ) { return -1.0; }
+  }
+  return ( _time_s() - start_s ) * 1000.0 / repeats;
+}
+
+static int _bench( int w, int h, int repeats ) {
+  int chroma_w = ( w + 1 ) / 2, chroma_h = ( h + 1 ) / 2;
+  uint8_t* y_ptr      = malloc( (size_t)w * h );
+  uint8_t* u_ptr      = malloc( (size_t)chroma_w * chroma_h );
+  uint8_t* v_ptr      = malloc( (size_t)chroma_w * chroma_h );
+  uint8_t* sws_ptr    = malloc( (size_t)w * h * 4 );
+  uint8_t* vol_av_ptr = malloc( (size_t)w * h * 4 );
+  if ( !y_ptr || !u_ptr || !v_ptr || !sws_ptr || !vol_av_ptr ) {
+    fprintf( stderr, "ERROR: out of memory\n" );
+    free( y_ptr );
+    free( u_ptr );
+    free( v_ptr );
+    free( sws_ptr );
+    free( vol_av_ptr );
+    return 1;
+  }
+  _fill_frame( y_ptr, u_ptr, v_ptr, w, h );
+  const uint8_t* const planes_ptrs[3] = { y_ptr, u_ptr, v_ptr };
+  const int plane_strides[3]          = { w, chroma_w, chroma_w };
+
+  double sws_rgb_ms  = _bench_swscale( planes_ptrs, plane_strides, w, h, AV_PIX_FMT_RGB24, sws_ptr, repeats );
+  double sws_rgba_ms = _bench_swscale( planes_ptrs, plane_strides, w, h, AV_PIX_FMT_RGBA, sws_ptr, repeats );
+  double vol_av_ms   = _bench_vol_av( planes_ptrs, plane_strides, w, h, vol_av_ptr, repeats );
+
+  int max_diff = 0;
+  for ( size_t i = 0; i < (size_t)w * h * 4; i++ ) {
+    int diff = abs( (int)sws_ptr[i] - (int)vol_av_ptr[i] );
+    if ( diff > max_diff ) { max_diff = diff; }
+  }
+  printf( "%ix%i: swscale RGB24 %.2f ms, swscale RGBA %.2f ms, vol_av RGBA %.2f ms (%.1fx swscale RGBA). largest difference %i\n", w, h, sws_rgb_ms,
+    sws_rgba_ms, vol_av_ms, sws_rgba_ms / vol_av_ms, max_diff );
+
+  free( y_ptr );
+  free( u_ptr );
+  free( v_ptr );
+  free( sws_ptr );
+  free( vol_av_ptr );
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  int repeats = 50;
+  for ( int i = 1; i < argc; i++ ) {
+    if ( 0 == strcmp( argv[i], "--threads" ) && i + 1 < argc ) {
+#ifndef _WIN32
+      int n_threads = atoi( argv[++i] );
+      _n_threads    = n_threads < 1 ? 1 : n_threads > MAX_THREADS ? MAX_THREADS : n_threads;
+      vol_av_set_parallel_for_callback( _thread_parallel_for );
+#else
+      i++;
+#endif
+    } else if ( atoi( argv[i] ) > 0 ) {
+      repeats = atoi( argv[i] );
+    } else {
+      fprintf( stderr, "Usage:\n  %s [REPEATS] [--threads N]\n", argv[0] );
+      return 1;
+    }
+  }
+
+  const int sizes[][2] = { { 1920, 1080 }, { 2048, 2048 }, { 3840, 2160 } };
+  for ( int i = 0; i < 3; i++ ) {
+    if ( 0 != _bench( sizes[i][0], sizes[i][1], repeats ) ) { return 1; }
+  }
+  return 0;
+}
@@ -0,0 +1,199 @@
+/** @file vol_av_planes_check.c
+ * Volograms YUV Plane Output Check
+ *
+ * Version:   0.1 \n
+ * Copyright: 2026, Volograms (http://volograms.com/) \n
+ * Language:  C11 \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ *
+ * Command-line tool that decodes a video twice, once with VOL_AV_OUTPUT_YUV420_PLANES and once with VOL_AV_OUTPUT_RGBA32, and checks the planes:
+ * - the layout is I420 or NV12, with the plane pointers that layout uses and NULL for the others, and strides of at least a row;
+ * - converting the planes with vol_av_yuv420_to_rgba() gives exactly the RGBA output;
+ * - frames read back from the cache are packed one plane after another, without row padding, in w * h + 2 * ( ( w + 1 ) / 2 ) * ( ( h + 1 ) / 2 )
+ *   bytes, the same bytes as when they were decoded, and the cache reports that many bytes per frame.
+ *
+ * Build (from this directory):
+ *   cc -std=gnu11 -O2 -I../Source/volograms/Private vol_av_planes_check.c ../Source/volograms/Private/vol_av.c -o vol_av_planes_check \
+ *     -lavformat -lavcodec -lswscale -lavutil -lpthread
+ *
+ * Usage:
+ *   vol_av_planes_check VIDEO.mp4 [FRAMES]
+ */
+
+#include "vol_av.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Size of a plane as laid out in the cache: bytes per row, without padding, and rows. 0 by 0 for a plane the layout doesn't use. */
+static void _plane_dims( vol_av_plane_layout_t layout, int w, int h, int plane_idx, int* row_sz_ptr, int* n_rows_ptr ) {
+  int chroma_w = ( w + 1 ) / 2, chroma_h = ( h + 1 ) / 2;
+  *row_sz_ptr  = 0;
+  *n_rows_ptr  = 0;
+  if ( 0 == plane_idx ) {
+    *row_sz_ptr = w;
+    *n_rows_ptr = h;
+  } else if ( VOL_AV_PLANES_I420 == layout ) {
+    *row_sz_ptr = chroma_w;
+    *n_rows_ptr = chroma_h;
+  } else if ( VOL_AV_PLANES_NV12 == layout && 1 == plane_idx ) {
+    *row_sz_ptr = chroma_w * 2;
+    *n_rows_ptr = chroma_h;
+  }
+}
+
+/** Checks the layout, pointers, and strides of the planes given for a frame.
+ * @param packed If true, the planes must be as stored in the cache: strides of exactly a row, and each plane straight after the one before.
+ */
+static bool _check_planes( const vol_av_video_t* video_ptr, int64_t frame_idx, bool packed ) {
+  if ( VOL_AV_PLANES_I420 != video_ptr->plane_layout && VOL_AV_PLANES_NV12 != video_ptr->plane_layout ) {
+    fprintf( stderr, "ERROR: frame %lli: plane layout %i is neither I420 nor NV12\n", (long long)frame_idx, (int)video_ptr->plane_layout );
+    return false;
+  }
+  if ( video_ptr->pixels_ptr ) {
+    fprintf( stderr, "ERROR: frame %lli: pixels_ptr is set with plane output\n", (long long)frame_idx );
+    return false;
+  }
+  const uint8_t* next_ptr = video_ptr->planes_ptrs[0];
+  for ( int i = 0; i < 3; i++ ) {
+    int row_sz = 0, n_rows = 0;
+    _plane_dims( video_ptr->plane_layout, video_ptr->w, video_ptr->h, i, &row_sz, &n_rows );
+    if ( 0 == row_sz ) {
+      if ( video_ptr->planes_ptrs[i] ) {
+        fprintf( stderr, "ERROR: frame %lli: plane %i is set, but %s has no plane %i\n", (long long)frame_idx, i,
+          VOL_AV_PLANES_NV12 == video_ptr->plane_layout ? "NV12" : "I420", i );
+        return false;
+      }
+      continue;
+    }
+    if ( !video_ptr->planes_ptrs[i] || video_ptr->plane_strides[i] < row_sz ) {
+      fprintf( stderr, "ERROR: frame %lli: plane %i is %p with stride %i, for rows of %i bytes\n", (long long)frame_idx, i,
+        (const void*)video_ptr->planes_ptrs[i], video_ptr->plane_strides[i], row_sz );
+      return false;
+    }
+    if ( packed && ( video_ptr->plane_strides[i] != row_sz || video_ptr->planes_ptrs[i] != next_ptr ) ) {
+      fprintf( stderr, "ERROR: frame %lli: cached plane %i has stride %i, for rows of %i bytes, and starts %lli bytes after the plane before ends\n",
+        (long long)frame_idx, i, video_ptr->plane_strides[i], row_sz, (long long)( video_ptr->planes_ptrs[i] - next_ptr ) );
+      return false;
+    }
+    next_ptr = video_ptr->planes_ptrs[i] + (size_t)row_sz * n_rows;
+  }
+  return true;
+}
+
+/** Copies a frame's planes into dst_ptr one after another, without row padding, as the cache stores them. */
+static void _pack_planes( const vol_av_video_t* video_ptr, uint8_t* dst_ptr ) {
+  for ( int i = 0; i < 3; i++ ) {
+    int row_sz = 0, n_rows = 0;
+    _plane_dims( video_ptr->plane_layout, video_ptr->w, video_ptr->h, i, &row_sz, &n_rows );
+    for ( int y = 0; y < n_rows; y++ ) {
+      memcpy( dst_ptr, video_ptr->planes_ptrs[i] + (size_t)y * video_ptr->plane_strides[i], (size_t)row_sz );
+      dst_ptr += row_sz;
+    }
+  }
+}
+
+static int _check( const char* video_path, int64_t n_frames ) {
+  vol_av_video_t rgba = { 0 }, planes = { 0 };
+  if ( !vol_av_open( video_path, &rgba ) || !vol_av_open( video_path, &planes ) ) {
+    fprintf( stderr, "ERROR: could not open video `%s`\n", video_path );
+    vol_av_close( &rgba );
+    vol_av_close( &planes );
+    return 1;
+  }
+  int64_t frame_count = vol_av_frame_count( &planes );
+  if ( frame_count > 0 && n_frames > frame_count ) { n_frames = frame_count; }
+  int w = 0, h = 0;
+  vol_av_dimensions( &planes, &w, &h );
+  int64_t frame_sz   = (int64_t)w * h + 2 * (int64_t)( ( w + 1 ) / 2 ) * ( ( h + 1 ) / 2 );
+  uint8_t* packed_ptr = malloc( (size_t)( frame_sz * n_frames ) );
+  uint8_t* rgba_ptr   = malloc( (size_t)w * h * 4 );
+  bool ok             = packed_ptr && rgba_ptr;
+  if ( !ok ) { fprintf( stderr, "ERROR: out of memory\n" ); }
+  if ( ok && ( !vol_av_set_output_format( &rgba, VOL_AV_OUTPUT_RGBA32 ) || !vol_av_set_output_format( &planes, VOL_AV_OUTPUT_YUV420_PLANES ) ) ) {
+    fprintf( stderr, "ERROR: could not set output formats\n" );
+    ok = false;
+  }
+  if ( ok ) { vol_av_set_cache_budget( &planes, frame_sz * n_frames ); }
+
+  // Decoded in order: the decoder's planes, which may have padded rows, against the RGBA output.
+  vol_av_plane_layout_t layout = VOL_AV_PLANES_NONE;
+  for ( int64_t i = 0; ok && i < n_frames; i++ ) {
+    if ( !vol_av_read_next_frame( &rgba ) || !vol_av_read_next_frame( &planes ) ) {
+      fprintf( stderr, "ERROR: could not decode frame %lli\n", (long long)i );
+      ok = false;
+      break;
+    }
+    if ( !_check_planes( &planes, i, false ) ) {
+      ok = false;
+      break;
+    }
+    if ( planes.w != rgba.w || planes.h != rgba.h || !rgba.pixels_ptr ) {
+      fprintf( stderr, "ERROR: frame %lli: planes are %ix%i but the RGBA image is %ix%i\n", (long long)i, planes.w, planes.h, rgba.w, rgba.h );
+      ok = false;
+      break;
+    }
+    if ( !vol_av_yuv420_to_rgba( planes.planes_ptrs, planes.plane_strides, planes.plane_layout, w, h, planes.full_range, planes.bt709, rgba_ptr, w * 4 ) ) {
+      fprintf( stderr, "ERROR: frame %lli: could not convert the planes to RGBA\n", (long long)i );
+      ok = false;
+      break;
+    }
+    int64_t n_differ = 0;
+    for ( size_t j = 0; j < (size_t)w * h * 4; j++ ) { n_differ += rgba_ptr[j] != rgba.pixels_ptr[j]; }
+    if ( n_differ > 0 ) {
+      fprintf( stderr, "ERROR: frame %lli: %lli bytes of the converted planes differ from the RGBA output\n", (long long)i, (long long)n_differ );
+      ok = false;
+      break;
+    }
+    layout = planes.plane_layout;
+    _pack_planes( &planes, &packed_ptr[i * frame_sz] );
+  }
+
+  // Cached: packed planes, with the same bytes, read back in reverse so that every frame comes from the cache.
+  for ( int64_t i = 0; ok && i < n_frames; i++ ) {
+    if ( !vol_av_cache_frame( &planes, i ) ) {
+      fprintf( stderr, "ERROR: could not cache frame %lli\n", (long long)i );
+      ok = false;
+    }
+  }
+  if ( ok && vol_av_cache_bytes_used( &planes ) != frame_sz * n_frames ) {
+    fprintf( stderr, "ERROR: the cache holds %lli bytes for %lli frames, expected %lli\n", (long long)vol_av_cache_bytes_used( &planes ), (long long)n_frames,
+      (long long)( frame_sz * n_frames ) );
+    ok = false;
+  }
+  for ( int64_t i = n_frames - 1; ok && i >= 0; i-- ) {
+    if ( !vol_av_read_frame( &planes, i ) ) {
+      fprintf( stderr, "ERROR: could not read cached frame %lli\n", (long long)i );
+      ok = false;
+      break;
+    }
+    if ( !_check_planes( &planes, i, true ) ) {
+      ok = false;
+      break;
+    }
+    if ( 0 != memcmp( planes.planes_ptrs[0], &packed_ptr[i * frame_sz], (size_t)frame_sz ) ) {
+      fprintf( stderr, "ERROR: cached frame %lli differs from the frame as decoded\n", (long long)i );
+      ok = false;
+      break;
+    }
+  }
+
+  if ( ok ) {
+    printf( "%lli frames of %ix%i %s planes match the RGBA output, and are cached in %lli bytes each\n", (long long)n_frames, w, h,
+      VOL_AV_PLANES_NV12 == layout ? "NV12" : "I420", (long long)frame_sz );
+  }
+  free( packed_ptr );
+  free( rgba_ptr );
+  vol_av_close( &rgba );
+  vol_av_close( &planes );
+  return ok ? 0 : 1;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc < 2 || argc > 3 || ( 3 == argc && atoi( argv[2] ) <= 0 ) ) {
+    fprintf( stderr, "Usage:\n  %s VIDEO.mp4 [FRAMES]\n", argv[0] );
+    return 1;
+  }
+  int64_t n_frames = 3 == argc ? atoi( argv[2] ) : 30;
+  return _check( argv[1], n_frames );
+}
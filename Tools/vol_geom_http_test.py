@@ -0,0 +1,122 @@
+"""Volograms HTTP Playback Test
+
+Copyright: 2026, Volograms (http://volograms.com/)
+Licence:   The MIT License. See LICENSE.md for details.
+
+Serves a vologram from a local HTTP server with range request support, and plays it over HTTP with `vol_geom_pack compare`, checking that every
+frame matches the local files, with streaming mode off and on. The server replies in each of these ways in turn:
+
+  length   - replies with Content-Length, keeping the connection alive.
+  chunked  - replies with Transfer-Encoding: chunked, in small chunks with chunk extensions and a trailer.
+  close    - closes the connection after every few replies, so the client has to reconnect.
+
+The number of requests each playback made is printed, to catch e.g. the frame headers being scanned with one request per frame.
+
+The vologram is also packed into a bundle, and the chunks of the bundle served over HTTP are read on several threads at once with
+`vol_geom_pack chunks`, checking that they match the local bundle, as a player reads a bundle's video and geometry on different threads.
+
+Usage (from this directory, after building vol_geom_pack):
+  python3 vol_geom_http_test.py ./vol_geom_pack HEADER.vols SEQUENCE.vols
+"""
+
+import http.server
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+
+
+class RangeHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    files = {}
+    mode = "length"
+    n_requests = 0
+
+    def log_message(self, format, *args):
+        pass
+
+    def do_GET(self):
+        RangeHandler.n_requests += 1
+        path = RangeHandler.files.get(os.path.basename(self.path), "")
+        if not os.path.isfile(path):
+            self.send_response(404)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+        with open(path, "rb") as f:
+            data = f.read()
+
+        match = re.match(r"bytes=(\d+)-(\d+)$", self.headers.get("Range", ""))
+        if match:
+            first, last = int(match.group(1)), min(int(match.group(2)), len(data) - 1)
+            body = data[first : last + 1]
+            self.send_response(206)
+            self.send_header("Content-Range", "bytes %d-%d/%d" % (first, last, len(data)))
+        else:
+            body = data
+            self.send_response(200)
+
+        if RangeHandler.mode == "close" and RangeHandler.n_requests % 3 == 0:
+            self.send_header("Connection", "close")
+            self.close_connection = True
+        if RangeHandler.mode == "chunked":
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            for i in range(0, len(body), 7777):
+                chunk = body[i : i + 7777]
+                self.wfile.write(b"%x;n=%d\r\n" % (len(chunk), i) + chunk + b"\r\n")
+            self.wfile.write(b"0\r\nX-Trailer: done\r\n\r\n")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__)
+        return 1
+    pack_path, hdr_path, seq_path = sys.argv[1:]
+    tmp_dir = tempfile.TemporaryDirectory()
+    bundle_path = os.path.join(tmp_dir.name, "http_test.volb")
+    result = subprocess.run([pack_path, "bundle", hdr_path, seq_path, bundle_path], capture_output=True, text=True)
+    if result.returncode != 0:
+        print("ERROR: could not make a bundle: %s" % (result.stdout + result.stderr).strip())
+        return 1
+    for path in (hdr_path, seq_path, bundle_path):
+        RangeHandler.files[os.path.basename(path)] = os.path.abspath(path)
+
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), RangeHandler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    url = "http://127.0.0.1:%d/" % server.server_address[1]
+
+    n_failed = 0
+    for mode in ("length", "chunked", "close"):
+        for streaming in (False, True):
+            RangeHandler.mode = mode
+            RangeHandler.n_requests = 0
+            args = [pack_path, "compare", hdr_path, seq_path, url + os.path.basename(hdr_path), url + os.path.basename(seq_path)]
+            if streaming:
+                args.append("--streaming")
+            result = subprocess.run(args, capture_output=True, text=True)
+            status = "ok" if result.returncode == 0 else "FAILED"
+            print("%-8s streaming %-5s %-6s %4d requests  %s" % (mode, streaming, status, RangeHandler.n_requests, (result.stdout + result.stderr).strip()))
+            if result.returncode != 0:
+                n_failed += 1
+        RangeHandler.mode = mode
+        RangeHandler.n_requests = 0
+        result = subprocess.run([pack_path, "chunks", bundle_path, url + os.path.basename(bundle_path)], capture_output=True, text=True)
+        status = "ok" if result.returncode == 0 else "FAILED"
+        print("%-8s bundle chunks    %-6s %4d requests  %s" % (mode, status, RangeHandler.n_requests, (result.stdout + result.stderr).strip()))
+        if result.returncode != 0:
+            n_failed += 1
+
+    server.shutdown()
+    tmp_dir.cleanup()
+    return 1 if n_failed > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,663 @@
+/** @file vol_geom_pack.c
+ * Volograms Geometry Packing Tool
+ *
+ * Version:   0.5 \n
+ * Copyright: 2026, Volograms (http://volograms.com/) \n
+ * Language:  C11 \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ *
+ * Command-line tool that re-encodes a vologram's sequence file with the compressed stream codecs in vol_geom,
+ * and benchmarks frame reads so compressed and raw sequences can be compared.
+ *
+ * With `--delta STEP`, the vertices of tracked frames are stored as differences from the previous frame, quantized to multiples of STEP
+ * (in the sequence's units, usually metres, so 0.0002 is 0.2 mm). This is lossy; the largest error is reported.
+ *
+ * With `--quantize`, positions are stored as 16-bit values over the bounds of the whole sequence, normals as 16-bit octahedral coordinates,
+ * and UVs as half floats. This is lossy; the largest errors are reported. Can be combined with `--delta`, which then applies to tracked frames.
+ *
+ * `bundle` writes the header, sequence, and video into a single file of 4 KiB-aligned chunks, read with `vol_geom_bundle_open()`.
+ * It adds the bounding box of every frame and of the whole sequence, so players can cull volograms before reading any frames.
+ * With `--compress`, the header and sequence chunks are compressed losslessly where that makes them smaller. A compressed sequence chunk is decoded
+ * into memory when the bundle is opened, so leave it off for volograms played in streaming mode, or compress the sequence with `pack` first.
+ *
+ * `compare` plays two copies of a vologram and checks that every frame's mesh data is the same, e.g. a local copy against one served over HTTP.
+ * vol_geom_http_test.py uses it to test the HTTP backend.
+ *
+ * `chunks` reads every chunk of two copies of a bundle, each chunk on its own thread at the same time, and checks that they match, e.g. to check that
+ * a bundle served over HTTP can be read from several threads, as a player reads its video and its geometry.
+ *
+ * Build (from this directory):
+ *   cc -std=gnu11 -O2 -I../Source/volograms/Private vol_geom_pack.c ../Source/volograms/Private/vol_geom.c -o vol_geom_pack -lpthread -lm
+ *
+ * Usage:
+ *   vol_geom_pack pack  IN_HEADER.vols IN_SEQUENCE.vols OUT_HEADER.vols OUT_SEQUENCE.vols [--delta STEP] [--quantize]
+ *   vol_geom_pack bundle IN_HEADER.vols IN_SEQUENCE.vols OUT_BUNDLE.volb [--video VIDEO.mp4] [--compress]
+ *   vol_geom_pack bench HEADER.vols SEQUENCE.vols [REPEATS] [--threads]
+ *   vol_geom_pack compare HEADER.vols SEQUENCE.vols OTHER_HEADER.vols OTHER_SEQUENCE.vols [--streaming]
+ *   vol_geom_pack chunks BUNDLE.volb OTHER_BUNDLE.volb
+ */
+
+#include "vol_geom.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+static void _logger( vol_geom_log_type_t log_type, const char* message_str ) {
+  if ( log_type == VOL_GEOM_LOG_TYPE_ERROR || log_type == VOL_GEOM_LOG_TYPE_WARNING ) { fprintf( stderr, "%s", message_str ); }
+}
+
+static double _time_s( void ) {
+  struct timespec ts;
+  timespec_get( &ts, TIME_UTC );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#ifndef _WIN32
+typedef struct thread_job_t {
+  void ( *job_fn )( void* job_ctx_ptr, int job_idx );
+  void* job_ctx_ptr;
+  int job_idx;
+} thread_job_t;
+
+static void* _thread_main( void* arg_ptr ) {
+  thread_job_t* job_ptr = (thread_job_t*)arg_ptr;
+  job_ptr->job_fn( job_ptr->job_ctx_ptr, job_ptr->job_idx );
+  return NULL;
+}
+
+/** Stand-in for an engine's job system: one thread per job. */
+static void _thread_parallel_for( int job_count, void ( *job_fn )( void* job_ctx_ptr, int job_idx ), void* job_ctx_ptr ) {
+  pthread_t threads[64];
+  thread_job_t jobs[64];
+  for ( int start = 0; start < job_count; start += 64 ) {
+    int n = job_count - start < 64 ? job_count - start : 64;
+    for ( int i = 0; i < n; i++ ) {
+      jobs[i] = ( thread_job_t ){ .job_fn = job_fn, .job_ctx_ptr = job_ctx_ptr, .job_idx = start + i };
+      if ( 0 != pthread_create( &threads[i], NULL, _thread_main, &jobs[i] ) ) { _thread_main( &jobs[i] ); threads[i] = 0; }
+    }
+    for ( int i = 0; i < n; i++ ) {
+      if ( threads[i] ) { pthread_join( threads[i], NULL ); }
+    }
+  }
+}
+#endif
+
+static void _write_short_str( FILE* f_ptr, const vol_geom_short_str_t* sstr ) {
+  fwrite( &sstr->sz, 1, 1, f_ptr );
+  fwrite( sstr->bytes, 1, sstr->sz, f_ptr );
+}
+
+/** Writes a version 12 header. Earlier versions are upgraded, with an identity transform. */
+static bool _write_hdr( const char* filename, const vol_geom_file_hdr_t* in_hdr_ptr, int32_t compression ) {
+  FILE* f_ptr = fopen( filename, "wb" );
+  if ( !f_ptr ) { return false; }
+  vol_geom_file_hdr_t hdr = *in_hdr_ptr;
+  if ( hdr.version < 12 ) {
+    memset( hdr.translation, 0, sizeof( hdr.translation ) );
+    hdr.rotation[0] = 1.0f;
+    hdr.rotation[1] = hdr.rotation[2] = hdr.rotation[3] = 0.0f;
+    hdr.scale                                           = 1.0f;
+  }
+  if ( hdr.version < 11 ) { hdr.normals = hdr.textured = false; }
+  hdr.version = 12;
+  uint8_t normals = hdr.normals, textured = hdr.textured;
+
+  _write_short_str( f_ptr, &hdr.format );
+  fwrite( &hdr.version, sizeof( int32_t ), 1, f_ptr );
+  fwrite( &compression, sizeof( int32_t ), 1, f_ptr );
+  _write_short_str( f_ptr, &hdr.mesh_name );
+  _write_short_str( f_ptr, &hdr.material );
+  _write_short_str( f_ptr, &hdr.shader );
+  fwrite( &hdr.topology, sizeof( int32_t ), 1, f_ptr );
+  fwrite( &hdr.frame_count, sizeof( int32_t ), 1, f_ptr );
+  fwrite( &normals, 1, 1, f_ptr );
+  fwrite( &textured, 1, 1, f_ptr );
+  fwrite( &hdr.texture_width, sizeof( uint16_t ), 1, f_ptr );
+  fwrite( &hdr.texture_height, sizeof( uint16_t ), 1, f_ptr );
+  fwrite( &hdr.texture_format, sizeof( uint16_t ), 1, f_ptr );
+  fwrite( hdr.translation, sizeof( float ), 3, f_ptr );
+  fwrite( hdr.rotation, sizeof( float ), 4, f_ptr );
+  fwrite( &hdr.scale, sizeof( float ), 1, f_ptr );
+  bool ok = !ferror( f_ptr );
+  fclose( f_ptr );
+  return ok;
+}
+
+/** Encodes one array, appending its int32 stored size and stream to `out_ptr` at `*out_sz_ptr`. */
+static bool _append_stream(
+  int codec, int word_sz, int channels, const uint8_t* src_ptr, int32_t src_sz, uint8_t* out_ptr, vol_geom_size_t out_max_sz, vol_geom_size_t* out_sz_ptr ) {
+  if ( *out_sz_ptr + (vol_geom_size_t)sizeof( int32_t ) > out_max_sz ) { return false; }
+  vol_geom_size_t stored_sz = vol_geom_encode_stream(
+    codec, word_sz, channels, src_ptr, src_sz, &out_ptr[*out_sz_ptr + sizeof( int32_t )], out_max_sz - *out_sz_ptr - (vol_geom_size_t)sizeof( int32_t ) );
+  if ( stored_sz < 0 ) {
+    // Fall back to storing the array as-is, e.g. when its size is not a whole number of words.
+    stored_sz = vol_geom_encode_stream(
+      VOL_GEOM_STREAM_CODEC_RAW, 1, 1, src_ptr, src_sz, &out_ptr[*out_sz_ptr + sizeof( int32_t )], out_max_sz - *out_sz_ptr - (vol_geom_size_t)sizeof( int32_t ) );
+    if ( stored_sz < 0 ) { return false; }
+  }
+  int32_t stored_sz_i32 = (int32_t)stored_sz;
+  memcpy( &out_ptr[*out_sz_ptr], &stored_sz_i32, sizeof( int32_t ) );
+  *out_sz_ptr += (vol_geom_size_t)sizeof( int32_t ) + stored_sz;
+  return true;
+}
+
+/** Quantizes one float array, appending its int32 stored size and stream to `out_ptr` at `*out_sz_ptr`. Updates `*max_error_ptr`. */
+static bool _append_quantized( int codec, int channels, const float* bounds_ptr, const float* src_ptr, int32_t src_sz, float* decoded_ptr, uint8_t* out_ptr,
+  vol_geom_size_t out_max_sz, vol_geom_size_t* out_sz_ptr, float* max_error_ptr ) {
+  if ( *out_sz_ptr + (vol_geom_size_t)sizeof( int32_t ) > out_max_sz ) { return false; }
+  float error               = 0.0f;
+  vol_geom_size_t stored_sz = vol_geom_encode_quantized_stream( codec, src_ptr, src_sz, channels, bounds_ptr, decoded_ptr,
+    &out_ptr[*out_sz_ptr + sizeof( int32_t )], out_max_sz - *out_sz_ptr - (vol_geom_size_t)sizeof( int32_t ), &error );
+  if ( stored_sz < 0 ) { return false; }
+  int32_t stored_sz_i32 = (int32_t)stored_sz;
+  memcpy( &out_ptr[*out_sz_ptr], &stored_sz_i32, sizeof( int32_t ) );
+  *out_sz_ptr += (vol_geom_size_t)sizeof( int32_t ) + stored_sz;
+  if ( error > *max_error_ptr ) { *max_error_ptr = error; }
+  return true;
+}
+
+/** Finds the bounds of every vertex position in the sequence: minimum x, y, z then maximum x, y, z. */
+static bool _sequence_bounds( const char* in_seq, const vol_geom_info_t* info_ptr, float* bounds_ptr ) {
+  for ( int c = 0; c < 3; c++ ) {
+    bounds_ptr[c]     = INFINITY;
+    bounds_ptr[3 + c] = -INFINITY;
+  }
+  for ( int i = 0; i < info_ptr->hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t fd = { 0 };
+    if ( !vol_geom_read_frame( in_seq, info_ptr, i, &fd ) ) { return false; }
+    int n_vertices = (int)( fd.vertices_sz / ( 3 * sizeof( float ) ) );
+    if ( 0 == n_vertices ) { continue; }
+    float frame_bounds[6];
+    vol_geom_compute_aabb( (const float*)&fd.block_data_ptr[fd.vertices_offset], n_vertices, frame_bounds );
+    for ( int c = 0; c < 3; c++ ) {
+      if ( frame_bounds[c] < bounds_ptr[c] ) { bounds_ptr[c] = frame_bounds[c]; }
+      if ( frame_bounds[3 + c] > bounds_ptr[3 + c] ) { bounds_ptr[3 + c] = frame_bounds[3 + c]; }
+    }
+  }
+  for ( int c = 0; c < 3; c++ ) {
+    if ( bounds_ptr[c] > bounds_ptr[3 + c] ) { bounds_ptr[c] = bounds_ptr[3 + c] = 0.0f; } // No vertices.
+  }
+  return true;
+}
+
+/** Largest angle, in degrees, between original and decoded normals. */
+static float _max_normal_angle( const float* original_ptr, const float* decoded_ptr, int n_normals ) {
+  float max_angle = 0.0f;
+  for ( int i = 0; i < n_normals; i++ ) {
+    const float* a = &original_ptr[i * 3];
+    const float* b = &decoded_ptr[i * 3];
+    float len      = sqrtf( a[0] * a[0] + a[1] * a[1] + a[2] * a[2] );
+    if ( len <= 0.0f ) { continue; }
+    float d = ( a[0] * b[0] + a[1] * b[1] + a[2] * b[2] ) / len;
+    // acos() is inaccurate near 1, so use the length of the cross product as well.
+    float cx    = a[1] * b[2] - a[2] * b[1], cy = a[2] * b[0] - a[0] * b[2], cz = a[0] * b[1] - a[1] * b[0];
+    float angle = atan2f( sqrtf( cx * cx + cy * cy + cz * cz ) / len, d ) * 57.2957795f;
+    if ( angle > max_angle ) { max_angle = angle; }
+  }
+  return max_angle;
+}
+
+static int _pack( const char* in_hdr, const char* in_seq, const char* out_hdr, const char* out_seq, float delta_step, bool quantize ) {
+  vol_geom_info_t info = { 0 };
+  if ( !vol_geom_create_file_info( in_hdr, in_seq, &info, true ) ) {
+    fprintf( stderr, "ERROR: could not open vologram `%s` `%s`\n", in_hdr, in_seq );
+    return 1;
+  }
+  if ( info.hdr.compression == VOL_GEOM_COMPRESSION_STREAMS ) {
+    fprintf( stderr, "ERROR: sequence is already compressed\n" );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+  // Found before any output is opened, so failing here leaves nothing to clean up.
+  float bounds[6] = { 0.0f };
+  if ( quantize && !_sequence_bounds( in_seq, &info, bounds ) ) {
+    fprintf( stderr, "ERROR: could not read frames to find sequence bounds\n" );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+  if ( !_write_hdr( out_hdr, &info.hdr, VOL_GEOM_COMPRESSION_STREAMS ) ) {
+    fprintf( stderr, "ERROR: could not write `%s`\n", out_hdr );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+  FILE* f_ptr = fopen( out_seq, "wb" );
+  if ( !f_ptr ) {
+    fprintf( stderr, "ERROR: could not write `%s`\n", out_seq );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+
+  vol_geom_size_t out_max_sz = vol_geom_encode_stream_bound( info.biggest_frame_blob_sz, 1 ) * 2;
+  uint8_t* out_ptr           = malloc( (size_t)out_max_sz );
+  // Vertices of the previous frame as a player will decode them, for --delta.
+  float* reference_ptr         = malloc( (size_t)info.biggest_frame_blob_sz );
+  float* aligned_ptr           = malloc( (size_t)info.biggest_frame_blob_sz );
+  float* decoded_ptr           = malloc( (size_t)info.biggest_frame_blob_sz );
+  vol_geom_size_t reference_sz = 0;
+  float max_error              = 0.0f;
+  float max_position_error = 0.0f, max_normal_error = 0.0f, max_normal_angle = 0.0f, max_uv_error = 0.0f;
+  int64_t raw_total = 0, packed_total = 0;
+  int ret = 0;
+  for ( int i = 0; i < info.hdr.frame_count && out_ptr && reference_ptr && aligned_ptr && decoded_ptr; i++ ) {
+    vol_geom_frame_data_t fd = { 0 };
+    if ( !vol_geom_read_frame( in_seq, &info, i, &fd ) ) {
+      ret = 1;
+      break;
+    }
+    const uint8_t* b        = fd.block_data_ptr;
+    vol_geom_size_t out_sz  = 0;
+    int n_vertices          = fd.vertices_sz / (int)( sizeof( float ) * 3 );
+    uint8_t keyframe        = info.frame_headers_ptr[i].keyframe;
+    bool has_normals        = info.hdr.normals && info.hdr.version >= 11;
+    bool has_topology       = 1 == keyframe || ( info.hdr.version >= 12 && 2 == keyframe );
+    bool has_texture        = info.hdr.version >= 11 && info.hdr.textured;
+    bool ok                 = true;
+    if ( delta_step > 0.0f && 0 == keyframe && reference_sz == fd.vertices_sz && fd.vertices_sz > 0 ) {
+      float frame_error = 0.0f;
+      memcpy( aligned_ptr, &b[fd.vertices_offset], (size_t)fd.vertices_sz ); // Frame data is not 4-byte aligned within the file.
+      vol_geom_size_t stored_sz = vol_geom_encode_delta_stream( reference_ptr, aligned_ptr, fd.vertices_sz, 3, delta_step,
+        &out_ptr[out_sz + sizeof( int32_t )], out_max_sz - out_sz - (vol_geom_size_t)sizeof( int32_t ), &frame_error );
+      if ( stored_sz < 0 ) {
+        ok = false;
+      } else {
+        int32_t stored_sz_i32 = (int32_t)stored_sz;
+        memcpy( &out_ptr[out_sz], &stored_sz_i32, sizeof( int32_t ) );
+        out_sz += (vol_geom_size_t)sizeof( int32_t ) + stored_sz;
+        if ( frame_error > max_error ) { max_error = frame_error; }
+      }
+    } else if ( quantize && fd.vertices_sz > 0 ) {
+      // Start a new chain of predictions from the keyframe as a player will decode it.
+      memcpy( aligned_ptr, &b[fd.vertices_offset], (size_t)fd.vertices_sz );
+      ok = _append_quantized( VOL_GEOM_STREAM_CODEC_UNORM16, 3, bounds, aligned_ptr, fd.vertices_sz, reference_ptr, out_ptr, out_max_sz, &out_sz,
+        &max_position_error );
+      reference_sz = fd.vertices_sz;
+    } else {
+      // Keyframes are stored losslessly, and start a new chain of predictions.
+      ok = ok && _append_stream( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE, 4, 3, &b[fd.vertices_offset], fd.vertices_sz, out_ptr, out_max_sz, &out_sz );
+      if ( reference_ptr ) { memcpy( reference_ptr, &b[fd.vertices_offset], (size_t)fd.vertices_sz ); }
+      reference_sz = fd.vertices_sz;
+    }
+    if ( has_normals && quantize && fd.normals_sz > 0 ) {
+      memcpy( aligned_ptr, &b[fd.normals_offset], (size_t)fd.normals_sz );
+      ok = ok && _append_quantized( VOL_GEOM_STREAM_CODEC_OCT16, 3, NULL, aligned_ptr, fd.normals_sz, decoded_ptr, out_ptr, out_max_sz, &out_sz, &max_normal_error );
+      float angle = ok ? _max_normal_angle( aligned_ptr, decoded_ptr, fd.normals_sz / (int)( sizeof( float ) * 3 ) ) : 0.0f;
+      if ( angle > max_normal_angle ) { max_normal_angle = angle; }
+    } else if ( has_normals ) {
+      ok = ok && _append_stream( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE, 4, 3, &b[fd.normals_offset], fd.normals_sz, out_ptr, out_max_sz, &out_sz );
+    }
+    if ( has_topology ) {
+      int index_sz = n_vertices >= 65535 ? 4 : 2; // Same rule the players use to pick the index type.
+      ok = ok && _append_stream( VOL_GEOM_STREAM_CODEC_INDEX_DELTA, index_sz, 1, &b[fd.indices_offset], fd.indices_sz, out_ptr, out_max_sz, &out_sz );
+      if ( quantize && fd.uvs_sz > 0 ) {
+        memcpy( aligned_ptr, &b[fd.uvs_offset], (size_t)fd.uvs_sz );
+        ok = ok && _append_quantized( VOL_GEOM_STREAM_CODEC_HALF, 2, NULL, aligned_ptr, fd.uvs_sz, NULL, out_ptr, out_max_sz, &out_sz, &max_uv_error );
+      } else {
+        ok = ok && _append_stream( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE, 4, 2, &b[fd.uvs_offset], fd.uvs_sz, out_ptr, out_max_sz, &out_sz );
+      }
+    }
+    if ( has_texture ) { ok = ok && _append_stream( VOL_GEOM_STREAM_CODEC_RAW, 1, 1, &b[fd.texture_offset], fd.texture_sz, out_ptr, out_max_sz, &out_sz ); }
+    if ( !ok ) {
+      fprintf( stderr, "ERROR: could not encode frame %i\n", i );
+      ret = 1;
+      break;
+    }
+    // Frame header and trailing size, using version 12 rules: mesh_data_sz includes the size of each array.
+    int32_t frame_number = i, mesh_data_sz = (int32_t)out_sz;
+    fwrite( &frame_number, sizeof( int32_t ), 1, f_ptr );
+    fwrite( &mesh_data_sz, sizeof( int32_t ), 1, f_ptr );
+    fwrite( &keyframe, sizeof( uint8_t ), 1, f_ptr );
+    fwrite( out_ptr, 1, (size_t)out_sz, f_ptr );
+    fwrite( &mesh_data_sz, sizeof( int32_t ), 1, f_ptr );
+    raw_total += info.frames_directory_ptr[i].corrected_payload_sz;
+    packed_total += out_sz;
+  }
+  if ( !out_ptr || !reference_ptr || !aligned_ptr || !decoded_ptr || ferror( f_ptr ) ) { ret = 1; }
+  fclose( f_ptr );
+  free( out_ptr );
+  free( reference_ptr );
+  free( aligned_ptr );
+  free( decoded_ptr );
+  if ( 0 == ret ) {
+    printf( "packed %i frames: %" PRId64 " -> %" PRId64 " bytes of mesh data (%.2fx)\n", info.hdr.frame_count, raw_total, packed_total,
+      packed_total > 0 ? (double)raw_total / (double)packed_total : 0.0 );
+    if ( delta_step > 0.0f ) { printf( "largest vertex error from --delta %g: %g\n", delta_step, max_error ); }
+    if ( quantize ) {
+      // The bound documented for VOL_GEOM_STREAM_CODEC_UNORM16: half a step, plus float rounding when decoding.
+      double position_bound = 0.0;
+      for ( int c = 0; c < 3; c++ ) {
+        double b = ( (double)bounds[3 + c] - bounds[c] ) / 131070.0 + fmax( fabs( bounds[c] ), fabs( bounds[3 + c] ) ) / 2097152.0;
+        if ( b > position_bound ) { position_bound = b; }
+      }
+      printf( "sequence bounds (%g %g %g) to (%g %g %g)\n", bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5] );
+      printf( "largest errors from --quantize: position %g (bound %g), normal component %g (%g degrees), UV %g\n", max_position_error,
+        position_bound, max_normal_error, max_normal_angle, max_uv_error );
+    }
+  }
+  vol_geom_free_file_info( &info );
+  return ret;
+}
+
+/** Reads a whole file into memory with vol_geom's positional-read backend, which handles files over 2GB on every platform.
+ * @return The file's contents, to free, or NULL on error.
+ */
+static uint8_t* _read_file( const char* filename, int64_t* sz_ptr ) {
+  vol_geom_io_t io = vol_geom_io_pread();
+  void* file_ptr   = io.open_fn( filename, io.user_ptr );
+  if ( !file_ptr ) { return NULL; }
+  int64_t sz       = io.size_fn( file_ptr, io.user_ptr );
+  uint8_t* buf_ptr = sz >= 0 ? malloc( (size_t)( sz > 0 ? sz : 1 ) ) : NULL;
+  if ( buf_ptr && !io.read_at_fn( file_ptr, 0, sz, buf_ptr, io.user_ptr ) ) {
+    free( buf_ptr );
+    buf_ptr = NULL;
+  }
+  io.close_fn( file_ptr, io.user_ptr );
+  *sz_ptr = sz;
+  return buf_ptr;
+}
+
+/** Builds the contents of a VOL_GEOM_BUNDLE_CHUNK_BOUNDS chunk: the sequence's bounds, then each frame's.
+ * @return The chunk, to free, or NULL on error.
+ */
+static uint8_t* _bounds_chunk( const char* in_hdr, const char* in_seq, int64_t* sz_ptr ) {
+  vol_geom_info_t info = { 0 };
+  if ( !vol_geom_create_file_info( in_hdr, in_seq, &info, true ) ) { return NULL; }
+  int n_frames      = info.hdr.frame_count;
+  float* bounds_ptr = malloc( (size_t)( n_frames + 1 ) * 6 * sizeof( float ) );
+  float* seq_ptr    = bounds_ptr;
+  bool ok           = NULL != bounds_ptr;
+  for ( int i = 0; ok && i < n_frames; i++ ) {
+    vol_geom_frame_data_t fd = { 0 };
+    ok                       = vol_geom_read_frame( in_seq, &info, i, &fd );
+    if ( !ok ) { break; }
+    float* frame_ptr = &bounds_ptr[( i + 1 ) * 6];
+    vol_geom_compute_aabb( (const float*)&fd.block_data_ptr[fd.vertices_offset], (int)( fd.vertices_sz / ( 3 * sizeof( float ) ) ), frame_ptr );
+    for ( int c = 0; c < 3; c++ ) {
+      seq_ptr[c]     = 0 == i || frame_ptr[c] < seq_ptr[c] ? frame_ptr[c] : seq_ptr[c];
+      seq_ptr[3 + c] = 0 == i || frame_ptr[3 + c] > seq_ptr[3 + c] ? frame_ptr[3 + c] : seq_ptr[3 + c];
+    }
+  }
+  if ( ok && 0 == n_frames ) { memset( seq_ptr, 0, 6 * sizeof( float ) ); }
+  vol_geom_free_file_info( &info );
+  if ( !ok ) {
+    free( bounds_ptr );
+    return NULL;
+  }
+  *sz_ptr = (int64_t)( n_frames + 1 ) * 6 * (int64_t)sizeof( float );
+  return (uint8_t*)bounds_ptr;
+}
+
+/** Writes zeros up to the next multiple of VOL_GEOM_BUNDLE_ALIGNMENT. */
+static void _write_padding( FILE* f_ptr, int64_t* offset_ptr ) {
+  static const uint8_t zeros[VOL_GEOM_BUNDLE_ALIGNMENT] = { 0 };
+  int64_t pad_sz                                        = ( VOL_GEOM_BUNDLE_ALIGNMENT - *offset_ptr % VOL_GEOM_BUNDLE_ALIGNMENT ) % VOL_GEOM_BUNDLE_ALIGNMENT;
+  fwrite( zeros, 1, (size_t)pad_sz, f_ptr );
+  *offset_ptr += pad_sz;
+}
+
+/** Writes the header, sequence, optionally the video, and the frames' bounds, into one bundle file. With `compress`, the header and sequence chunks
+ * are stored as VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE streams where that makes them smaller. The video is always stored, so it can be read a piece at a time.
+ */
+static int _bundle( const char* in_hdr, const char* in_seq, const char* in_video, const char* out_bundle, bool compress ) {
+  // The bounds chunk has no file: NULL path. It goes last, after the optional video.
+  const char* in_paths[4] = { in_hdr, in_seq, in_video, NULL };
+  const char* ids[4]      = { VOL_GEOM_BUNDLE_CHUNK_HEADER, VOL_GEOM_BUNDLE_CHUNK_SEQUENCE, VOL_GEOM_BUNDLE_CHUNK_VIDEO, VOL_GEOM_BUNDLE_CHUNK_BOUNDS };
+  if ( !in_video ) {
+    in_paths[2] = in_paths[3];
+    ids[2]      = ids[3];
+  }
+  int n_chunks = in_video ? 4 : 3;
+
+  // Check the vologram opens before bundling it.
+  vol_geom_info_t info = { 0 };
+  if ( !vol_geom_create_file_info( in_hdr, in_seq, &info, true ) ) {
+    fprintf( stderr, "ERROR: could not open vologram `%s` `%s`\n", in_hdr, in_seq );
+    return 1;
+  }
+  vol_geom_free_file_info( &info );
+
+  FILE* f_ptr = fopen( out_bundle, "wb" );
+  if ( !f_ptr ) {
+    fprintf( stderr, "ERROR: could not write `%s`\n", out_bundle );
+    return 1;
+  }
+  vol_geom_bundle_hdr_t bundle_hdr = ( vol_geom_bundle_hdr_t ){ .version = VOL_GEOM_BUNDLE_VERSION, .chunk_count = (uint32_t)n_chunks };
+  vol_geom_bundle_chunk_t chunks[4];
+  memset( chunks, 0, sizeof( chunks ) );
+  memcpy( bundle_hdr.magic, VOL_GEOM_BUNDLE_MAGIC, 4 );
+  fwrite( &bundle_hdr, sizeof( vol_geom_bundle_hdr_t ), 1, f_ptr );
+  fwrite( chunks, sizeof( vol_geom_bundle_chunk_t ), n_chunks, f_ptr ); // Filled in once the chunks are written.
+  int64_t offset = (int64_t)( sizeof( vol_geom_bundle_hdr_t ) + n_chunks * sizeof( vol_geom_bundle_chunk_t ) );
+
+  for ( int c = 0; c < n_chunks; c++ ) {
+    int64_t raw_sz   = 0;
+    uint8_t* raw_ptr = in_paths[c] ? _read_file( in_paths[c], &raw_sz ) : _bounds_chunk( in_hdr, in_seq, &raw_sz );
+    if ( !raw_ptr ) {
+      fprintf( stderr, "ERROR: could not read `%s`\n", in_paths[c] ? in_paths[c] : in_seq );
+      fclose( f_ptr );
+      return 1;
+    }
+    memcpy( chunks[c].id, ids[c], 4 );
+    chunks[c].codec        = VOL_GEOM_BUNDLE_CODEC_STORED;
+    chunks[c].raw_sz       = (uint64_t)raw_sz;
+    chunks[c].stored_sz    = (uint64_t)raw_sz;
+    const uint8_t* out_ptr = raw_ptr;
+    uint8_t* packed_ptr    = NULL;
+    if ( compress && c < 2 && raw_sz <= UINT32_MAX ) {
+      // Most of a vologram is 4-byte floats and indices.
+      int word_sz                = raw_sz % 4 == 0 ? 4 : 1;
+      vol_geom_size_t packed_max = vol_geom_encode_stream_bound( raw_sz, word_sz );
+      packed_ptr                 = malloc( (size_t)packed_max );
+      vol_geom_size_t packed_sz  = packed_ptr ? vol_geom_encode_stream( VOL_GEOM_STREAM_CODEC_SHUFFLE_RLE, word_sz, 1, raw_ptr, raw_sz, packed_ptr, packed_max ) : -1;
+      if ( packed_sz > 0 && packed_sz < raw_sz ) {
+        chunks[c].codec     = VOL_GEOM_BUNDLE_CODEC_STREAM;
+        chunks[c].stored_sz = (uint64_t)packed_sz;
+        out_ptr             = packed_ptr;
+      }
+    }
+    _write_padding( f_ptr, &offset );
+    chunks[c].offset = (uint64_t)offset;
+    if ( chunks[c].stored_sz > 0 ) { fwrite( out_ptr, (size_t)chunks[c].stored_sz, 1, f_ptr ); }
+    offset += (int64_t)chunks[c].stored_sz;
+    printf( "%.4s: %" PRId64 " bytes stored as %" PRIu64 " bytes at offset %" PRIu64 "%s\n", ids[c], raw_sz, chunks[c].stored_sz, chunks[c].offset,
+      chunks[c].codec == VOL_GEOM_BUNDLE_CODEC_STREAM ? " (compressed)" : "" );
+    if ( 1 == c && chunks[c].codec == VOL_GEOM_BUNDLE_CODEC_STREAM ) {
+      printf( "NOTE: the compressed sequence is decoded into memory when the bundle is opened, so streaming mode won't save memory with it\n" );
+    }
+    free( packed_ptr );
+    free( raw_ptr );
+  }
+
+  fseek( f_ptr, (long)sizeof( vol_geom_bundle_hdr_t ), SEEK_SET );
+  fwrite( chunks, sizeof( vol_geom_bundle_chunk_t ), n_chunks, f_ptr );
+  bool ok = !ferror( f_ptr );
+  if ( 0 != fclose( f_ptr ) ) { ok = false; }
+  if ( !ok ) {
+    fprintf( stderr, "ERROR: could not write `%s`\n", out_bundle );
+    return 1;
+  }
+
+  // Check the bundle reads back.
+  vol_geom_bundle_t* bundle_ptr = vol_geom_bundle_open( out_bundle, NULL );
+  bool valid                    = bundle_ptr && vol_geom_create_file_info_bundle( bundle_ptr, &info, true );
+  if ( valid ) { vol_geom_free_file_info( &info ); }
+  vol_geom_bundle_close( bundle_ptr );
+  if ( !valid ) {
+    fprintf( stderr, "ERROR: bundle `%s` did not read back\n", out_bundle );
+    return 1;
+  }
+  return 0;
+}
+
+static int _bench( const char* hdr, const char* seq, int repeats ) {
+  vol_geom_info_t info = { 0 };
+  if ( !vol_geom_create_file_info( hdr, seq, &info, true ) ) {
+    fprintf( stderr, "ERROR: could not open vologram `%s` `%s`\n", hdr, seq );
+    return 1;
+  }
+  int64_t stored_bytes = 0, decoded_bytes = 0;
+  double start_s = _time_s();
+  for ( int r = 0; r < repeats; r++ ) {
+    for ( int i = 0; i < info.hdr.frame_count; i++ ) {
+      vol_geom_frame_data_t fd = { 0 };
+      if ( !vol_geom_read_frame( seq, &info, i, &fd ) ) {
+        vol_geom_free_file_info( &info );
+        return 1;
+      }
+      stored_bytes += info.frames_directory_ptr[i].total_sz;
+      decoded_bytes += fd.block_data_sz;
+    }
+  }
+  double elapsed_s = _time_s() - start_s;
+  int n_frames     = info.hdr.frame_count * repeats;
+  printf( "%s: %i frames in %.3f s (%.1f frames/s). read %.1f MB/s from file, produced %.1f MB/s of mesh data\n",
+    info.hdr.compression == VOL_GEOM_COMPRESSION_STREAMS ? "compressed" : "raw", n_frames, elapsed_s, n_frames / elapsed_s,
+    stored_bytes / elapsed_s / ( 1024.0 * 1024.0 ), decoded_bytes / elapsed_s / ( 1024.0 * 1024.0 ) );
+  vol_geom_free_file_info( &info );
+  return 0;
+}
+
+static int _compare( const char* hdr, const char* seq, const char* other_hdr, const char* other_seq, bool streaming ) {
+  vol_geom_info_t info = { 0 }, other_info = { 0 };
+  if ( !vol_geom_create_file_info( hdr, seq, &info, streaming ) ) {
+    fprintf( stderr, "ERROR: could not open vologram `%s` `%s`\n", hdr, seq );
+    return 1;
+  }
+  if ( !vol_geom_create_file_info( other_hdr, other_seq, &other_info, streaming ) ) {
+    fprintf( stderr, "ERROR: could not open vologram `%s` `%s`\n", other_hdr, other_seq );
+    vol_geom_free_file_info( &info );
+    return 1;
+  }
+  int n_differ = 0;
+  if ( info.hdr.frame_count != other_info.hdr.frame_count ) {
+    fprintf( stderr, "ERROR: %i frames vs %i frames\n", info.hdr.frame_count, other_info.hdr.frame_count );
+    n_differ++;
+  }
+  for ( int i = 0; i < info.hdr.frame_count && 0 == n_differ; i++ ) {
+    vol_geom_frame_data_t fd = { 0 }, other_fd = { 0 };
+    if ( !vol_geom_read_frame( seq, &info, i, &fd ) || !vol_geom_read_frame( other_seq, &other_info, i, &other_fd ) ) {
+      fprintf( stderr, "ERROR: could not read frame %i\n", i );
+      n_differ++;
+    } else if ( fd.block_data_sz != other_fd.block_data_sz || 0 != memcmp( fd.block_data_ptr, other_fd.block_data_ptr, (size_t)fd.block_data_sz ) ) {
+      fprintf( stderr, "ERROR: frame %i differs\n", i );
+      n_differ++;
+    }
+  }
+  if ( 0 == n_differ ) { printf( "%i frames match%s\n", info.hdr.frame_count, streaming ? " (streaming)" : "" ); }
+  vol_geom_free_file_info( &info );
+  vol_geom_free_file_info( &other_info );
+  return n_differ > 0 ? 1 : 0;
+}
+
+#ifndef _WIN32
+static const char* _chunk_ids[] = { VOL_GEOM_BUNDLE_CHUNK_HEADER, VOL_GEOM_BUNDLE_CHUNK_SEQUENCE, VOL_GEOM_BUNDLE_CHUNK_VIDEO, VOL_GEOM_BUNDLE_CHUNK_BOUNDS };
+#define N_CHUNK_IDS ( (int)( sizeof( _chunk_ids ) / sizeof( _chunk_ids[0] ) ) )
+
+typedef struct chunks_job_t {
+  vol_geom_bundle_t *bundle_ptr, *other_ptr;
+  /// Set by a job if its chunk is in only one bundle, differs, or can't be read.
+  bool failed[N_CHUNK_IDS];
+} chunks_job_t;
+
+/** Reads chunk _chunk_ids[job_idx] of both bundles in slices of varied sizes, so that reads from the other threads fall between them. */
+static void _compare_chunk( void* job_ctx_ptr, int job_idx ) {
+  chunks_job_t* job_ptr                          = (chunks_job_t*)job_ctx_ptr;
+  const vol_geom_bundle_chunk_t* chunk_ptr       = vol_geom_bundle_find_chunk( job_ptr->bundle_ptr, _chunk_ids[job_idx] );
+  const vol_geom_bundle_chunk_t* other_chunk_ptr = vol_geom_bundle_find_chunk( job_ptr->other_ptr, _chunk_ids[job_idx] );
+  if ( !chunk_ptr && !other_chunk_ptr ) { return; }
+  uint8_t *a_ptr = malloc( 65536 ), *b_ptr = malloc( 65536 );
+  bool ok        = a_ptr && b_ptr && chunk_ptr && other_chunk_ptr && other_chunk_ptr->raw_sz == chunk_ptr->raw_sz;
+  for ( int64_t offset = 0, slice_sz = 0; ok && offset < (int64_t)chunk_ptr->raw_sz; offset += slice_sz ) {
+    slice_sz = 1 + ( offset * 7919 + job_idx * 104729 ) % 65536;
+    if ( slice_sz > (int64_t)chunk_ptr->raw_sz - offset ) { slice_sz = (int64_t)chunk_ptr->raw_sz - offset; }
+    ok = vol_geom_bundle_read_chunk_at( job_ptr->bundle_ptr, chunk_ptr, offset, slice_sz, a_ptr ) &&
+         vol_geom_bundle_read_chunk_at( job_ptr->other_ptr, other_chunk_ptr, offset, slice_sz, b_ptr ) && 0 == memcmp( a_ptr, b_ptr, (size_t)slice_sz );
+  }
+  free( a_ptr );
+  free( b_ptr );
+  job_ptr->failed[job_idx] = !ok;
+}
+
+static int _compare_chunks( const char* bundle, const char* other_bundle ) {
+  chunks_job_t job = { .bundle_ptr = vol_geom_bundle_open( bundle, NULL ), .other_ptr = vol_geom_bundle_open( other_bundle, NULL ) };
+  int n_failed     = 0, n_chunks = 0;
+  if ( !job.bundle_ptr || !job.other_ptr ) {
+    fprintf( stderr, "ERROR: could not open bundles `%s` `%s`\n", bundle, other_bundle );
+    n_failed++;
+  } else {
+    // One thread per chunk, all reading the two bundles at once, as a player's video and geometry do.
+    _thread_parallel_for( N_CHUNK_IDS, _compare_chunk, &job );
+    for ( int i = 0; i < N_CHUNK_IDS; i++ ) {
+      if ( vol_geom_bundle_find_chunk( job.bundle_ptr, _chunk_ids[i] ) ) { n_chunks++; }
+      if ( !job.failed[i] ) { continue; }
+      fprintf( stderr, "ERROR: chunk %s differs\n", _chunk_ids[i] );
+      n_failed++;
+    }
+  }
+  if ( 0 == n_failed ) { printf( "%i chunks match, read on separate threads at once\n", n_chunks ); }
+  vol_geom_bundle_close( job.bundle_ptr );
+  vol_geom_bundle_close( job.other_ptr );
+  return n_failed > 0 ? 1 : 0;
+}
+#endif
+
+int main( int argc, char** argv ) {
+  vol_geom_set_log_callback( _logger );
+  if ( argc >= 6 && 0 == strcmp( argv[1], "pack" ) ) {
+    float delta_step = 0.0f;
+    bool quantize    = false;
+    for ( int i = 6; i < argc; i++ ) {
+      if ( 0 == strcmp( argv[i], "--delta" ) && i + 1 < argc ) {
+        delta_step = (float)atof( argv[++i] );
+      } else if ( 0 == strcmp( argv[i], "--quantize" ) ) {
+        quantize = true;
+      }
+    }
+    return _pack( argv[2], argv[3], argv[4], argv[5], delta_step, quantize );
+  }
+  if ( argc >= 5 && 0 == strcmp( argv[1], "bundle" ) ) {
+    const char* video = NULL;
+    bool compress     = false;
+    for ( int i = 5; i < argc; i++ ) {
+      if ( 0 == strcmp( argv[i], "--video" ) && i + 1 < argc ) {
+        video = argv[++i];
+      } else if ( 0 == strcmp( argv[i], "--compress" ) ) {
+        compress = true;
+      }
+    }
+    return _bundle( argv[2], argv[3], video, argv[4], compress );
+  }
+  if ( argc >= 4 && 0 == strcmp( argv[1], "bench" ) ) {
+    int repeats = 1;
+    for ( int i = 4; i < argc; i++ ) {
+      if ( 0 == strcmp( argv[i], "--threads" ) ) {
+#ifndef _WIN32
+        vol_geom_set_parallel_for_callback( _thread_parallel_for );
+#endif
+      } else {
+        repeats = atoi( argv[i] ) > 0 ? atoi( argv[i] ) : 1;
+      }
+    }
+    return _bench( argv[2], argv[3], repeats );
+  }
+  if ( argc >= 6 && 0 == strcmp( argv[1], "compare" ) ) {
+    bool streaming = argc >= 7 && 0 == strcmp( argv[6], "--streaming" );
+    return _compare( argv[2], argv[3], argv[4], argv[5], streaming );
+  }
+#ifndef _WIN32
+  if ( argc >= 4 && 0 == strcmp( argv[1], "chunks" ) ) { return _compare_chunks( argv[2], argv[3] ); }
+#endif
+  fprintf( stderr, "Usage:\n"
+                   "  %s pack  IN_HEADER.vols IN_SEQUENCE.vols OUT_HEADER.vols OUT_SEQUENCE.vols [--delta STEP] [--quantize]\n"
+                   "  %s bundle IN_HEADER.vols IN_SEQUENCE.vols OUT_BUNDLE.volb [--video VIDEO.mp4] [--compress]\n"
+                   "  %s bench HEADER.vols SEQUENCE.vols [REPEATS] [--threads]\n"
+                   "  %s compare HEADER.vols SEQUENCE.vols OTHER_HEADER.vols OTHER_SEQUENCE.vols [--streaming]\n"
+                   "  %s chunks BUNDLE.volb OTHER_BUNDLE.volb\n",
+    argv[0], argv[0], argv[0], argv[0], argv[0] );
+  return 1;
+}
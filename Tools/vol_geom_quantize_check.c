@@ -0,0 +1,126 @@
+/** @file vol_geom_quantize_check.c
+ * Volograms UNORM16 Error Bound Check
+ *
+ * Version:   0.1 \n
+ * Copyright: 2026, Volograms (http://volograms.com/) \n
+ * Language:  C11 \n
+ * Licence:   The MIT License. See LICENSE.md for details. \n
+ *
+ * Command-line tool that encodes float arrays with VOL_GEOM_STREAM_CODEC_UNORM16, decodes them with the player's kernels, and checks that every
+ * component is within the bound documented in vol_geom.h: ( max - min ) / 131070 + max( |min|, |max| ) / 2^21. Ranges include capture volumes
+ * centred on the origin, ranges far from the origin where float rounding is largest, and tiny ranges. Values include random ones, the ends of
+ * the range, and values next to half steps, where the nearest step is hardest to pick.
+ *
+ * Build (from this directory):
+ *   cc -std=gnu11 -O2 -I../Source/volograms/Private vol_geom_quantize_check.c ../Source/volograms/Private/vol_geom.c -o vol_geom_quantize_check \
+ *     -lpthread -lm
+ *
+ * Usage:
+ *   vol_geom_quantize_check [VERTICES]
+ */
+
+#include "vol_geom.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Minimum then maximum of a channel. */
+static const float _ranges[][2] = {
+  { -2.0f, 2.0f },       // A 4 m capture volume.
+  { 0.0f, 1.8f },        // A height, from the floor.
+  { -0.3f, 0.7f },       // Off-centre.
+  { 100.0f, 104.0f },    // Far from the origin, so the rounding term is larger than half a step.
+  { -1000.0f, -999.0f },
+  { 1.0f, 1.0001f },     // Tiny, so a step is a few ulps.
+  { -1e-6f, 1e-6f },
+  { -3.0e4f, 5.0e4f },   // Centimetres over a large stage.
+};
+#define N_RANGES ( sizeof( _ranges ) / sizeof( _ranges[0] ) )
+
+static uint32_t _rng_state = 0x12345678u;
+
+/** xorshift32, so runs are repeatable. */
+static uint32_t _rand_u32( void ) {
+  _rng_state ^= _rng_state << 13;
+  _rng_state ^= _rng_state >> 17;
+  _rng_state ^= _rng_state << 5;
+  return _rng_state;
+}
+
+/** A value within min to max: an end of the range, one next to a half step, or a random one. */
+static float _pick_value( float min, float max ) {
+  double extent = (double)max - min;
+  switch ( _rand_u32() % 4 ) {
+  case 0: return ( _rand_u32() & 1 ) ? min : max;
+  case 1: {
+    double half_step = min + ( ( _rand_u32() % 65535 ) + 0.5 ) * extent / 65535.0;
+    float v          = (float)half_step;
+    if ( _rand_u32() & 1 ) { v = nextafterf( v, ( _rand_u32() & 1 ) ? max : min ); }
+    return fminf( fmaxf( v, min ), max );
+  }
+  default: return fminf( fmaxf( (float)( min + extent * ( _rand_u32() / 4294967295.0 ) ), min ), max );
+  }
+}
+
+static int _check( int n_vertices ) {
+  int n_failed = 0;
+  for ( int channels = 1; channels <= 4; channels++ ) {
+    int n_floats               = n_vertices * channels;
+    vol_geom_size_t sz         = (vol_geom_size_t)n_floats * (vol_geom_size_t)sizeof( float );
+    vol_geom_size_t dst_max_sz = vol_geom_encode_stream_bound( sz, 2 ) + 64;
+    float* src_ptr             = malloc( (size_t)sz );
+    float* decoded_ptr         = malloc( (size_t)sz );
+    uint8_t* dst_ptr           = malloc( (size_t)dst_max_sz );
+    if ( !src_ptr || !decoded_ptr || !dst_ptr ) {
+      fprintf( stderr, "ERROR: out of memory\n" );
+      free( src_ptr );
+      free( decoded_ptr );
+      free( dst_ptr );
+      return 1;
+    }
+    // Each range in each channel position, so every SIMD lane and the scalar tail see every range.
+    for ( size_t r = 0; r < N_RANGES; r++ ) {
+      float bounds[8];
+      for ( int c = 0; c < channels; c++ ) {
+        bounds[c]            = _ranges[( r + c ) % N_RANGES][0];
+        bounds[channels + c] = _ranges[( r + c ) % N_RANGES][1];
+      }
+      for ( int i = 0; i < n_floats; i++ ) { src_ptr[i] = _pick_value( bounds[i % channels], bounds[channels + i % channels] ); }
+      float max_error = 0.0f;
+      vol_geom_size_t stream_sz =
+        vol_geom_encode_quantized_stream( VOL_GEOM_STREAM_CODEC_UNORM16, src_ptr, sz, channels, bounds, decoded_ptr, dst_ptr, dst_max_sz, &max_error );
+      if ( stream_sz < 0 ) {
+        fprintf( stderr, "ERROR: could not encode %i channels over range %i\n", channels, (int)r );
+        n_failed++;
+        continue;
+      }
+      double worst = 0.0;
+      for ( int i = 0; i < n_floats; i++ ) {
+        float min = bounds[i % channels], max = bounds[channels + i % channels];
+        double bound = ( (double)max - min ) / 131070.0 + fmax( fabs( min ), fabs( max ) ) / 2097152.0;
+        double error = fabs( (double)decoded_ptr[i] - src_ptr[i] );
+        if ( error / bound > worst ) { worst = error / bound; }
+        if ( error > bound ) {
+          fprintf( stderr, "ERROR: %i channels, range %g to %g: %.9g decoded as %.9g, error %g over the bound %g\n", channels, min, max, src_ptr[i],
+            decoded_ptr[i], error, bound );
+          n_failed++;
+          break;
+        }
+      }
+      printf( "%i channels, range %i: largest error %.3f of the bound\n", channels, (int)r, worst );
+    }
+    free( src_ptr );
+    free( decoded_ptr );
+    free( dst_ptr );
+  }
+  if ( 0 == n_failed ) { printf( "all UNORM16 errors are within the bound\n" ); }
+  return n_failed > 0 ? 1 : 0;
+}
+
+int main( int argc, char** argv ) {
+  if ( argc > 2 || ( 2 == argc && atoi( argv[1] ) <= 0 ) ) {
+    fprintf( stderr, "Usage:\n  %s [VERTICES]\n", argv[0] );
+    return 1;
+  }
+  return _check( 2 == argc ? atoi( argv[1] ) : 100003 );
+}